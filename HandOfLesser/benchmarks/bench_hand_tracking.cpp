@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+#include "benchmark_hands.h"
+#include "src/openxr/HandTracking.h"
+#include "src/steamvr/steamvr_input.h"
+#include "src/vrchat/vrchat_input.h"
+
+using namespace HOL;
+
+// Curls and splays for one hand, out of joints that have already been located
+static void BM_CalculateCurlSplay(benchmark::State& state)
+{
+	// One hand per recorded frame, so every iteration starts from different joints
+	const std::vector<HandRecord>& records = getBenchmarkRecords();
+	BenchmarkHandSource source;
+	std::vector<OpenXRHand> hands(records.size());
+	for (OpenXRHand& hand : hands)
+	{
+		hand.init(HandSide::LeftHand);
+		hand.updateJointLocations(source, source.getTime());
+	}
+
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		hands[i].calculateCurlSplay();
+		benchmark::DoNotOptimize(hands[i].handPose.fingers);
+		i = (i + 1) % hands.size();
+	}
+}
+BENCHMARK(BM_CalculateCurlSplay);
+
+// The whole tracking stage, both hands
+static void BM_UpdateHands(benchmark::State& state)
+{
+	getBenchmarkFrames(); // Sets up the input globals
+
+	auto tracking = std::make_unique<OpenXR::HandTracking>();
+	tracking->init();
+	BenchmarkHandSource source;
+
+	for (auto _ : state)
+	{
+		tracking->updateHands(source, source.getTime());
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_UpdateHands);
+
+// Every gesture and action, both hands. Includes emptying the input globals
+// like the gesture stage does, or they'd grow forever.
+static void BM_UpdateGestures(benchmark::State& state)
+{
+	std::vector<HandFrame> frames = getBenchmarkFrames();
+
+	auto tracking = std::make_unique<OpenXR::HandTracking>();
+	tracking->init();
+
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		tracking->updateGestures(frames[i]);
+		SteamVR::SteamVRInput::Current->clear();
+		benchmark::DoNotOptimize(VRChat::VRChatInput::Current->finalizeInputBundle());
+		i = (i + 1) % frames.size();
+	}
+}
+BENCHMARK(BM_UpdateGestures);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "benchmark_hands.h"
+#include "src/core/settings_global.h"
+#include "src/vrchat/vrchat_osc.h"
+
+using namespace HOL;
+using namespace HOL::VRChat;
+
+static void BM_GenerateOscOutput(benchmark::State& state)
+{
+	std::vector<HandFrame> frames = getBenchmarkFrames();
+	auto osc = std::make_unique<VRChatOSC>();
+
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		osc->generateOscOutput(frames[i].hands[HandSide::LeftHand].handPose,
+							   frames[i].hands[HandSide::RightHand].handPose);
+		benchmark::ClobberMemory();
+		i = (i + 1) % frames.size();
+	}
+}
+BENCHMARK(BM_GenerateOscOutput);
+
+// Bundles with change detection off, so every parameter goes in every time. Worst case.
+template <size_t (VRChatOSC::*Generate)(int64_t)>
+static void BM_GenerateOscBundle(benchmark::State& state)
+{
+	std::vector<HandFrame> frames = getBenchmarkFrames();
+	auto osc = std::make_unique<VRChatOSC>();
+	osc->generateOscOutput(frames[0].hands[HandSide::LeftHand].handPose,
+						   frames[0].hands[HandSide::RightHand].handPose);
+
+	bool changeDetection = Config.transmit.changeDetection;
+	Config.transmit.changeDetection = false;
+
+	int64_t now = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(((*osc).*Generate)(now++));
+	}
+
+	Config.transmit.changeDetection = changeDetection;
+}
+BENCHMARK_TEMPLATE(BM_GenerateOscBundle, &VRChatOSC::generateOscBundleFull)
+	->Name("BM_GenerateOscBundleFull");
+BENCHMARK_TEMPLATE(BM_GenerateOscBundle, &VRChatOSC::generateOscBundleAlternating)
+	->Name("BM_GenerateOscBundleAlternating");
+BENCHMARK_TEMPLATE(BM_GenerateOscBundle, &VRChatOSC::generateOscBundlePacked)
+	->Name("BM_GenerateOscBundlePacked");
+
+static void BM_EncodePacked(benchmark::State& state)
+{
+	auto osc = std::make_unique<VRChatOSC>();
+
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> value(-1.f, 1.f);
+	std::vector<float> values(256);
+	for (float& v : values)
+	{
+		v = value(random);
+	}
+
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(osc->encodePacked(values[i], values[(i + 1) % values.size()]));
+		i = (i + 1) % values.size();
+	}
+}
+BENCHMARK(BM_EncodePacked);
+
+// What the OSC stage does per frame with the default settings
+static void BM_OscStage(benchmark::State& state)
+{
+	std::vector<HandFrame> frames = getBenchmarkFrames();
+	auto osc = std::make_unique<VRChatOSC>();
+
+	// Frames loop, time shouldn't or the keep-alive never expires
+	size_t i = 0;
+	int64_t now = 0;
+	for (auto _ : state)
+	{
+		HandFrame& frame = frames[i];
+		osc->generateOscOutput(frame.hands[HandSide::LeftHand].handPose,
+							   frame.hands[HandSide::RightHand].handPose);
+		benchmark::DoNotOptimize(osc->generateOscBundleFull(now));
+		benchmark::DoNotOptimize(osc->generateOscBundleAlternating(now));
+		benchmark::DoNotOptimize(osc->generateOscBundlePacked(now));
+		i = (i + 1) % frames.size();
+		now += 11111111; // 90hz
+	}
+}
+BENCHMARK(BM_OscStage);
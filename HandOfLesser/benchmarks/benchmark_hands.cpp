@@ -0,0 +1,108 @@
+#include "benchmark_hands.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include "src/core/settings_global.h"
+#include "src/core/synthetic_hand_source.h"
+#include "src/openxr/HandTracking.h"
+#include "src/steamvr/steamvr_input.h"
+#include "src/vrchat/vrchat_input.h"
+
+using namespace HOL;
+
+// 4 seconds at 90hz, long enough for every finger to open and close twice
+static const int BENCHMARK_SYNTHETIC_FRAMES = 360;
+static const XrTime BENCHMARK_SYNTHETIC_PERIOD = 11111111;
+
+static std::vector<HandRecord> loadBenchmarkRecords()
+{
+	std::vector<HandRecord> records;
+
+	const char* path = getenv("HOL_BENCHMARK_RECORDING");
+	if (path != nullptr)
+	{
+		ReplayHandSource replay;
+		replay.setSpeed(0);
+
+		if (replay.open(path))
+		{
+			while (replay.isRunning())
+			{
+				HandRecord record;
+				record.time = replay.getTime();
+				replay.locateHand(HandSide::LeftHand, record.time, record.hands[0]);
+				replay.locateHand(HandSide::RightHand, record.time, record.hands[1]);
+				records.push_back(record);
+			}
+		}
+
+		if (!records.empty())
+		{
+			return records;
+		}
+
+		std::cerr << "Nothing in " << path << ", using synthetic hands" << std::endl;
+	}
+
+	SyntheticHandSource synthetic;
+	for (int i = 0; i < BENCHMARK_SYNTHETIC_FRAMES; i++)
+	{
+		HandRecord record;
+		record.time = 1000000000 + i * BENCHMARK_SYNTHETIC_PERIOD;
+		synthetic.locateHand(HandSide::LeftHand, record.time, record.hands[0]);
+		synthetic.locateHand(HandSide::RightHand, record.time, record.hands[1]);
+		records.push_back(record);
+	}
+
+	return records;
+}
+
+const std::vector<HandRecord>& HOL::getBenchmarkRecords()
+{
+	static std::vector<HandRecord> records = loadBenchmarkRecords();
+	return records;
+}
+
+static std::vector<HandFrame> loadBenchmarkFrames()
+{
+	HOL::settings::restoreDefaultControllerOffset(HOL::ControllerOffsetPreset::RoughyVRChatHand);
+
+	// Actions submit to these globals, they have to exist before the gestures run
+	static SteamVR::SteamVRInput steamVRInput;
+	static VRChat::VRChatInput vrchatInput;
+
+	auto tracking = std::make_unique<OpenXR::HandTracking>();
+	tracking->init();
+
+	BenchmarkHandSource source;
+	std::vector<HandFrame> frames(getBenchmarkRecords().size());
+	for (size_t i = 0; i < frames.size(); i++)
+	{
+		XrTime time = source.getTime();
+		tracking->updateHands(source, time);
+		tracking->getFrame(frames[i]);
+		frames[i].sequence = i + 1;
+		frames[i].time = time;
+	}
+
+	return frames;
+}
+
+const std::vector<HandFrame>& HOL::getBenchmarkFrames()
+{
+	static std::vector<HandFrame> frames = loadBenchmarkFrames();
+	return frames;
+}
+
+XrTime BenchmarkHandSource::getTime()
+{
+	const std::vector<HandRecord>& records = getBenchmarkRecords();
+	this->mRecord = &records[this->mNextRecord];
+	this->mNextRecord = (this->mNextRecord + 1) % records.size();
+	return this->mRecord->time;
+}
+
+void BenchmarkHandSource::locateHand(HOL::HandSide side, XrTime time, HandJointSample& sample)
+{
+	sample = this->mRecord->hands[side];
+}
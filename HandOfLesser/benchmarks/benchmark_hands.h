@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+#include "src/core/hand_recording.h"
+#include "src/hands/hand_frame.h"
+
+namespace HOL
+{
+	// What the benchmarks run on. HOL_BENCHMARK_RECORDING can point at a recording,
+	// otherwise it's a few seconds of SyntheticHandSource, which is the same everywhere.
+	const std::vector<HandRecord>& getBenchmarkRecords();
+
+	// Frames as the tracking stage would publish them, for the gesture and OSC benchmarks
+	const std::vector<HandFrame>& getBenchmarkFrames();
+
+	// Plays getBenchmarkRecords() round and round, one record per getTime()
+	class BenchmarkHandSource : public HandSource
+	{
+	public:
+		XrTime getTime() override;
+		void locateHand(HOL::HandSide side, XrTime time, HandJointSample& sample) override;
+
+	private:
+		size_t mNextRecord = 0;
+		const HandRecord* mRecord = nullptr;
+	};
+} // namespace HOL
@@ -0,0 +1,308 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <HandOfLesserCommon.h>
+#include "core/hand_pipeline.h"
+#include "core/hand_recording.h"
+#include "core/packet_sink.h"
+#include "core/settings_global.h"
+#include "core/synthetic_hand_source.h"
+
+// Runs the same pipeline as the app, minus OpenXR and the UI, so it can be profiled anywhere.
+//
+//   HandOfLesserHeadless [--rate <hz>] [--seconds <s>] [--sink null|udp]
+//                        [--record <file>] [--replay <file>] [--speed <x>] [--capture <file>]
+//                        [--trace <file>] [--metrics <file>] [--filter]
+//
+// A rate of 0 runs as fast as it goes. The udp sink sends to the driver and VRChat
+// on their usual ports, so it can still drive a real SteamVR from a synthetic hand.
+//
+// --record writes down the hands as they come in. --replay plays a recording back instead
+// of the synthetic hands, at its own pace times --speed (0 for no waiting), until it runs out
+// unless --seconds says otherwise. Replays run the pipeline deterministically, and --capture
+// writes what would've been sent to <file>.driver and <file>.osc, so two replays of the
+// same recording can be compared byte for byte.
+//
+// --trace writes a Chrome trace of the whole run, for builds with HOL_ENABLE_TRACING.
+// --metrics writes the latency histograms and counters once it's done, same as the UI's Save.
+// --filter turns on joint and palm smoothing with the default FilterSettings.
+
+struct HeadlessOptions
+{
+	float rateHz = 90.f;
+	float seconds = 10.f;
+	bool secondsSet = false;
+	std::string sink = "null";
+	std::string record;
+	std::string replay;
+	float speed = 1.f;
+	std::string capture;
+	std::string trace;
+	std::string metrics;
+	bool filter = false;
+};
+
+static bool parseOptions(int argc, char* argv[], HeadlessOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		bool hasValue = i + 1 < argc;
+
+		if (strcmp(argv[i], "--rate") == 0 && hasValue)
+		{
+			options.rateHz = (float)atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--seconds") == 0 && hasValue)
+		{
+			options.seconds = (float)atof(argv[++i]);
+			options.secondsSet = true;
+		}
+		else if (strcmp(argv[i], "--sink") == 0 && hasValue)
+		{
+			options.sink = argv[++i];
+		}
+		else if (strcmp(argv[i], "--record") == 0 && hasValue)
+		{
+			options.record = argv[++i];
+		}
+		else if (strcmp(argv[i], "--replay") == 0 && hasValue)
+		{
+			options.replay = argv[++i];
+		}
+		else if (strcmp(argv[i], "--speed") == 0 && hasValue)
+		{
+			options.speed = (float)atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--capture") == 0 && hasValue)
+		{
+			options.capture = argv[++i];
+		}
+		else if (strcmp(argv[i], "--trace") == 0 && hasValue)
+		{
+			options.trace = argv[++i];
+		}
+		else if (strcmp(argv[i], "--metrics") == 0 && hasValue)
+		{
+			options.metrics = argv[++i];
+		}
+		else if (strcmp(argv[i], "--filter") == 0)
+		{
+			options.filter = true;
+		}
+		else
+		{
+			std::cerr << "Unknown argument: " << argv[i] << std::endl;
+			return false;
+		}
+	}
+
+	// Capture is a sink of its own
+	if (!options.capture.empty() && options.sink != "null")
+	{
+		std::cerr << "--capture can't be used with --sink " << options.sink << std::endl;
+		return false;
+	}
+
+	return options.sink == "null" || options.sink == "udp";
+}
+
+static void printStatistics(HOL::PipelineStageStatistics statistics[HOL::PipelineStageType_MAX])
+{
+	printf("%-10s %10s %8s %10s %10s %12s %12s\n",
+		   "stage",
+		   "frames",
+		   "skipped",
+		   "work us",
+		   "work max",
+		   "latency us",
+		   "latency max");
+
+	for (int i = 0; i < HOL::PipelineStageType_MAX; i++)
+	{
+		HOL::PipelineStageStatistics& stage = statistics[i];
+		printf("%-10s %10llu %8llu %10.2f %10.2f %12.2f %12.2f\n",
+			   HOL::getPipelineStageName((HOL::PipelineStageType)i),
+			   (unsigned long long)stage.frames,
+			   (unsigned long long)stage.skipped,
+			   stage.workMeanUS,
+			   stage.workMaxUS,
+			   stage.latencyMeanUS,
+			   stage.latencyMaxUS);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	HeadlessOptions options;
+	if (!parseOptions(argc, argv, options))
+	{
+		std::cerr << "Usage: HandOfLesserHeadless [--rate <hz>] [--seconds <s>] [--sink null|udp]\n"
+				  << "                            [--record <file>] [--replay <file>] [--speed <x>]"
+				  << " [--capture <file>]\n"
+				  << "                            [--trace <file>] [--metrics <file>] [--filter]"
+				  << std::endl;
+		return 1;
+	}
+
+	HOL::settings::restoreDefaultControllerOffset(HOL::ControllerOffsetPreset::RoughyVRChatHand);
+	HOL::Config.filter.enabled = options.filter;
+
+	HOL::NativeTransport transport;
+	HOL::TransportSink driverTransportSink;
+	HOL::TransportSink oscTransportSink;
+	HOL::CaptureSink driverNullSink;
+	HOL::CaptureSink oscNullSink;
+	HOL::PacketSink* driverSink = &driverNullSink;
+	HOL::PacketSink* oscSink = &oscNullSink;
+
+	// Without a file these are just NullSinks
+	if (!options.capture.empty())
+	{
+		if (!driverNullSink.open(options.capture + ".driver")
+			|| !oscNullSink.open(options.capture + ".osc"))
+		{
+			return 1;
+		}
+	}
+
+	if (options.sink == "udp")
+	{
+		transport.init(9005);
+		driverTransportSink.init(&transport, 9006);
+		oscTransportSink.init(&transport, 9000);
+		driverSink = &driverTransportSink;
+		oscSink = &oscTransportSink;
+	}
+
+	HOL::SyntheticHandSource synthetic;
+	HOL::ReplayHandSource replay;
+	HOL::HandSource* source = &synthetic;
+
+	if (!options.replay.empty())
+	{
+		if (!replay.open(options.replay))
+		{
+			return 1;
+		}
+
+		// Replay keeps its own pace, and plays to the end unless told otherwise
+		replay.setSpeed(options.speed);
+		source = &replay;
+		options.rateHz = 0;
+		if (!options.secondsSet)
+		{
+			options.seconds = 1e9f;
+		}
+	}
+
+	HOL::HandRecorder recorder;
+	recorder.init(source);
+	if (!options.record.empty())
+	{
+		if (!recorder.start(options.record))
+		{
+			return 1;
+		}
+		source = &recorder;
+	}
+
+	if (!options.trace.empty())
+	{
+#ifndef HOL_TRACING
+		std::cerr << "Built without HOL_ENABLE_TRACING, the trace will be empty" << std::endl;
+#endif
+		HOL_TRACE_THREAD("Main loop");
+		HOL::Tracer::setEnabled(true);
+	}
+
+	// Pipeline starts a few threads and holds a lot of buffers, keep it off the stack
+	auto pipeline = std::make_unique<HOL::HandPipeline>();
+	pipeline->init(driverSink, oscSink);
+	pipeline->setDeterministic(!options.replay.empty());
+	pipeline->start();
+
+	HOL::FrameScheduler scheduler;
+	if (options.rateHz > 0)
+	{
+		scheduler.setPeriod((int64_t)(1000000000.0 / options.rateHz));
+	}
+
+	int64_t start = HOL::steadyNanoseconds();
+	int64_t end = start + (int64_t)(options.seconds * 1000000000.0);
+
+	while (HOL::steadyNanoseconds() < end && source->isRunning())
+	{
+		if (options.rateHz > 0)
+		{
+			scheduler.waitForNextFrame();
+		}
+
+		pipeline->runFrame(*source, source->getTime());
+	}
+
+	pipeline->stop();
+
+	if (!options.trace.empty())
+	{
+		HOL::Tracer::setEnabled(false);
+		std::vector<HOL::TraceEvent> events = HOL::Tracer::collect();
+		if (!HOL::writeChromeTrace(options.trace,
+								   HOL::TRACE_PROCESS_APP,
+								   "HandOfLesserHeadless",
+								   events,
+								   HOL::Tracer::getThreads()))
+		{
+			return 1;
+		}
+		printf("traced %llu events to %s\n\n",
+			   (unsigned long long)events.size(),
+			   options.trace.c_str());
+	}
+
+	if (!options.metrics.empty())
+	{
+		HOL::MetricsSnapshot snapshot;
+		HOL::getMetrics().snapshot(snapshot);
+
+		std::string text;
+		HOL::formatMetrics("HandOfLesserHeadless", snapshot, text);
+		if (!HOL::writeMetrics(options.metrics, text))
+		{
+			return 1;
+		}
+		printf("%s", text.c_str());
+		printf("wrote metrics to %s\n\n", options.metrics.c_str());
+	}
+
+	if (recorder.isRecording())
+	{
+		printf("recorded %llu frames to %s\n\n",
+			   (unsigned long long)recorder.getRecordCount(),
+			   options.record.c_str());
+		recorder.stop();
+	}
+
+	HOL::PipelineStageStatistics statistics[HOL::PipelineStageType_MAX];
+	pipeline->getStatistics(statistics);
+	printStatistics(statistics);
+
+	if (options.sink == "null")
+	{
+		printf("\ndriver: %llu packets, %llu bytes\n",
+			   (unsigned long long)driverNullSink.getPackets(),
+			   (unsigned long long)driverNullSink.getBytes());
+		printf("osc:    %llu packets, %llu bytes\n",
+			   (unsigned long long)oscNullSink.getPackets(),
+			   (unsigned long long)oscNullSink.getBytes());
+	}
+	else
+	{
+		transport.cancel();
+	}
+
+	return 0;
+}
@@ -1,14 +1,27 @@
 #include "HandOfLesserCore.h"
+#include <algorithm>
+#include <filesystem>
+#include <format>
 #include <thread>
 #include "src/oculus/oculus_hacks.h"
 #include "src/openxr/XrUtils.h"
 #include "src/core/settings_global.h"
 #include "src/core/ui/display_global.h"
-#include "src/vrchat/vrchat_osc.h"
+#include "src/steamvr/steamvr_input.h"
+#include "src/util/hol_utils.h"
 
 using namespace HOL;
 using namespace HOL::OpenXR;
 
+// Driver sends timing every 100ms, a few missed is fine
+static const int64_t FRAME_TIMING_TIMEOUT_NS = 1000000000;
+
+// Poses that get to the driver closer to its frame than this will probably miss it
+static const int64_t FRAME_PACING_TRANSPORT_MARGIN_NS = 500000;
+
+// Driver writes its trace as soon as it's asked, this is only if it isn't running
+static const int64_t TRACE_DRIVER_TIMEOUT_NS = 2000000000;
+
 HandOfLesserCore* HandOfLesserCore::Current = nullptr;
 
 void HandOfLesserCore::init(int serverPort)
@@ -41,8 +54,8 @@ void HandOfLesserCore::init(int serverPort)
 		// can test UI and stuff
 		if (this->mInstanceHolder.getState() == OpenXrState::Running)
 		{
-			this->mHandTracking.init(this->mInstanceHolder.mInstance,
-									 this->mInstanceHolder.mSession);
+			this->mHandSource.init(&this->mInstanceHolder);
+			this->mRecorder.init(&this->mHandSource);
 
 			// Airlink doesn't support headless and requires hax
 			// As of writing, the only other supported runtime is VDXR
@@ -53,11 +66,16 @@ void HandOfLesserCore::init(int serverPort)
 		}
 	}
 	this->mTransport.init(serverPort);
+	this->mDriverSink.init(&this->mTransport, 9006);
+	this->mOscSink.init(&this->mTransport, 9000);
+	this->mPipeline.init(&this->mDriverSink, &this->mOscSink);
 }
 
 void HandOfLesserCore::start()
 {
 	this->mUserInterfaceThread = std::thread(&HandOfLesserCore::userInterfaceLoop, this);
+	this->mReceiveThread = std::thread(&HandOfLesserCore::receiveLoop, this);
+	this->mPipeline.start();
 	this->mainLoop();
 }
 
@@ -68,14 +86,12 @@ std::vector<const char*> HandOfLesserCore::getRequiredExtensions()
 
 void HOL::HandOfLesserCore::userInterfaceLoop()
 {
+	HOL_TRACE_THREAD("UI");
 	this->mUserInterface.init();
 
 	while (1)
 	{
-		if (this->mInstanceHolder.getState() == OpenXrState::Running)
-		{
-			this->mHandTracking.drawHands();
-		}
+		this->updateDisplay();
 		this->mUserInterface.onFrame();
 		if (this->mUserInterface.shouldTerminate())
 		{
@@ -89,11 +105,88 @@ void HOL::HandOfLesserCore::userInterfaceLoop()
 	this->mUserInterface.terminate();
 }
 
+// Runs at whatever rate the UI does, never holds up anyone publishing
+void HOL::HandOfLesserCore::updateDisplay()
+{
+	HOL::MainLoopDisplay mainLoop;
+	if (this->mMainLoopDisplayMailbox.consume(mainLoop))
+	{
+		HOL::display::MainLoopStatistics = mainLoop.statistics;
+		HOL::display::FramePacing = mainLoop.framePacing;
+		HOL::display::Recording = mainLoop.recording;
+		HOL::display::Tracing = mainLoop.tracing;
+		std::copy(std::begin(mainLoop.pipeline),
+				  std::end(mainLoop.pipeline),
+				  std::begin(HOL::display::PipelineStatistics));
+	}
+
+	HOL::PacketStatisticsPacket driverStatistics;
+	if (this->mDriverStatisticsMailbox.consume(driverStatistics))
+	{
+		HOL::display::DriverPacketStatistics = driverStatistics;
+	}
+
+	// Big enough that we'd rather not keep a second copy around
+	this->mDriverMetricsMailbox.consume(HOL::display::DriverMetrics);
+
+	HOL::VRChat::OscOutputDisplay osc;
+	if (this->mPipeline.consumeOscDisplay(osc))
+	{
+		for (int side = 0; side < HandSide_MAX; side++)
+		{
+			std::copy(std::begin(osc.humanoidBend[side]),
+					  std::end(osc.humanoidBend[side]),
+					  std::begin(HOL::display::FingerTracking[side].humanoidBend));
+			std::copy(std::begin(osc.packedBend[side]),
+					  std::end(osc.packedBend[side]),
+					  std::begin(HOL::display::FingerTracking[side].packedBend));
+		}
+	}
+
+	this->mPipeline.getFrames().read(this->mDisplayFrame, this->mDisplayFrameSequence);
+
+	// Nothing to show until tracking has run at least once
+	if (this->mDisplayFrameSequence == 0)
+	{
+		return;
+	}
+
+	for (int side = 0; side < HandSide_MAX; side++)
+	{
+		HOL::HandFrameHand& hand = this->mDisplayFrame.hands[side];
+		HOL::HandTransformDisplay& transform = HOL::display::HandTransform[side];
+
+		transform.active = hand.handPose.active;
+		transform.positionValid = hand.handPose.poseValid;
+		transform.positionTracked = hand.handPose.poseTracked;
+		transform.rawPose = hand.rawPalmLocation;
+		transform.finalPose = hand.handPose.palmLocation;
+		transform.finalTranslationOffset = hand.controllerTranslationOffset;
+		transform.finalOrientationOffset = hand.controllerOrientationOffset;
+
+		std::copy(std::begin(hand.handPose.fingers),
+				  std::end(hand.handPose.fingers),
+				  std::begin(HOL::display::FingerTracking[side].rawBend));
+	}
+
+	this->mUserInterface.Current->getVisualizer()->drawHands(this->mDisplayFrame);
+}
+
 void HandOfLesserCore::mainLoop()
 {
+	// Sticks to the thread, no need to do it every frame
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+	HOL_TRACE_THREAD("Main loop");
+
 	while (1)
 	{
-		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+		this->updateFramePacing();
+		this->configureFrameScheduler();
+		this->mFrameScheduler.waitForNextFrame();
+
+		HOL_TRACE_SCOPE("HandOfLesserCore::mainLoop");
+		int64_t iterationStart = HOL::steadyNanoseconds();
+
 		this->mUserInterface.Current->getVisualizer()->clearDrawQueue();
 
 		if (this->mUserInterface.shouldTerminate())
@@ -103,115 +196,357 @@ void HandOfLesserCore::mainLoop()
 
 		if (this->mInstanceHolder.getState() == OpenXrState::Running)
 		{
+			this->updateRecording();
 			doOpenXRStuff();
 		}
 
+		// Driver falls back to UDP by itself if we stop calling this
+		this->mTransport.updateSharedMemory(Config.general.useSharedMemory, 9006);
+		this->requestInputIds();
+		this->negotiatePoseEncoding();
+
 		// draw queue swapping because UI and main loop are not in sync
 		this->mUserInterface.Current->getVisualizer()->swapOuterDrawQueue();
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(Config.general.UpdateIntervalMS));
+		this->updateTracing();
+		this->updatePipelineStatistics();
+
+		this->mMainLoopTime->record(HOL::steadyNanoseconds() - iterationStart);
 	}
 
 	std::cout << "Exiting loop" << std::endl;
+	this->mPipeline.stop();
+	this->mRecorder.stop();
 	this->mUserInterfaceThread.join();
+	this->mTransport.cancel();
+	this->mReceiveThread.join();
 }
 
-void HandOfLesserCore::doOpenXRStuff()
+// Driver only sends us its input id table, statistics and metrics
+void HOL::HandOfLesserCore::receiveLoop()
 {
-	XrTime time = this->mInstanceHolder.getTime();
-	time += 1000000LL * (XrTime)Config.general.MotionPredictionMS;
+	HOL_TRACE_THREAD("Receive");
 
-	this->mInstanceHolder.pollEvent();
+	while (!this->mUserInterface.shouldTerminate())
+	{
+		for (HOL::ReceivedPacket& received : this->mTransport.receiveBatch())
+		{
+			HOL::NativePacketTable::dispatch(received, [this](auto packet) {
+				using View = decltype(packet);
+
+				if constexpr (std::is_same_v<View, HOL::PacketView<HOL::InputIdTablePacket>>)
+				{
+					SteamVR::SteamVRInput::Current->updateInputIds(packet.get());
+				}
+				else if constexpr (std::is_same_v<View,
+												  HOL::PacketView<HOL::PacketStatisticsPacket>>)
+				{
+					this->mDriverStatisticsMailbox.publish(*packet);
+				}
+				else if constexpr (std::is_same_v<View, HOL::PacketView<HOL::PoseAckPacket>>)
+				{
+					this->mPipeline.acknowledgePoses((HOL::HandSide)packet->side,
+													 packet->acknowledged);
+				}
+				else if constexpr (std::is_same_v<View, HOL::PacketView<HOL::PoseEncodingPacket>>)
+				{
+					this->mPipeline.setPoseEncoding(packet->encoding);
+				}
+				else if constexpr (std::is_same_v<View, HOL::PacketView<HOL::FrameTimingPacket>>)
+				{
+					this->mFrameTimingMailbox.publish(*packet);
+				}
+				else if constexpr (std::is_same_v<View, HOL::PacketView<HOL::MetricsPacket>>)
+				{
+					this->mDriverMetricsMailbox.publish(packet->snapshot);
+				}
+			});
+		}
+	}
+}
+
+// Driver replies with what it has seen so far, shows up in the UI when it arrives
+void HOL::HandOfLesserCore::requestPacketStatistics(bool reset)
+{
+	HOL::PacketStatisticsRequestPacket packet;
+	packet.reset = reset;
+	this->mTransport.sendPacket(9006, &packet, sizeof(HOL::PacketStatisticsRequestPacket));
+}
+
+// Same as above, but for the driver's MetricsRegistry
+void HOL::HandOfLesserCore::requestMetrics(bool reset)
+{
+	HOL::MetricsRequestPacket packet;
+	packet.reset = reset;
+	this->mTransport.sendPacket(9006, &packet, sizeof(HOL::MetricsRequestPacket));
+}
+
+void HOL::HandOfLesserCore::resetMainLoopStatistics()
+{
+	// Main loop picks this up, the scheduler isn't thread safe
+	this->mResetMainLoopStatistics = true;
+}
+
+void HOL::HandOfLesserCore::setRecording(bool recording)
+{
+	// Main loop picks this up, it owns the recorder
+	this->mRecordingRequested = recording;
+}
+
+void HOL::HandOfLesserCore::updateRecording()
+{
+	bool requested = this->mRecordingRequested;
+
+	if (requested && !this->mRecorder.isRecording())
+	{
+		// In the working directory, named after when it started
+		std::string path = std::format(
+			"hands_{:%Y%m%d_%H%M%S}.holr",
+			std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+
+		if (this->mRecorder.start(path))
+		{
+			std::cout << "Recording hands to " << path << std::endl;
+		}
+		else
+		{
+			this->mRecordingRequested = false;
+		}
+	}
+	else if (!requested && this->mRecorder.isRecording())
+	{
+		std::cout << "Recorded " << this->mRecorder.getRecordCount() << " frames" << std::endl;
+		this->mRecorder.stop();
+	}
 
-	this->mHandTracking.updateHands(this->mInstanceHolder.mStageSpace, time);
-	this->mHandTracking.updateInputs();
+	this->mMainLoopDisplay.recording.active = this->mRecorder.isRecording();
+	this->mMainLoopDisplay.recording.frames = this->mRecorder.getRecordCount();
+}
+
+void HOL::HandOfLesserCore::setTracing(bool tracing)
+{
+	this->mTracingRequested = tracing;
+}
+
+void HOL::HandOfLesserCore::updateTracing()
+{
+	bool requested = this->mTracingRequested;
+
+	if (requested && !this->mTracing && this->mTracePath.empty())
+	{
+		HOL::Tracer::collect(); // Only want what happens from here on
+		HOL::Tracer::setEnabled(true);
+		this->mTracing = true;
 
-	this->sendUpdate();
+		HOL::TraceControlPacket packet;
+		packet.enabled = true;
+		this->mTransport.sendPacket(9006, &packet, sizeof(HOL::TraceControlPacket));
+	}
+	else if (!requested && this->mTracing)
+	{
+		HOL::Tracer::setEnabled(false);
+		this->mTraceEvents = HOL::Tracer::collect();
+		this->mTracing = false;
+
+		// In the working directory, named after when it stopped.
+		// Driver only takes a file name and writes it to its own trace directory.
+		std::string name = std::format(
+			"trace_{:%Y%m%d_%H%M%S}",
+			std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+		std::string driverFileName = name + ".driver.json";
+		this->mTracePath = name + ".json";
+		this->mDriverTracePath
+			= (std::filesystem::path(HOL::getTraceDirectory()) / driverFileName).string();
+
+		HOL::TraceControlPacket packet;
+		packet.enabled = false;
+		strcpy(packet.fileName, driverFileName.c_str());
+		this->mTransport.sendPacket(9006, &packet, sizeof(HOL::TraceControlPacket));
+
+		this->mTraceDeadline = HOL::steadyNanoseconds() + TRACE_DRIVER_TIMEOUT_NS;
+	}
+
+	if (!this->mTracePath.empty())
+	{
+		std::error_code error;
+		bool driverDone = std::filesystem::exists(this->mDriverTracePath, error);
 
-	// OSC is less time critically and should probably happen after we send the controller packet
-	doOscStuff();
+		if (driverDone || HOL::steadyNanoseconds() > this->mTraceDeadline)
+		{
+			this->saveTrace(driverDone);
+		}
+	}
 
-	return;
+	this->mMainLoopDisplay.tracing.active = this->mTracing;
+	this->mMainLoopDisplay.tracing.saving = !this->mTracePath.empty();
 }
 
-void HandOfLesserCore::doOscStuff()
+void HOL::HandOfLesserCore::saveTrace(bool withDriver)
 {
-	// This will generate everything needed for all transmit types
-	this->mVrchatOSC.generateOscOutput(this->mHandTracking.getHandPose(HandSide::LeftHand),
-									   this->mHandTracking.getHandPose(HandSide::RightHand));
+	std::vector<std::string> merge;
+	if (withDriver)
+	{
+		merge.push_back(this->mDriverTracePath);
+	}
+	else
+	{
+		std::cerr << "Driver never wrote its trace, saving ours on its own" << std::endl;
+	}
 
-	size_t size = 0;
+	if (HOL::writeChromeTrace(this->mTracePath,
+							  HOL::TRACE_PROCESS_APP,
+							  "HandOfLesser",
+							  this->mTraceEvents,
+							  HOL::Tracer::getThreads(),
+							  merge))
+	{
+		std::cout << "Saved trace to " << this->mTracePath << std::endl;
+	}
 
-	// Always send full, expect when testing remote stuff locally because it will break things
-	if (Config.vrchat.sendFull)
+	if (withDriver)
 	{
-		size = this->mVrchatOSC.generateOscBundleFull();
-		this->mTransport.send(9000, this->mVrchatOSC.getPacketBuffer(), size);
+		std::error_code error;
+		std::filesystem::remove(this->mDriverTracePath, error);
 	}
 
-	if (Config.vrchat.sendAlternating)
+	this->mTraceEvents.clear();
+	this->mTracePath.clear();
+}
+
+void HOL::HandOfLesserCore::updatePipelineStatistics()
+{
+	if (this->mResetMainLoopStatistics.exchange(false))
 	{
-		size = this->mVrchatOSC.generateOscBundleAlternating();
-		this->mTransport.send(9000, this->mVrchatOSC.getPacketBuffer(), size);
+		this->mFrameScheduler.resetStatistics();
+		this->mPipeline.resetStatistics();
 	}
 
-	if (Config.vrchat.sendPacked)
+	HOL::MainLoopDisplay& display = this->mMainLoopDisplay;
+	display.statistics = this->mFrameScheduler.getStatistics();
+	this->mPipeline.getStatistics(display.pipeline);
+
+	this->mMainLoopDisplayMailbox.publish(display);
+}
+
+// Cheap enough to do every frame, and settings can change at any time
+void HOL::HandOfLesserCore::configureFrameScheduler()
+{
+	float rate = std::max(Config.general.UpdateRateHz, 1.f);
+	int64_t period = (int64_t)(1000000000.0 / rate);
+	int64_t phase = (int64_t)(Config.general.UpdatePhaseMS * 1000000.0);
+
+	this->mFrameScheduler.setSpinMargin((int64_t)Config.general.UpdateSpinUS * 1000);
+
+	if (this->isFramePacingActive())
+	{
+		// Closest whole number of updates per SteamVR frame, so one of them always lands
+		// at the same point in it. Phase is relative to SteamVR's frames then.
+		int64_t framePeriod = this->mFrameTiming.framePeriod;
+		int64_t updatesPerFrame
+			= std::max<int64_t>(1, std::llround((double)framePeriod / (double)period));
+
+		this->mFrameScheduler.setPeriod(framePeriod / updatesPerFrame);
+		this->mFrameScheduler.setPhase(this->mFrameTiming.frameReference, phase);
+	}
+	else
 	{
-		size = this->mVrchatOSC.generateOscBundlePacked();
-		this->mTransport.send(9000, this->mVrchatOSC.getPacketBuffer(), size);
+		// Nothing to line up with, so the phase is relative to the clock's epoch
+		this->mFrameScheduler.setPeriod(period);
+		this->mFrameScheduler.setPhase(0, phase);
 	}
+}
 
-	// VRChat input goes here for now
-	// Finalizing also resets the input packet, which will otherwise overflow.
-	// Better to control here than having every input check the setting.
-	auto [packetPointer, packetSize] = this->mVrchatInput.finalizeInputBundle();
-	if (Config.input.sendOscInput)
+void HOL::HandOfLesserCore::updateFramePacing()
+{
+	if (this->mFrameTimingMailbox.consume(this->mFrameTiming))
 	{
-		this->mTransport.send(9000, packetPointer, packetSize);
+		this->mFrameTimingReceived = HOL::steadyNanoseconds();
 	}
+
+	this->mMainLoopDisplay.framePacing.active = this->isFramePacingActive();
+	this->mMainLoopDisplay.framePacing.frameRateHz
+		= this->mFrameTiming.framePeriod > 0 ? 1e9f / this->mFrameTiming.framePeriod : 0.f;
 }
 
-void HandOfLesserCore::sendUpdate()
+bool HOL::HandOfLesserCore::isFramePacingActive()
 {
-	for (int i = 0; i < HandSide_MAX; i++)
+	return Config.general.runtimeFramePacing && this->mFrameTiming.locked
+		   && this->mFrameTiming.framePeriod > 0
+		   && HOL::steadyNanoseconds() - this->mFrameTimingReceived < FRAME_TIMING_TIMEOUT_NS;
+}
+
+// How far ahead to sample the hands. Fixed unless we know when SteamVR is going to use the
+// pose, then it's however long until its next frame plus how long that takes to be seen.
+int64_t HOL::HandOfLesserCore::getPredictionNanoseconds()
+{
+	int64_t prediction = 1000000LL * Config.general.MotionPredictionMS;
+
+	if (this->isFramePacingActive())
 	{
-		HandPose hand = this->mHandTracking.getHandPose((HandSide)i);
+		int64_t now = HOL::steadyNanoseconds();
+		int64_t nextFrame = HOL::nextTimeOnGrid(this->mFrameTiming.frameReference,
+												this->mFrameTiming.framePeriod,
+												now + FRAME_PACING_TRANSPORT_MARGIN_NS);
 
-		// No point in sending any new data if the data is the same as last time.
-		if (!hand.poseStale)
-		{
-			HOL::HandTransformPacket transPacket
-				= this->mHandTracking.getTransformPacket((HandSide)i);
-			this->mTransport.send(9006, (char*)&transPacket, sizeof(HOL::HandTransformPacket));
-
-			/*
-			HOL::ControllerInputPacket inputPacket
-				= this->mHandTracking.getInputPacket((HandSide)i);
-			this->mTransport.send(9006, (char*)&inputPacket, sizeof(HOL::ControllerInputPacket));
-			*/
-		}
+		prediction = (nextFrame - now) + (int64_t)(Config.general.runtimeLatencyMS * 1000000.0);
 	}
 
+	this->mMainLoopDisplay.framePacing.predictionMS = prediction / 1000000.f;
+	return prediction;
+}
 
-	if (Config.input.sendSteamVRInput)
+void HOL::HandOfLesserCore::requestInputIds()
+{
+	// The driver pushes its table when it starts and whenever it changes,
+	// but it may have been up before us. Keep asking until we hear back.
+	if (SteamVR::SteamVRInput::Current->hasInputIds()
+		|| HOL::timeSince(this->mLastInputIdRequest) < std::chrono::seconds(1))
 	{
-		// SteamVR inputs are submitted to a global
-		for (auto& packet : SteamVR::SteamVRInput::Current->floatInputs)
-		{
-			this->mTransport.send(9006, (char*)&packet, sizeof(HOL::FloatInputPacket));
-		}
-		for (auto& packet : SteamVR::SteamVRInput::Current->boolInputs)
-		{
-			this->mTransport.send(9006, (char*)&packet, sizeof(HOL::BoolInputPacket));
-		}
+		return;
 	}
 
-	SteamVR::SteamVRInput::Current->clear();
+	HOL::InputIdTableRequestPacket packet;
+	this->mTransport.sendPacket(9006, &packet, sizeof(HOL::InputIdTableRequestPacket));
+	this->mLastInputIdRequest = std::chrono::steady_clock::now();
+}
+
+void HOL::HandOfLesserCore::negotiatePoseEncoding()
+{
+	HOL::PoseEncodingType wanted = Config.general.compactPoseEncoding
+									   ? HOL::PoseEncodingType::Compact
+									   : HOL::PoseEncodingType::Full;
+
+	// Keep asking until the driver replies, same as the input ids
+	if (wanted == this->mPipeline.getPoseEncoding()
+		|| HOL::timeSince(this->mLastPoseEncodingRequest) < std::chrono::seconds(1))
+	{
+		return;
+	}
+
+	// Driver starts over when it gets this, so do we
+	this->mPipeline.resetPoseEncoding();
+
+	HOL::PoseEncodingPacket packet;
+	packet.encoding = wanted;
+	this->mTransport.sendPacket(9006, &packet, sizeof(HOL::PoseEncodingPacket));
+	this->mLastPoseEncodingRequest = std::chrono::steady_clock::now();
+}
+
+void HandOfLesserCore::doOpenXRStuff()
+{
+	HOL_TRACE_SCOPE("HandOfLesserCore::doOpenXRStuff");
+
+	XrTime time = this->mHandSource.getTime();
+	time += this->getPredictionNanoseconds();
+
+	this->mInstanceHolder.pollEvent();
+
+	this->mPipeline.runFrame(this->mRecorder, time);
 }
 
 void HOL::HandOfLesserCore::syncSettings()
 {
 	HOL::SettingsPacket packet;
 	packet.config = HOL::Config;
-	this->mTransport.send(9006, (char*)&packet, sizeof(HOL::SettingsPacket));
+	this->mTransport.sendPacket(9006, &packet, sizeof(HOL::SettingsPacket));
 }
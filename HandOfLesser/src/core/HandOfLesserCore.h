@@ -1,15 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include "src/openxr/InstanceHolder.h"
-#include "src/openxr/HandTracking.h"
+#include "src/openxr/openxr_hand_source.h"
 #include "src/openxr/XrEventsInterface.h"
 #include <HandOfLesserCommon.h>
 #include "src/core/ui/user_interface.h"
-#include "src/vrchat/vrchat_osc.h"
+#include "src/core/hand_pipeline.h"
+#include "src/core/hand_recording.h"
+#include "src/core/packet_sink.h"
+#include "src/core/ui/display_global.h"
 #include <thread>
-#include "src/vrchat/vrchat_input.h"
-#include "src/steamvr/steamvr_input.h"
 
 using namespace HOL;
 using namespace HOL::OpenXR;
@@ -25,24 +27,79 @@ namespace HOL
 		static HandOfLesserCore* Current; // Time to commit sinss
 
 		void syncSettings();
+		void requestPacketStatistics(bool reset);
+		void requestMetrics(bool reset);
+		void resetMainLoopStatistics();
+		void setRecording(bool recording);
+		void setTracing(bool tracing);
 
 		virtual std::vector<const char*> getRequiredExtensions();
 
 	private:
 		InstanceHolder mInstanceHolder;
-		HandTracking mHandTracking;
+		OpenXRHandSource mHandSource;
+		HOL::HandPipeline mPipeline;
 		UserInterface mUserInterface;
-		VRChatOSC mVrchatOSC;
-		VRChatInput mVrchatInput;
-		SteamVR::SteamVRInput mSteamVRInput;
 		NativeTransport mTransport;
+		HOL::TransportSink mDriverSink;
+		HOL::TransportSink mOscSink;
 
 		std::thread mUserInterfaceThread;
 		void userInterfaceLoop();
 
+		// UI thread only, everything it shows comes through these
+		void updateDisplay();
+		HOL::HandFrame mDisplayFrame;
+		uint64_t mDisplayFrameSequence = 0;
+		HOL::MainLoopDisplay mMainLoopDisplay; // Main loop's side
+		HOL::LatestValueMailbox<HOL::MainLoopDisplay> mMainLoopDisplayMailbox;
+		HOL::LatestValueMailbox<HOL::PacketStatisticsPacket> mDriverStatisticsMailbox;
+		HOL::LatestValueMailbox<HOL::MetricsSnapshot> mDriverMetricsMailbox;
+
+		std::thread mReceiveThread;
+		void receiveLoop();
+		void requestInputIds();
+		std::chrono::steady_clock::time_point mLastInputIdRequest;
+
+		// Compact poses are only sent once the driver has agreed to them
+		void negotiatePoseEncoding();
+		std::chrono::steady_clock::time_point mLastPoseEncodingRequest;
+
+		// Main loop runs on absolute deadlines, see FrameScheduler
 		void mainLoop();
+		void configureFrameScheduler();
+		HOL::FrameScheduler mFrameScheduler;
+		std::atomic<bool> mResetMainLoopStatistics = false;
+		HOL::LatencyHistogram* mMainLoopTime = HOL::getMetrics().getHistogram("main_loop");
+
+		// SteamVR's frame timing as the driver sees it, see FrameTimingPacket.
+		// Mailbox is filled by the receive thread, the rest is main loop only.
+		void updateFramePacing();
+		bool isFramePacingActive();
+		int64_t getPredictionNanoseconds();
+		HOL::LatestValueMailbox<HOL::FrameTimingPacket> mFrameTimingMailbox;
+		HOL::FrameTimingPacket mFrameTiming;
+		int64_t mFrameTimingReceived = 0;
+
+		// Hands always go through the recorder, it only writes while asked to.
+		// Main loop owns it, the UI just asks.
+		void updateRecording();
+		HOL::HandRecorder mRecorder;
+		std::atomic<bool> mRecordingRequested = false;
+
+		// Same deal for tracing. Once stopped, the driver is asked to write its half and
+		// we hold on to ours until it shows up, then merge the two, see trace.h.
+		void updateTracing();
+		void saveTrace(bool withDriver);
+		std::atomic<bool> mTracingRequested = false;
+		bool mTracing = false;
+		std::vector<HOL::TraceEvent> mTraceEvents;
+		std::string mTracePath; // Only set while saving
+		std::string mDriverTracePath;
+		int64_t mTraceDeadline = 0;
+
+		// Everything else lives in the pipeline, see HandPipeline
 		void doOpenXRStuff();
-		void doOscStuff();
-		void sendUpdate();
+		void updatePipelineStatistics();
 	};
 } // namespace HOL
@@ -0,0 +1,315 @@
+#include "hand_pipeline.h"
+#include "src/core/settings_global.h"
+#include "src/util/hol_utils.h"
+
+using namespace HOL;
+using namespace HOL::OpenXR;
+
+void HandPipeline::init(HOL::PacketSink* driverSink, HOL::PacketSink* oscSink)
+{
+	this->mDriverSink = driverSink;
+	this->mOscSink = oscSink;
+	this->mHandTracking.init();
+}
+
+void HandPipeline::setDeterministic(bool deterministic)
+{
+	this->mDeterministic = deterministic;
+}
+
+void HandPipeline::start()
+{
+	bool threaded = !this->mDeterministic;
+	this->mGestureStage.start(
+		HOL::GestureStage,
+		&this->mHandFrames,
+		[this](HOL::HandFrame& frame) { this->runGestureStage(frame); },
+		threaded);
+	this->mOscStage.start(
+		HOL::OscStage,
+		&this->mHandFrames,
+		[this](HOL::HandFrame& frame) { this->runOscStage(frame); },
+		threaded);
+}
+
+void HandPipeline::stop()
+{
+	this->mGestureStage.stop();
+	this->mOscStage.stop();
+
+	if (this->mDeterministic)
+	{
+		HOL::setPipelineClock(0);
+	}
+}
+
+void HandPipeline::runFrame(HOL::HandSource& source, XrTime time)
+{
+	HOL_TRACE_SCOPE("HandPipeline::runFrame");
+
+	if (this->mDeterministic)
+	{
+		HOL::setPipelineClock(time);
+	}
+
+	int64_t captureTime = HOL::steadyNanoseconds();
+	this->mHandTracking.updateHands(source, time);
+	int64_t tracked = HOL::steadyNanoseconds();
+	this->mTrackingTiming.record(captureTime, captureTime, tracked);
+	this->mTrackingTime->record(tracked - captureTime);
+
+	this->sendUpdate(time);
+	int64_t sent = HOL::steadyNanoseconds();
+	this->mPoseSendTiming.record(captureTime, tracked, sent);
+	this->mPoseSendTime->record(sent - tracked);
+
+	// Poses are out, everything else can take its time on its own thread.
+	// Or right here, if we're deterministic.
+	this->mHandTracking.getFrame(this->mHandFrame);
+	this->mHandFrame.sequence = ++this->mFrameSequence;
+	this->mHandFrame.time = time;
+	this->mHandFrame.captureTime = captureTime;
+
+	this->mHandFrames.publish(this->mHandFrame);
+	this->mGestureStage.notify();
+	this->mOscStage.notify();
+
+	this->mFrameTime->record(HOL::steadyNanoseconds() - captureTime);
+}
+
+void HandPipeline::setPoseEncoding(HOL::PoseEncodingType encoding)
+{
+	this->mPoseEncoding = encoding;
+}
+
+HOL::PoseEncodingType HandPipeline::getPoseEncoding()
+{
+	return this->mPoseEncoding;
+}
+
+void HandPipeline::acknowledgePoses(HOL::HandSide side, uint32_t acknowledged)
+{
+	this->mPoseEncoder.acknowledge(side, acknowledged);
+}
+
+void HandPipeline::resetPoseEncoding()
+{
+	this->mPoseEncoder.reset();
+	for (int i = 0; i < HandSide_MAX; i++)
+	{
+		this->mPoseChanges[i].reset();
+		this->mSkeletonChanges[i].reset();
+	}
+}
+
+HOL::SnapshotSlot<HOL::HandFrame>& HandPipeline::getFrames()
+{
+	return this->mHandFrames;
+}
+
+bool HandPipeline::consumeOscDisplay(HOL::VRChat::OscOutputDisplay& display)
+{
+	return this->mOscDisplayMailbox.consume(display);
+}
+
+void HandPipeline::getStatistics(HOL::PipelineStageStatistics statistics[PipelineStageType_MAX])
+{
+	statistics[TrackingStage] = this->mTrackingTiming.getStatistics();
+	statistics[PoseSendStage] = this->mPoseSendTiming.getStatistics();
+	statistics[GestureStage] = this->mGestureStage.getStatistics();
+	statistics[OscStage] = this->mOscStage.getStatistics();
+}
+
+void HandPipeline::resetStatistics()
+{
+	this->mTrackingTiming.reset();
+	this->mPoseSendTiming.reset();
+	this->mGestureStage.resetStatistics();
+	this->mOscStage.resetStatistics();
+}
+
+void HandPipeline::runGestureStage(HOL::HandFrame& frame)
+{
+	// Actions submit to the SteamVR and VRChat input globals, only this thread touches them
+	this->mHandTracking.updateGestures(frame);
+	this->sendInputs(frame.time);
+
+	// VRChat input goes here for now
+	// Finalizing also resets the input packet, which will otherwise overflow.
+	// Better to control here than having every input check the setting.
+	auto [packetPointer, packetSize] = this->mVrchatInput.finalizeInputBundle();
+	if (Config.input.sendOscInput)
+	{
+		this->mOscSink->send(packetPointer, packetSize);
+	}
+}
+
+void HandPipeline::runOscStage(HOL::HandFrame& frame)
+{
+	// This will generate everything needed for all transmit types
+	this->mVrchatOSC.generateOscOutput(frame.hands[HandSide::LeftHand].handPose,
+									   frame.hands[HandSide::RightHand].handPose);
+
+	size_t size = 0;
+	int64_t now = HOL::pipelineNanoseconds();
+
+	// Always send full, expect when testing remote stuff locally because it will break things
+	if (Config.vrchat.sendFull)
+	{
+		size = this->mVrchatOSC.generateOscBundleFull(now);
+		if (size > 0)
+		{
+			this->mOscSink->send(this->mVrchatOSC.getPacketBuffer(), size);
+		}
+	}
+
+	if (Config.vrchat.sendAlternating)
+	{
+		size = this->mVrchatOSC.generateOscBundleAlternating(now);
+		if (size > 0)
+		{
+			this->mOscSink->send(this->mVrchatOSC.getPacketBuffer(), size);
+		}
+	}
+
+	if (Config.vrchat.sendPacked)
+	{
+		size = this->mVrchatOSC.generateOscBundlePacked(now);
+		if (size > 0)
+		{
+			this->mOscSink->send(this->mVrchatOSC.getPacketBuffer(), size);
+		}
+	}
+
+	this->mOscDisplayMailbox.publish(this->mVrchatOSC.getDisplay());
+}
+
+void HandPipeline::sendUpdate(XrTime captureTime)
+{
+	HOL_TRACE_SCOPE("HandPipeline::sendUpdate");
+
+	// Both hands go out in a single datagram so the driver applies them together.
+	// Inputs follow separately from the gesture stage.
+	this->mFrameBundle.reset();
+
+	int64_t now = HOL::pipelineNanoseconds();
+	int64_t keepAlive = HOL::settings::getKeepAliveNanoseconds();
+	float positionThreshold = Config.transmit.poseDeadbandMM / 1000.f;
+	float angleThreshold = Config.transmit.poseDeadbandDegrees * (float)(EIGEN_PI / 180.0);
+	float skeletonThreshold = Config.transmit.skeletonDeadbandMM / 1000.f;
+
+	for (int i = 0; i < HandSide_MAX; i++)
+	{
+		HandPose hand = this->mHandTracking.getHandPose((HandSide)i);
+
+		// No point in sending any new data if the data is the same as last time.
+		if (!hand.poseStale)
+		{
+			HOL::HandTransformPacket transPacket
+				= this->mHandTracking.getTransformPacket((HandSide)i);
+
+			// Or if it barely moved, the driver keeps the last one
+			if (this->mPoseChanges[i].shouldSend(
+					transPacket, positionThreshold, angleThreshold, keepAlive, now))
+			{
+				this->sendPose(transPacket, captureTime);
+			}
+
+			if (Config.general.sendSkeleton)
+			{
+				HOL::HandSkeletonPacket skeleton
+					= this->mHandTracking.getSkeletonPacket((HandSide)i);
+
+				if (this->mSkeletonChanges[i].shouldSend(
+						skeleton, skeletonThreshold, keepAlive, now))
+				{
+					this->addToFrameBundle(this->mFrameBundle, skeleton, captureTime);
+				}
+			}
+
+			/*
+			HOL::ControllerInputPacket inputPacket
+				= this->mHandTracking.getInputPacket((HandSide)i);
+			this->addToFrameBundle(this->mFrameBundle, inputPacket, captureTime);
+			*/
+		}
+	}
+
+	this->flushFrameBundle(this->mFrameBundle);
+}
+
+void HandPipeline::sendInputs(XrTime captureTime)
+{
+	HOL_TRACE_SCOPE("HandPipeline::sendInputs");
+
+	this->mInputBundle.reset();
+
+	if (Config.input.sendSteamVRInput)
+	{
+		// SteamVR inputs are submitted to a global
+		for (auto& packet : SteamVR::SteamVRInput::Current->floatInputs)
+		{
+			this->addToFrameBundle(this->mInputBundle, packet, captureTime);
+		}
+		for (auto& packet : SteamVR::SteamVRInput::Current->boolInputs)
+		{
+			this->addToFrameBundle(this->mInputBundle, packet, captureTime);
+		}
+		for (auto& packet : SteamVR::SteamVRInput::Current->floatIdInputs)
+		{
+			this->addToFrameBundle(this->mInputBundle, packet, captureTime);
+		}
+		for (auto& packet : SteamVR::SteamVRInput::Current->boolIdInputs)
+		{
+			this->addToFrameBundle(this->mInputBundle, packet, captureTime);
+		}
+	}
+
+	this->flushFrameBundle(this->mInputBundle);
+
+	SteamVR::SteamVRInput::Current->clear();
+}
+
+void HandPipeline::sendPose(HOL::HandTransformPacket& packet, XrTime captureTime)
+{
+	// Shared memory only keeps the latest pose per hand, the bundle is for UDP
+	if (this->mDriverSink->publishPose(&packet, captureTime))
+	{
+		return;
+	}
+
+	// Setting can change before the driver agrees to it, check both
+	if (this->mPoseEncoding == HOL::PoseEncodingType::Compact
+		&& Config.general.compactPoseEncoding)
+	{
+		HOL::CompactHandTransformPacket compact;
+		this->mDriverSink->stamp(&compact, captureTime);
+
+		if (this->mPoseEncoder.encode(packet, compact))
+		{
+			this->addToFrameBundle(this->mFrameBundle, compact, captureTime);
+			return;
+		}
+
+		// Both count up the same sequence, send the full pose under the one we already took
+		// so the driver doesn't see a gap.
+		packet.sequence = compact.sequence;
+		packet.sendTime = compact.sendTime;
+		if (captureTime != 0)
+		{
+			packet.captureTime = captureTime;
+		}
+	}
+
+	this->addToFrameBundle(this->mFrameBundle, packet, captureTime);
+}
+
+void HandPipeline::flushFrameBundle(HOL::FrameBundleWriter& bundle)
+{
+	if (!bundle.empty())
+	{
+		this->mDriverSink->sendPacket((HOL::NativePacket*)bundle.getBuffer(), bundle.size());
+	}
+
+	bundle.reset();
+}
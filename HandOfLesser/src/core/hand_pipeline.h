@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <HandOfLesserCommon.h>
+#include "src/core/hand_source.h"
+#include "src/core/packet_sink.h"
+#include "src/core/pipeline_stage.h"
+#include "src/openxr/HandTracking.h"
+#include "src/steamvr/steamvr_input.h"
+#include "src/vrchat/vrchat_input.h"
+#include "src/vrchat/vrchat_osc.h"
+
+namespace HOL
+{
+	// Everything between the hands and the packets going out, none of the platform around it.
+	// HandOfLesserCore runs it off OpenXR with a UI on top, the headless build off whatever
+	// HandSource and sinks it's given.
+	class HandPipeline
+	{
+	public:
+		void init(HOL::PacketSink* driverSink, HOL::PacketSink* oscSink);
+
+		// Before start(). Gestures and OSC run on the main loop after the poses instead of
+		// their own threads, and the pipeline clock follows the frame times. Same frames in,
+		// same bytes out, which is what replays want. Never skips a frame, so it's slower.
+		void setDeterministic(bool deterministic);
+
+		void start();
+		void stop();
+
+		// One main loop iteration. Samples the hands for time, sends the poses,
+		// then hands the frame off to the gesture and OSC stages.
+		void runFrame(HOL::HandSource& source, XrTime time);
+
+		// Driver has the final say on the pose encoding, these come from the receive thread
+		void setPoseEncoding(HOL::PoseEncodingType encoding);
+		HOL::PoseEncodingType getPoseEncoding();
+		void acknowledgePoses(HOL::HandSide side, uint32_t acknowledged);
+
+		// Main loop only. Encoder and change detectors start over, so does the driver.
+		void resetPoseEncoding();
+
+		// Anyone can read frames from here, see SnapshotSlot
+		HOL::SnapshotSlot<HOL::HandFrame>& getFrames();
+		bool consumeOscDisplay(HOL::VRChat::OscOutputDisplay& display);
+
+		// Main loop only
+		void getStatistics(HOL::PipelineStageStatistics statistics[PipelineStageType_MAX]);
+		void resetStatistics();
+
+	private:
+		HOL::OpenXR::HandTracking mHandTracking;
+		HOL::VRChat::VRChatOSC mVrchatOSC;
+		HOL::VRChat::VRChatInput mVrchatInput;
+		HOL::SteamVR::SteamVRInput mSteamVRInput;
+		HOL::PacketSink* mDriverSink = nullptr;
+		HOL::PacketSink* mOscSink = nullptr;
+		bool mDeterministic = false;
+		HOL::FrameBundleWriter mFrameBundle;
+		HOL::FrameBundleWriter mInputBundle; // Gesture stage's own
+
+		// Compact poses are only sent once the driver has agreed to them
+		std::atomic<HOL::PoseEncodingType> mPoseEncoding = HOL::PoseEncodingType::Full;
+		HOL::PoseEncoder mPoseEncoder;
+
+		// Poses that barely moved aren't sent, see TransmitSettings
+		HOL::PoseChangeDetector mPoseChanges[HandSide_MAX];
+		HOL::SkeletonChangeDetector mSkeletonChanges[HandSide_MAX];
+
+		// Tracking and pose send run on the main loop, nothing else is allowed to hold them up.
+		// Gestures, OSC and the UI each read their own copy of the latest frame.
+		void runGestureStage(HOL::HandFrame& frame);
+		void runOscStage(HOL::HandFrame& frame);
+		HOL::HandFrame mHandFrame;
+		uint64_t mFrameSequence = 0;
+		HOL::SnapshotSlot<HOL::HandFrame> mHandFrames;
+		HOL::PipelineStage mGestureStage;
+		HOL::PipelineStage mOscStage;
+		HOL::PipelineStageTiming mTrackingTiming;
+		HOL::PipelineStageTiming mPoseSendTiming;
+		HOL::LatestValueMailbox<HOL::VRChat::OscOutputDisplay> mOscDisplayMailbox;
+
+		// Always on, unlike the statistics above these keep the whole distribution
+		HOL::LatencyHistogram* mFrameTime = HOL::getMetrics().getHistogram("frame_time");
+		HOL::LatencyHistogram* mTrackingTime = HOL::getMetrics().getHistogram("tracking");
+		HOL::LatencyHistogram* mPoseSendTime = HOL::getMetrics().getHistogram("pose_send");
+
+		void sendUpdate(XrTime captureTime);
+		void sendInputs(XrTime captureTime);
+		void sendPose(HOL::HandTransformPacket& packet, XrTime captureTime);
+		void flushFrameBundle(HOL::FrameBundleWriter& bundle);
+
+		// Only spills into another datagram if someone goes wild with inputs.
+		// Stamped individually so the driver can track each type on its own,
+		// unless it already was because something needed its sequence.
+		// Stamped in place, a copy wouldn't keep the padding the caller zeroed.
+		template <typename T>
+		void addToFrameBundle(HOL::FrameBundleWriter& bundle, T& packet, XrTime captureTime)
+		{
+			if (packet.sequence == 0)
+			{
+				this->mDriverSink->stamp(&packet, captureTime);
+			}
+
+			if (!bundle.add(packet))
+			{
+				this->flushFrameBundle(bundle);
+				bundle.add(packet);
+			}
+		}
+	};
+} // namespace HOL
@@ -0,0 +1,160 @@
+#include "hand_recording.h"
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+using namespace HOL;
+
+void HandRecorder::init(HandSource* source)
+{
+	this->mSource = source;
+}
+
+bool HandRecorder::start(const std::string& path)
+{
+	this->mLocated = 0;
+	return this->mWriter.open(path, HAND_RECORDING_TYPE, sizeof(HandRecord));
+}
+
+void HandRecorder::stop()
+{
+	this->mWriter.close();
+}
+
+bool HandRecorder::isRecording()
+{
+	return this->mWriter.isOpen();
+}
+
+uint64_t HandRecorder::getRecordCount()
+{
+	return this->mWriter.getRecordCount();
+}
+
+XrTime HandRecorder::getTime()
+{
+	return this->mSource->getTime();
+}
+
+void HandRecorder::locateHand(HOL::HandSide side, XrTime time, HandJointSample& sample)
+{
+	this->mSource->locateHand(side, time, sample);
+
+	if (!this->mWriter.isOpen())
+	{
+		return;
+	}
+
+	if (time != this->mRecord.time)
+	{
+		// Zeroed so padding is the same every time, and replays are byte for byte
+		memset(&this->mRecord, 0, sizeof(HandRecord));
+		this->mRecord.time = time;
+		this->mRecord.captureTime = HOL::steadyNanoseconds();
+		this->mLocated = 0;
+	}
+
+	HandJointSample& recorded = this->mRecord.hands[side];
+	recorded.active = sample.active;
+	memcpy(recorded.joints, sample.joints, sizeof(sample.joints));
+	memcpy(recorded.velocities, sample.velocities, sizeof(sample.velocities));
+	memcpy(&recorded.aimState, &sample.aimState, sizeof(sample.aimState));
+	recorded.aimState.next = nullptr; // Means nothing once it's on disk
+
+	this->mLocated |= 1 << side;
+	if (this->mLocated == (1 << HandSide_MAX) - 1)
+	{
+		this->mWriter.append(&this->mRecord, time);
+		this->mLocated = 0;
+	}
+}
+
+bool HandRecorder::isRunning()
+{
+	return this->mSource->isRunning();
+}
+
+bool ReplayHandSource::open(const std::string& path)
+{
+	if (!this->mReader.open(path))
+	{
+		return false;
+	}
+
+	const HOL::RecordingHeader& header = this->mReader.getHeader();
+	if (header.recordType != HAND_RECORDING_TYPE || header.recordSize != sizeof(HandRecord))
+	{
+		std::cerr << path << " isn't a hand recording, or is from another version" << std::endl;
+		this->mReader.close();
+		return false;
+	}
+
+	if (this->mReader.wasRecovered())
+	{
+		std::cerr << path << " was never closed, recovered " << this->mReader.getRecordCount()
+				  << " frames" << std::endl;
+	}
+
+	this->mNextRecord = 0;
+	return true;
+}
+
+void ReplayHandSource::close()
+{
+	this->mReader.close();
+}
+
+void ReplayHandSource::setSpeed(float speed)
+{
+	this->mSpeed = speed;
+}
+
+uint64_t ReplayHandSource::getRecordCount()
+{
+	return this->mReader.getRecordCount();
+}
+
+XrTime ReplayHandSource::getTime()
+{
+	if (!this->isRunning())
+	{
+		return this->mRecord.time;
+	}
+
+	memcpy(&this->mRecord, this->mReader.getRecord(this->mNextRecord), sizeof(HandRecord));
+
+	if (this->mNextRecord == 0)
+	{
+		this->mFirstTime = this->mRecord.time;
+		this->mStartTime = HOL::steadyNanoseconds();
+	}
+	this->mNextRecord++;
+
+	if (this->mSpeed > 0)
+	{
+		int64_t due
+			= this->mStartTime + (int64_t)((this->mRecord.time - this->mFirstTime) / this->mSpeed);
+		int64_t wait = due - HOL::steadyNanoseconds();
+		if (wait > 0)
+		{
+			std::this_thread::sleep_for(std::chrono::nanoseconds(wait));
+		}
+	}
+
+	return this->mRecord.time;
+}
+
+void ReplayHandSource::locateHand(HOL::HandSide side, XrTime time, HandJointSample& sample)
+{
+	// Whatever was recorded for this frame, even if the time asked for is a little different
+	const HandJointSample& recorded = this->mRecord.hands[side];
+	sample.active = recorded.active;
+	memcpy(sample.joints, recorded.joints, sizeof(sample.joints));
+	memcpy(sample.velocities, recorded.velocities, sizeof(sample.velocities));
+	memcpy(&sample.aimState, &recorded.aimState, sizeof(sample.aimState));
+}
+
+bool ReplayHandSource::isRunning()
+{
+	return this->mReader.isOpen() && this->mNextRecord < this->mReader.getRecordCount();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <HandOfLesserCommon.h>
+#include "src/core/hand_source.h"
+
+namespace HOL
+{
+	// RecordingHeader::recordType for hand recordings
+	static const uint32_t HAND_RECORDING_TYPE = 1;
+
+	// Everything both hands gave us for one frame, one record per frame.
+	// Written as is, so changing it means old recordings won't open. Check recordSize.
+	struct HandRecord
+	{
+		XrTime time = 0;		 // What the hands were located for
+		int64_t captureTime = 0; // steadyNanoseconds() when they were
+		HandJointSample hands[HandSide_MAX];
+	};
+
+	// Passes another source straight through, writing down what it gave us while recording.
+	// Frames are written once both hands have been located for the same time.
+	class HandRecorder : public HandSource
+	{
+	public:
+		void init(HandSource* source);
+
+		bool start(const std::string& path);
+		void stop();
+		bool isRecording();
+		uint64_t getRecordCount();
+
+		XrTime getTime() override;
+		void locateHand(HOL::HandSide side, XrTime time, HandJointSample& sample) override;
+		bool isRunning() override;
+
+	private:
+		HandSource* mSource = nullptr;
+		HOL::RecordingWriter mWriter;
+		HandRecord mRecord;
+		int mLocated = 0; // Bit per hand
+	};
+
+	// Plays a recording back, one record per getTime(). Gives exactly the times and joints
+	// that were recorded, so a deterministic HandPipeline gives exactly the same output.
+	class ReplayHandSource : public HandSource
+	{
+	public:
+		bool open(const std::string& path);
+		void close();
+
+		// 1 as recorded, 2 twice as fast. 0 doesn't wait at all.
+		void setSpeed(float speed);
+		uint64_t getRecordCount();
+
+		// Moves on to the next record, waiting until it's due
+		XrTime getTime() override;
+		void locateHand(HOL::HandSide side, XrTime time, HandJointSample& sample) override;
+		bool isRunning() override;
+
+	private:
+		HOL::RecordingReader mReader;
+		HandRecord mRecord;
+		uint64_t mNextRecord = 0;
+		float mSpeed = 1.f;
+
+		// Where playback started, in both clocks
+		XrTime mFirstTime = 0;
+		int64_t mStartTime = 0;
+	};
+} // namespace HOL
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <HandOfLesserCommon.h>
+
+namespace HOL
+{
+	// Raw joints for one hand, exactly as OpenXR would hand them to us
+	struct HandJointSample
+	{
+		bool active = false;
+		XrHandJointLocationEXT joints[XR_HAND_JOINT_COUNT_EXT];
+		XrHandJointVelocityEXT velocities[XR_HAND_JOINT_COUNT_EXT];
+		XrHandTrackingAimStateFB aimState{XR_TYPE_HAND_TRACKING_AIM_STATE_FB};
+	};
+
+	// Where OpenXRHand gets its joints from. The runtime normally, but anything that
+	// can produce joints will do, so the rest of the pipeline can run without a headset.
+	class HandSource
+	{
+	public:
+		virtual ~HandSource() = default;
+
+		// Now, in whatever clock the source predicts against. XrTime for OpenXR.
+		virtual XrTime getTime() = 0;
+
+		// Called once per hand per frame from the main loop
+		virtual void locateHand(HOL::HandSide side, XrTime time, HandJointSample& sample) = 0;
+
+		// Sources that run out, like a recording, return false once they have
+		virtual bool isRunning()
+		{
+			return true;
+		}
+	};
+} // namespace HOL
@@ -0,0 +1,122 @@
+#include "packet_sink.h"
+#include "src/util/hol_utils.h"
+#include <iostream>
+
+using namespace HOL;
+
+void TransportSink::init(HOL::NativeTransport* transport, int port)
+{
+	this->mTransport = transport;
+	this->mPort = port;
+}
+
+void TransportSink::send(char* buffer, size_t size)
+{
+	this->mTransport->send(this->mPort, buffer, size);
+}
+
+void TransportSink::sendPacket(HOL::NativePacket* packet, size_t size)
+{
+	this->mTransport->sendPacket(this->mPort, packet, size);
+}
+
+void TransportSink::stamp(HOL::NativePacket* packet, int64_t captureTime)
+{
+	this->mTransport->stamp(packet, captureTime);
+}
+
+bool TransportSink::publishPose(HOL::HandTransformPacket* packet, int64_t captureTime)
+{
+	return this->mTransport->publishPose(packet, captureTime);
+}
+
+void NullSink::send(char* buffer, size_t size)
+{
+	this->mPackets++;
+	this->mBytes += size;
+}
+
+void NullSink::sendPacket(HOL::NativePacket* packet, size_t size)
+{
+	this->mPackets++;
+	this->mBytes += size;
+}
+
+void NullSink::stamp(HOL::NativePacket* packet, int64_t captureTime)
+{
+	std::lock_guard<std::mutex> lock(this->mStampMutex);
+
+	uint32_t& sequence = this->mSequences[packet->packetType];
+	sequence = sequence + 1 == 0 ? 1 : sequence + 1;
+
+	packet->sequence = sequence;
+	if (captureTime != 0)
+	{
+		packet->captureTime = captureTime;
+	}
+	packet->sendTime = HOL::pipelineNanoseconds();
+}
+
+uint64_t NullSink::getPackets()
+{
+	return this->mPackets;
+}
+
+uint64_t NullSink::getBytes()
+{
+	return this->mBytes;
+}
+
+CaptureSink::~CaptureSink()
+{
+	this->close();
+}
+
+bool CaptureSink::open(const std::string& path)
+{
+	this->close();
+
+	this->mFile = fopen(path.c_str(), "wb");
+	if (this->mFile == nullptr)
+	{
+		std::cerr << "Failed to open capture " << path << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+void CaptureSink::close()
+{
+	std::lock_guard<std::mutex> lock(this->mFileMutex);
+	if (this->mFile != nullptr)
+	{
+		fclose(this->mFile);
+		this->mFile = nullptr;
+	}
+}
+
+void CaptureSink::send(char* buffer, size_t size)
+{
+	NullSink::send(buffer, size);
+	this->write(buffer, size);
+}
+
+void CaptureSink::sendPacket(HOL::NativePacket* packet, size_t size)
+{
+	NullSink::sendPacket(packet, size);
+	this->write((const char*)packet, size);
+}
+
+void CaptureSink::write(const char* buffer, size_t size)
+{
+	std::lock_guard<std::mutex> lock(this->mFileMutex);
+	if (this->mFile == nullptr)
+	{
+		return;
+	}
+
+	uint32_t length = (uint32_t)size;
+	fwrite(&length, sizeof(uint32_t), 1, this->mFile);
+	fwrite(buffer, 1, size, this->mFile);
+}
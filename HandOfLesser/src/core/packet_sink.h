@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <HandOfLesserCommon.h>
+
+namespace HOL
+{
+	// Where the pipeline's output goes, one per destination.
+	// Everything may be called from several threads at once.
+	class PacketSink
+	{
+	public:
+		virtual ~PacketSink() = default;
+
+		// Already encoded, like OSC bundles
+		virtual void send(char* buffer, size_t size) = 0;
+
+		virtual void sendPacket(HOL::NativePacket* packet, size_t size) = 0;
+		virtual void stamp(HOL::NativePacket* packet, int64_t captureTime) = 0;
+
+		// True if the pose went out some other way than sendPacket, see NativeTransport
+		virtual bool publishPose(HOL::HandTransformPacket* packet, int64_t captureTime)
+		{
+			return false;
+		}
+	};
+
+	// A port on a NativeTransport, shared with whoever else is using it
+	class TransportSink : public PacketSink
+	{
+	public:
+		void init(HOL::NativeTransport* transport, int port);
+
+		void send(char* buffer, size_t size) override;
+		void sendPacket(HOL::NativePacket* packet, size_t size) override;
+		void stamp(HOL::NativePacket* packet, int64_t captureTime) override;
+		bool publishPose(HOL::HandTransformPacket* packet, int64_t captureTime) override;
+
+	private:
+		HOL::NativeTransport* mTransport = nullptr;
+		int mPort = 0;
+	};
+
+	// Throws everything away, but keeps count
+	class NullSink : public PacketSink
+	{
+	public:
+		void send(char* buffer, size_t size) override;
+		void sendPacket(HOL::NativePacket* packet, size_t size) override;
+		void stamp(HOL::NativePacket* packet, int64_t captureTime) override;
+
+		uint64_t getPackets();
+		uint64_t getBytes();
+
+	private:
+		std::atomic<uint64_t> mPackets = 0;
+		std::atomic<uint64_t> mBytes = 0;
+
+		// Same rules as NativeTransport, so nothing downstream can tell the difference
+		std::mutex mStampMutex;
+		std::unordered_map<HOL::NativePacketType, uint32_t> mSequences;
+	};
+
+	// Counts like NullSink, and writes everything to a file as its size and then the bytes.
+	// A deterministic replay written through one of these should match the last one exactly.
+	class CaptureSink : public NullSink
+	{
+	public:
+		~CaptureSink();
+
+		bool open(const std::string& path);
+		void close();
+
+		void send(char* buffer, size_t size) override;
+		void sendPacket(HOL::NativePacket* packet, size_t size) override;
+
+	private:
+		void write(const char* buffer, size_t size);
+
+		std::mutex mFileMutex;
+		FILE* mFile = nullptr;
+	};
+} // namespace HOL
@@ -0,0 +1,174 @@
+#include "pipeline_stage.h"
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace HOL
+{
+	const char* getPipelineStageName(PipelineStageType stage)
+	{
+		switch (stage)
+		{
+			case TrackingStage:
+				return "Tracking";
+			case PoseSendStage:
+				return "Pose send";
+			case GestureStage:
+				return "Gestures";
+			case OscStage:
+				return "OSC";
+			default:
+				return "Unknown";
+		}
+	}
+
+	void PipelineStageTiming::record(int64_t captureTime, int64_t start, int64_t end)
+	{
+		int64_t wait = std::max<int64_t>(start - captureTime, 0);
+		int64_t work = std::max<int64_t>(end - start, 0);
+		int64_t latency = std::max<int64_t>(end - captureTime, 0);
+
+		this->mFrames++;
+		this->mWaitSum += (double)wait;
+		this->mWorkSum += (double)work;
+		this->mLatencySum += (double)latency;
+		this->mWaitMax = std::max(this->mWaitMax, wait);
+		this->mWorkMax = std::max(this->mWorkMax, work);
+		this->mLatencyMax = std::max(this->mLatencyMax, latency);
+	}
+
+	PipelineStageStatistics PipelineStageTiming::getStatistics()
+	{
+		PipelineStageStatistics statistics;
+		statistics.frames = this->mFrames;
+		statistics.waitMaxUS = this->mWaitMax / 1000.f;
+		statistics.workMaxUS = this->mWorkMax / 1000.f;
+		statistics.latencyMaxUS = this->mLatencyMax / 1000.f;
+
+		if (this->mFrames > 0)
+		{
+			statistics.waitMeanUS = (float)(this->mWaitSum / this->mFrames / 1000.0);
+			statistics.workMeanUS = (float)(this->mWorkSum / this->mFrames / 1000.0);
+			statistics.latencyMeanUS = (float)(this->mLatencySum / this->mFrames / 1000.0);
+		}
+
+		return statistics;
+	}
+
+	void PipelineStageTiming::reset()
+	{
+		*this = PipelineStageTiming();
+	}
+
+	void PipelineStage::start(PipelineStageType type,
+							  SnapshotSlot<HandFrame>* frames,
+							  std::function<void(HandFrame&)> work,
+							  bool threaded)
+	{
+		this->mType = type;
+		this->mFrames = frames;
+		this->mWork = work;
+		this->mThreaded = threaded;
+		this->mRunning = true;
+
+		// "OSC" becomes osc_backlog
+		std::string name = getPipelineStageName(type);
+		std::transform(name.begin(), name.end(), name.begin(), [](char c) {
+			return c == ' ' ? '_' : (char)std::tolower((unsigned char)c);
+		});
+		this->mBacklog = HOL::getMetrics().getGauge((name + "_backlog").c_str());
+
+		if (threaded)
+		{
+			this->mThread = std::thread(&PipelineStage::run, this);
+		}
+	}
+
+	void PipelineStage::stop()
+	{
+		if (!this->mThread.joinable())
+		{
+			return;
+		}
+
+		this->mRunning = false;
+		this->mWake.fetch_add(1);
+		this->mWake.notify_one();
+		this->mThread.join();
+	}
+
+	void PipelineStage::notify()
+	{
+		if (!this->mThreaded)
+		{
+			this->process();
+			return;
+		}
+
+		this->mWake.fetch_add(1);
+		this->mWake.notify_one();
+	}
+
+	PipelineStageStatistics PipelineStage::getStatistics()
+	{
+		std::lock_guard<std::mutex> lock(this->mStatisticsMutex);
+		PipelineStageStatistics statistics = this->mTiming.getStatistics();
+		statistics.skipped = this->mSkipped;
+		return statistics;
+	}
+
+	void PipelineStage::resetStatistics()
+	{
+		// Worker picks this up so it doesn't need the lock for every frame
+		this->mResetStatistics = true;
+	}
+
+	void PipelineStage::run()
+	{
+		HOL_TRACE_THREAD(getPipelineStageName(this->mType));
+
+		while (this->mRunning)
+		{
+			// Read before checking the mailbox, so a publish in between still wakes us
+			uint32_t wake = this->mWake.load();
+
+			if (!this->process())
+			{
+				this->mWake.wait(wake);
+			}
+		}
+	}
+
+	bool PipelineStage::process()
+	{
+		uint64_t lastSequence = this->mFrameSequence;
+		if (!this->mFrames->read(this->mFrame, this->mFrameSequence))
+		{
+			return false;
+		}
+
+		HOL_TRACE_SCOPE(getPipelineStageName(this->mType));
+
+		int64_t start = HOL::steadyNanoseconds();
+		this->mWork(this->mFrame);
+		int64_t end = HOL::steadyNanoseconds();
+
+		std::lock_guard<std::mutex> lock(this->mStatisticsMutex);
+		if (this->mResetStatistics.exchange(false))
+		{
+			this->mTiming.reset();
+			this->mSkipped = 0;
+		}
+		this->mTiming.record(this->mFrame.captureTime, start, end);
+
+		// Nothing to skip before the first one
+		if (lastSequence != 0)
+		{
+			uint64_t skipped = this->mFrameSequence - lastSequence - 1;
+			this->mSkipped += skipped;
+			this->mBacklog->set((int64_t)skipped);
+		}
+
+		return true;
+	}
+} // namespace HOL
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <HandOfLesserCommon.h>
+#include "src/hands/hand_frame.h"
+
+namespace HOL
+{
+	enum PipelineStageType
+	{
+		TrackingStage,
+		PoseSendStage,
+		GestureStage,
+		OscStage,
+		PipelineStageType_MAX
+	};
+
+	const char* getPipelineStageName(PipelineStageType stage);
+
+	// All relative to when the frame was captured
+	struct PipelineStageStatistics
+	{
+		uint64_t frames = 0;
+		uint64_t skipped = 0; // Newer frame came in before we got to it
+		float waitMeanUS = 0; // Capture until the stage started on it
+		float waitMaxUS = 0;
+		float workMeanUS = 0;
+		float workMaxUS = 0;
+		float latencyMeanUS = 0; // Capture until the stage was done with it
+		float latencyMaxUS = 0;
+	};
+
+	// Not thread safe, whoever records owns it
+	class PipelineStageTiming
+	{
+	public:
+		void record(int64_t captureTime, int64_t start, int64_t end);
+		PipelineStageStatistics getStatistics();
+		void reset();
+
+	private:
+		uint64_t mFrames = 0;
+		double mWaitSum = 0;
+		double mWorkSum = 0;
+		double mLatencySum = 0;
+		int64_t mWaitMax = 0;
+		int64_t mWorkMax = 0;
+		int64_t mLatencyMax = 0;
+	};
+
+	// Worker thread that runs on the latest HandFrame in a shared slot.
+	// If it falls behind, frames in between are skipped rather than queued,
+	// so a slow stage never holds up the main loop or runs on old data.
+	class PipelineStage
+	{
+	public:
+		// Work gets the stage's own copy of the frame.
+		// Not threaded runs the work on whoever calls notify(), for deterministic replays.
+		void start(PipelineStageType type,
+				   SnapshotSlot<HandFrame>* frames,
+				   std::function<void(HandFrame&)> work,
+				   bool threaded = true);
+		void stop();
+
+		// Call after publishing a new frame to the slot
+		void notify();
+
+		PipelineStageStatistics getStatistics();
+		void resetStatistics();
+
+	private:
+		void run();
+		bool process();
+
+		PipelineStageType mType = PipelineStageType_MAX;
+		std::function<void(HandFrame&)> mWork;
+		SnapshotSlot<HandFrame>* mFrames = nullptr;
+		HandFrame mFrame;
+		uint64_t mFrameSequence = 0;
+
+		std::thread mThread;
+		bool mThreaded = true;
+		std::atomic<bool> mRunning = false;
+		std::atomic<uint32_t> mWake = 0;
+		std::atomic<bool> mResetStatistics = false;
+
+		std::mutex mStatisticsMutex;
+		PipelineStageTiming mTiming;
+		uint64_t mSkipped = 0;
+
+		// Frames that came in since the last one we picked up, named after the stage
+		HOL::MetricGauge* mBacklog = nullptr;
+	};
+} // namespace HOL
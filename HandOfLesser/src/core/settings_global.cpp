@@ -17,5 +17,15 @@ namespace HOL
 			Config.handPose.OrientationOffset = def.orientation;
 		}
 
+		int64_t getKeepAliveNanoseconds()
+		{
+			if (!Config.transmit.changeDetection)
+			{
+				return 0;
+			}
+
+			return (int64_t)Config.transmit.keepAliveMS * 1000000;
+		}
+
 	} // namespace settings
 } // namespace HOL
@@ -12,6 +12,9 @@ namespace HOL
 	namespace settings
 	{
 		void restoreDefaultControllerOffset(ControllerOffsetPreset type);
+
+		// 0 if change detection is off, which makes every DeadbandChannel send
+		int64_t getKeepAliveNanoseconds();
 	}
 
 	extern HOL::settings::HandOfLesserSettings Config;
@@ -0,0 +1,119 @@
+#include "synthetic_hand_source.h"
+#include "src/openxr/xr_hand_utils.h"
+#include <cmath>
+
+using namespace HOL;
+using namespace HOL::OpenXR;
+
+// Roughly an adult hand, in meters. Metacarpal, proximal, intermediate, distal.
+static const float BONE_LENGTHS[FingerType::FingerType_MAX][4] = {
+	{0.045f, 0.035f, 0.030f, 0.f}, // Thumb has no intermediate
+	{0.065f, 0.040f, 0.025f, 0.020f},
+	{0.065f, 0.045f, 0.028f, 0.020f},
+	{0.060f, 0.042f, 0.026f, 0.020f},
+	{0.055f, 0.032f, 0.020f, 0.018f},
+};
+
+// Where each finger's first joint sits relative to the palm, left hand
+static const Eigen::Vector3f FINGER_ROOTS[FingerType::FingerType_MAX] = {
+	{0.025f, -0.010f, 0.030f},
+	{0.020f, 0.f, 0.035f},
+	{0.f, 0.f, 0.035f},
+	{-0.020f, 0.f, 0.035f},
+	{-0.035f, 0.f, 0.030f},
+};
+
+static const float MAX_JOINT_CURL = 1.4f; // Radians, per joint
+static const float PI = (float)EIGEN_PI;
+
+XrTime SyntheticHandSource::getTime()
+{
+	return HOL::steadyNanoseconds();
+}
+
+void SyntheticHandSource::locateHand(HOL::HandSide side, XrTime time, HandJointSample& sample)
+{
+	const float seconds = (float)((double)time / 1000000000.0);
+	const float mirror = side == HandSide::LeftHand ? 1.f : -1.f;
+	const XrSpaceLocationFlags flags
+		= XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT
+		  | XR_SPACE_LOCATION_POSITION_TRACKED_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
+
+	// Palm goes round in a small circle and wobbles a bit, right hand out of step with the left
+	const float motionPhase = 2.f * PI * this->motionRateHz * seconds + (float)side * PI;
+	const float radius = 0.05f;
+	Eigen::Vector3f palmPosition(-0.2f * mirror + radius * std::cos(motionPhase),
+								 1.2f + radius * std::sin(motionPhase),
+								 -0.3f);
+	Eigen::Vector3f palmVelocity(-radius * std::sin(motionPhase),
+								 radius * std::cos(motionPhase),
+								 0.f);
+	palmVelocity *= 2.f * PI * this->motionRateHz;
+
+	Eigen::Quaternionf palmOrientation(
+		Eigen::AngleAxisf(0.25f * std::sin(motionPhase) * mirror, Eigen::Vector3f::UnitY()));
+
+	const auto setJoint = [&](int joint, Eigen::Vector3f position, Eigen::Quaternionf orientation)
+	{
+		sample.joints[joint].locationFlags = flags;
+		sample.joints[joint].pose.position = toXrVector(position);
+		sample.joints[joint].pose.orientation = toXrQuaternion(orientation);
+		sample.joints[joint].radius = 0.01f;
+
+		sample.velocities[joint].velocityFlags = 0x3; // Linear and angular valid
+		sample.velocities[joint].linearVelocity = toXrVector(palmVelocity);
+		sample.velocities[joint].angularVelocity = XrVector3f{0.f, 0.f, 0.f};
+	};
+
+	setJoint(XR_HAND_JOINT_PALM_EXT, palmPosition, palmOrientation);
+	setJoint(XR_HAND_JOINT_WRIST_EXT,
+			 palmPosition + palmOrientation * Eigen::Vector3f(0.f, 0.f, 0.05f),
+			 palmOrientation);
+
+	float curls[FingerType::FingerType_MAX];
+
+	for (int finger = 0; finger < FingerType::FingerType_MAX; finger++)
+	{
+		// 0 open, 1 fist
+		const float curlPhase = 2.f * PI * this->curlRateHz * seconds - finger * 0.6f;
+		const float curl = 0.5f - 0.5f * std::cos(curlPhase);
+		curls[finger] = curl;
+
+		// Spread the fingers out a bit, and the thumb a lot
+		float splay = finger == FingerType::FingerThumb ? 0.7f : (2 - finger) * 0.08f;
+		Eigen::Quaternionf orientation
+			= palmOrientation * Eigen::AngleAxisf(splay * mirror, Eigen::Vector3f::UnitY());
+
+		Eigen::Vector3f root = FINGER_ROOTS[finger];
+		root.x() *= mirror;
+		Eigen::Vector3f position = palmPosition + palmOrientation * root;
+
+		// -Z points down the finger, curling in is around -X.
+		// Tip is always 4 past the root, which is the wrist for the thumb.
+		int rootJoint = OpenXR::getRootJoint((FingerType)finger);
+		int tipJoint = rootJoint + 4;
+		int firstBone = finger == FingerType::FingerThumb ? 1 : 0;
+
+		for (int bone = 0; bone < 4 - firstBone; bone++)
+		{
+			setJoint(rootJoint + firstBone + bone, position, orientation);
+			position += orientation * Eigen::Vector3f(0.f, 0.f, -BONE_LENGTHS[finger][bone]);
+
+			// Metacarpals barely move
+			float bend = bone == 0 ? 0.1f * curl : curl;
+			orientation = orientation
+						  * Eigen::AngleAxisf(-bend * MAX_JOINT_CURL, Eigen::Vector3f::UnitX());
+		}
+
+		setJoint(tipJoint, position, orientation);
+	}
+
+	sample.active = true;
+	sample.aimState.status = XR_HAND_TRACKING_AIM_COMPUTED_BIT_FB | XR_HAND_TRACKING_AIM_VALID_BIT_FB;
+	sample.aimState.aimPose.position = toXrVector(palmPosition);
+	sample.aimState.aimPose.orientation = toXrQuaternion(palmOrientation);
+	sample.aimState.pinchStrengthIndex = curls[FingerType::FingerIndex];
+	sample.aimState.pinchStrengthMiddle = curls[FingerType::FingerMiddle];
+	sample.aimState.pinchStrengthRing = curls[FingerType::FingerRing];
+	sample.aimState.pinchStrengthLittle = curls[FingerType::FingerLittle];
+}
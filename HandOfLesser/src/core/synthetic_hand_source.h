@@ -0,0 +1,20 @@
+#pragma once
+
+#include "src/core/hand_source.h"
+
+namespace HOL
+{
+	// Made up hands that drift around in front of you and open and close their fingers,
+	// each finger a bit out of step with the last. Only depends on the time asked for,
+	// so the same times always give the same joints.
+	class SyntheticHandSource : public HandSource
+	{
+	public:
+		XrTime getTime() override;
+		void locateHand(HOL::HandSide side, XrTime time, HandJointSample& sample) override;
+
+		// Full open-close cycles per second
+		float curlRateHz = 0.5f;
+		float motionRateHz = 0.25f;
+	};
+} // namespace HOL
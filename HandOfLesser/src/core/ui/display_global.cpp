@@ -7,8 +7,16 @@ namespace HOL::display
 	HandTransformDisplay HandTransform[2];
 	FingerTrackingDisplay FingerTracking[2];
 
-	OpenXR::OpenXrState OpenXrInstanceState = OpenXR::OpenXrState::Uninitialized;
+	std::atomic<OpenXR::OpenXrState> OpenXrInstanceState = OpenXR::OpenXrState::Uninitialized;
 	std::string OpenXrRuntimeName = "Unknown";
 	bool IsVDXR = false;
 
+	PacketStatisticsPacket DriverPacketStatistics;
+	MetricsSnapshot DriverMetrics;
+	FrameSchedulerStatistics MainLoopStatistics;
+	FramePacingDisplay FramePacing;
+	RecordingDisplay Recording;
+	TracingDisplay Tracing;
+	PipelineStageStatistics PipelineStatistics[PipelineStageType_MAX];
+
 } // namespace HOL::display
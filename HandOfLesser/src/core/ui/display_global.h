@@ -1,7 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <HandOfLesserCommon.h>
 #include "src/openxr/openxr_state.h"
+#include "src/core/pipeline_stage.h"
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
@@ -18,6 +20,35 @@ namespace HOL
 		PoseLocation finalPose;
 	};
 
+	struct FramePacingDisplay
+	{
+		bool active = false;
+		float frameRateHz = 0;
+		float predictionMS = 0;
+	};
+
+	struct RecordingDisplay
+	{
+		bool active = false;
+		uint64_t frames = 0;
+	};
+
+	struct TracingDisplay
+	{
+		bool active = false;
+		bool saving = false; // Waiting on the driver's half
+	};
+
+	// Main loop publishes this every iteration, the UI copies it into the globals below
+	struct MainLoopDisplay
+	{
+		FrameSchedulerStatistics statistics;
+		FramePacingDisplay framePacing;
+		RecordingDisplay recording;
+		TracingDisplay tracing;
+		PipelineStageStatistics pipeline[PipelineStageType_MAX];
+	};
+
 	struct FingerTrackingDisplay
 	{
 		FingerBend rawBend[FingerType::FingerType_MAX];
@@ -25,13 +56,28 @@ namespace HOL
 		FingerBend packedBend[FingerType::FingerType_MAX]; // reusing for int values
 	};
 
+	// Only the UI thread touches these. Everything else publishes to HandOfLesserCore,
+	// which fills them in at the start of each UI frame.
 	namespace display
 	{
 		extern FingerTrackingDisplay FingerTracking[2];
 		extern HandTransformDisplay HandTransform[2];
 
-		extern OpenXR::OpenXrState OpenXrInstanceState;
+		extern std::atomic<OpenXR::OpenXrState> OpenXrInstanceState; // Except this one
 		extern std::string OpenXrRuntimeName;
 		extern bool IsVDXR;
+
+		// Last reply to HandOfLesserCore::requestPacketStatistics()
+		extern PacketStatisticsPacket DriverPacketStatistics;
+
+		// Last reply to HandOfLesserCore::requestMetrics()
+		extern MetricsSnapshot DriverMetrics;
+
+		// Copied out of the main loop's FrameScheduler every frame
+		extern FrameSchedulerStatistics MainLoopStatistics;
+		extern FramePacingDisplay FramePacing;
+		extern RecordingDisplay Recording;
+		extern TracingDisplay Tracing;
+		extern PipelineStageStatistics PipelineStatistics[PipelineStageType_MAX];
 	} // namespace display
 } // namespace HOL
\ No newline at end of file
@@ -6,7 +6,9 @@
 #include "imgui_impl_opengl3.h"
 
 #include <vector>
+#include <chrono>
 #include <cmath>
+#include <format>
 #include <iostream>
 #include <imgui_impl_win32.h>
 
@@ -18,6 +20,7 @@
 using namespace HOL;
 
 static const int PANEL_WIDTH = 600;
+static const int64_t METRICS_REQUEST_INTERVAL_NS = 1000000000;
 
 UserInterface* UserInterface::Current = nullptr;
 
@@ -368,6 +371,229 @@ void UserInterface::InputFloatMultipleTopLableWithButtons(
 	ImGui::PopItemWidth();
 }
 
+void HOL::UserInterface::buildPacketStatisticsDisplay()
+{
+	ImGui::SeparatorText("Driver transport statistics");
+
+	if (ImGui::Button("Refresh"))
+	{
+		HOL::HandOfLesserCore::Current->requestPacketStatistics(false);
+	}
+
+	ImGui::SameLine();
+
+	if (ImGui::Button("Reset"))
+	{
+		HOL::HandOfLesserCore::Current->requestPacketStatistics(true);
+	}
+
+	// Shared memory poses overwritten before the driver got to them count as lost
+	auto& statistics = HOL::display::DriverPacketStatistics;
+	if (ImGui::BeginTable("PacketStatistics", 6))
+	{
+		ImGui::TableSetupColumn("Type");
+		ImGui::TableSetupColumn("Received");
+		ImGui::TableSetupColumn("Lost");
+		ImGui::TableSetupColumn("Reordered");
+		ImGui::TableSetupColumn("p50 (us)");
+		ImGui::TableSetupColumn("p99 (us)");
+		ImGui::TableHeadersRow();
+
+		for (uint32_t i = 0; i < statistics.count && i < HOL::PACKET_STATISTICS_MAX_TYPES; i++)
+		{
+			const HOL::PacketTypeStatistics& stats = statistics.types[i];
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%d", (int)stats.packetType);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", stats.received);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u (%.2f%%)", stats.lost, stats.lossRate * 100.f);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", stats.reordered);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.0f", stats.latencyP50);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.0f", stats.latencyP99);
+		}
+
+		ImGui::EndTable();
+	}
+}
+
+void HOL::UserInterface::buildMainLoopStatisticsDisplay()
+{
+	ImGui::SeparatorText("Main loop timing");
+
+	if (ImGui::Button("Reset##MainLoop"))
+	{
+		HOL::HandOfLesserCore::Current->resetMainLoopStatistics();
+	}
+
+	auto& statistics = HOL::display::MainLoopStatistics;
+	ImGui::Text("Frames: %llu", (unsigned long long)statistics.frames);
+	ImGui::Text("Overruns: %llu, missed: %llu",
+				(unsigned long long)statistics.overruns,
+				(unsigned long long)statistics.missedDeadlines);
+	ImGui::Text("Period: %.1f us, jitter %.1f us, worst %.1f us",
+				statistics.periodMeanUS,
+				statistics.periodJitterUS,
+				statistics.periodMaxErrorUS);
+	ImGui::Text("Late wakeup: %.1f us, worst %.1f us",
+				statistics.latenessMeanUS,
+				statistics.latenessMaxUS);
+
+	auto& pacing = HOL::display::FramePacing;
+	ImGui::Text("SteamVR: %.1f Hz, %s, prediction %.1f ms",
+				pacing.frameRateHz,
+				pacing.active ? "paced" : "not paced",
+				pacing.predictionMS);
+
+	// Latency is from when the hands were sampled until the stage was done with them
+	for (int i = 0; i < PipelineStageType_MAX; i++)
+	{
+		auto& stage = HOL::display::PipelineStatistics[i];
+		ImGui::Text("%s: %.1f us (worst %.1f), work %.1f us, skipped %llu",
+					HOL::getPipelineStageName((PipelineStageType)i),
+					stage.latencyMeanUS,
+					stage.latencyMaxUS,
+					stage.workMeanUS,
+					(unsigned long long)stage.skipped);
+	}
+
+	// App and driver together, written to the working directory. Open in ui.perfetto.dev
+#ifdef HOL_TRACING
+	auto& tracing = HOL::display::Tracing;
+	if (tracing.saving)
+	{
+		ImGui::Text("Waiting for the driver's trace...");
+	}
+	else if (ImGui::Button(tracing.active ? "Stop trace" : "Start trace"))
+	{
+		HOL::HandOfLesserCore::Current->setTracing(!tracing.active);
+	}
+#else
+	ImGui::TextDisabled("Tracing needs a build with HOL_ENABLE_TRACING");
+#endif
+}
+
+void HOL::UserInterface::buildMetricsTables(const char* label,
+											const HOL::MetricsSnapshot& snapshot)
+{
+	ImGui::PushID(label);
+	ImGui::SeparatorText(label);
+
+	// Percentiles are within about 6%, max is exact
+	if (ImGui::BeginTable("Histograms", 8))
+	{
+		ImGui::TableSetupColumn("Latency (us)");
+		ImGui::TableSetupColumn("Count");
+		ImGui::TableSetupColumn("Mean");
+		ImGui::TableSetupColumn("p50");
+		ImGui::TableSetupColumn("p90");
+		ImGui::TableSetupColumn("p99");
+		ImGui::TableSetupColumn("p99.9");
+		ImGui::TableSetupColumn("Max");
+		ImGui::TableHeadersRow();
+
+		for (uint32_t i = 0; i < snapshot.histogramCount && i < HOL::METRICS_MAX_HISTOGRAMS; i++)
+		{
+			const HOL::MetricsHistogramSnapshot& histogram = snapshot.histograms[i];
+			const HOL::LatencySummary& summary = histogram.summary;
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%.*s", HOL::METRICS_NAME_LENGTH, histogram.name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", (unsigned long long)summary.count);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", summary.meanUS);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", summary.p50US);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", summary.p90US);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", summary.p99US);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", summary.p999US);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", summary.maxUS);
+		}
+
+		ImGui::EndTable();
+	}
+
+	if (ImGui::BeginTable("Values", 2))
+	{
+		ImGui::TableSetupColumn("Counter / gauge");
+		ImGui::TableSetupColumn("Value");
+		ImGui::TableHeadersRow();
+
+		for (uint32_t i = 0; i < snapshot.counterCount && i < HOL::METRICS_MAX_COUNTERS; i++)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%.*s", HOL::METRICS_NAME_LENGTH, snapshot.counters[i].name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%lld", (long long)snapshot.counters[i].value);
+		}
+
+		for (uint32_t i = 0; i < snapshot.gaugeCount && i < HOL::METRICS_MAX_GAUGES; i++)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%.*s", HOL::METRICS_NAME_LENGTH, snapshot.gauges[i].name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%lld", (long long)snapshot.gauges[i].value);
+		}
+
+		ImGui::EndTable();
+	}
+
+	ImGui::PopID();
+}
+
+void HOL::UserInterface::buildMetrics()
+{
+	// Only bother the driver while someone is looking
+	int64_t now = HOL::steadyNanoseconds();
+	if (now - this->mLastMetricsRequest > METRICS_REQUEST_INTERVAL_NS)
+	{
+		HOL::HandOfLesserCore::Current->requestMetrics(false);
+		this->mLastMetricsRequest = now;
+	}
+
+	HOL::getMetrics().snapshot(this->mAppMetrics);
+
+	if (ImGui::Button("Reset"))
+	{
+		HOL::getMetrics().reset();
+		HOL::HandOfLesserCore::Current->requestMetrics(true);
+		this->mLastMetricsRequest = now;
+	}
+
+	ImGui::SameLine();
+
+	if (ImGui::Button("Save"))
+	{
+		std::string text;
+		HOL::formatMetrics("HandOfLesser", this->mAppMetrics, text);
+		HOL::formatMetrics("HandOfLesserDriver", HOL::display::DriverMetrics, text);
+
+		std::string path = std::format(
+			"metrics_{:%Y%m%d_%H%M%S}.txt",
+			std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+		if (HOL::writeMetrics(path, text))
+		{
+			std::cout << "Saved metrics to " << path << std::endl;
+		}
+	}
+
+	this->buildMetricsTables("App", this->mAppMetrics);
+	this->buildMetricsTables("Driver", HOL::display::DriverMetrics);
+}
+
 void HOL::UserInterface::buildVisual()
 {
 	mVisualizer.drawVisualizer();
@@ -389,6 +615,18 @@ void HOL::UserInterface::buildMain()
 	ImGui::Text("OpenXR Session state: %s",
 				HOL::OpenXR::getOpenXrStateString(HOL::display::OpenXrInstanceState));
 
+	// Written to the working directory, play back with HandOfLesserHeadless --replay
+	auto& recording = HOL::display::Recording;
+	if (ImGui::Button(recording.active ? "Stop recording" : "Record hands"))
+	{
+		HOL::HandOfLesserCore::Current->setRecording(!recording.active);
+	}
+	if (recording.active)
+	{
+		ImGui::SameLine();
+		ImGui::Text("%llu frames", (unsigned long long)recording.frames);
+	}
+
 	//////////////////
 	// Mode
 	////////////////////
@@ -425,15 +663,24 @@ void HOL::UserInterface::buildMain()
 
 	ImGui::SeparatorText("General");
 	ImGui::InputInt("Prediction (ms)", &Config.general.MotionPredictionMS);
-	if (ImGui::InputInt("Update Interval (ms)", &Config.general.UpdateIntervalMS))
+	if (ImGui::InputFloat("Update rate (Hz)", &Config.general.UpdateRateHz, 10.f, 100.f, "%.1f"))
+	{
+		// Much slower than this and the hands are useless anyway
+		if (Config.general.UpdateRateHz < 1.f)
+		{
+			Config.general.UpdateRateHz = 1.f;
+		}
+	}
+	ImGui::InputFloat("Update phase (ms)", &Config.general.UpdatePhaseMS, 0.1f, 1.f, "%.2f");
+	if (ImGui::InputInt("Spin before deadline (us)", &Config.general.UpdateSpinUS))
 	{
-		// We probably shouldn't sleep for less than 1ms, and sleeping for
-		// negative time is probably undefined behavior.
-		if (Config.general.UpdateIntervalMS < 1)
+		if (Config.general.UpdateSpinUS < 0)
 		{
-			Config.general.UpdateIntervalMS = 1;
+			Config.general.UpdateSpinUS = 0;
 		}
 	}
+	ImGui::Checkbox("Runtime frame pacing", &Config.general.runtimeFramePacing);
+	ImGui::InputFloat("Runtime latency (ms)", &Config.general.runtimeLatencyMS, 1.f, 5.f, "%.1f");
 
 	ImGui::InputFloat("Linear Velocity multiplier",
 					  &Config.general.linearVelocityMultiplier,
@@ -453,6 +700,37 @@ void HOL::UserInterface::buildMain()
 	}
 
 	ImGui::Checkbox("Force inactive", &Config.general.forceInactive);
+	ImGui::Checkbox("Use shared memory transport", &Config.general.useSharedMemory);
+	ImGui::Checkbox("Compact pose encoding", &Config.general.compactPoseEncoding);
+	ImGui::Checkbox("Send skeleton", &Config.general.sendSkeleton);
+
+	ImGui::SeparatorText("Filtering");
+	ImGui::Checkbox("Smooth joints and palm", &Config.filter.enabled);
+	ImGui::InputFloat(
+		"Position min cutoff (Hz)", &Config.filter.positionMinCutoffHz, 0.1f, 1.f, "%.2f");
+	ImGui::InputFloat("Position beta", &Config.filter.positionBeta, 1.f, 5.f, "%.1f");
+	ImGui::InputFloat(
+		"Rotation min cutoff (Hz)", &Config.filter.rotationMinCutoffHz, 0.1f, 1.f, "%.2f");
+	ImGui::InputFloat("Rotation beta", &Config.filter.rotationBeta, 0.5f, 2.f, "%.1f");
+	ImGui::InputFloat(
+		"Derivative cutoff (Hz)", &Config.filter.derivativeCutoffHz, 0.1f, 1.f, "%.2f");
+	ImGui::InputFloat(
+		"Filtered velocity multiplier", &Config.filter.velocityMultiplier, 0.1f, 0.5f, "%.2f");
+
+	ImGui::SeparatorText("Change detection");
+	ImGui::Checkbox("Only send changes", &Config.transmit.changeDetection);
+	ImGui::InputInt("Keep-alive (ms)", &Config.transmit.keepAliveMS);
+	ImGui::InputFloat("Pose dead-band (mm)", &Config.transmit.poseDeadbandMM, 0.1f, 1.f, "%.2f");
+	ImGui::InputFloat(
+		"Pose dead-band (deg)", &Config.transmit.poseDeadbandDegrees, 0.05f, 0.5f, "%.2f");
+	ImGui::InputFloat(
+		"Skeleton dead-band (mm)", &Config.transmit.skeletonDeadbandMM, 0.1f, 1.f, "%.2f");
+	ImGui::InputFloat(
+		"SteamVR input dead-band", &Config.transmit.steamVRInputDeadband, 0.001f, 0.01f, "%.3f");
+	ImGui::InputFloat("OSC dead-band", &Config.transmit.oscDeadband, 0.001f, 0.01f, "%.3f");
+
+	buildMainLoopStatisticsDisplay();
+	buildPacketStatisticsDisplay();
 
 	/////////////////
 	// Offset inputs
@@ -690,6 +968,11 @@ void UserInterface::buildInterface()
 			buildVisual();
 			ImGui::EndTabItem();
 		}
+		if (ImGui::BeginTabItem("Metrics"))
+		{
+			buildMetrics();
+			ImGui::EndTabItem();
+		}
 		ImGui::EndTabBar();
 	}
 
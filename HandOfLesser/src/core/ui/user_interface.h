@@ -56,10 +56,18 @@ namespace HOL
 											  bool treatAsRadians = false,
 											  bool treatAsInt = false);
 		void buildSingleHandTransformDisplay(HOL::HandSide side);
+		void buildPacketStatisticsDisplay();
+		void buildMainLoopStatisticsDisplay();
+		void buildMetricsTables(const char* label, const HOL::MetricsSnapshot& snapshot);
 
 		void buildMain();
 		void buildVRChatOSCSettings();
 		void buildInput();
 		void buildVisual();
+		void buildMetrics();
+
+		// Ours is taken fresh every frame, the driver's comes back whenever it replies
+		HOL::MetricsSnapshot mAppMetrics;
+		int64_t mLastMetricsRequest = 0;
 	};
 } // namespace HOL
@@ -3,6 +3,8 @@
 #include "imgui.h"
 #include <HandOfLesserCommon.h>
 #include "src/core/settings_global.h"
+#include "src/hands/hand_frame.h"
+#include "src/openxr/xr_hand_utils.h"
 
 namespace HOL
 {
@@ -461,4 +463,44 @@ namespace HOL
 		queue->lines.push_back({start, end, color, width});
 	}
 
-} // namespace HOL
\ No newline at end of file
+	void Visualizer::drawHands(HOL::HandFrame& frame)
+	{
+		auto colorGrey = IM_COL32(155, 155, 155, 255);
+		auto colorWhite = IM_COL32(255, 255, 255, 255);
+
+		for (int i = 0; i < HandSide::HandSide_MAX; i++)
+		{
+			const HOL::HandJoints& joints = frame.hands[i].joints;
+
+			for (int j = 0; j < HOL::HAND_JOINT_COUNT; j++)
+			{
+				this->submitPoint(joints.position(j), colorGrey, 5);
+			}
+
+			// Also draw some white skeleton lines
+			{
+				for (int finger = 0; finger < FingerType_MAX; finger++)
+				{
+					XrHandJointEXT rootJoint = HOL::OpenXR::getRootJoint((FingerType)finger);
+					for (int j = 0; j < 4; j++)
+					{
+						this->submitLine(joints.position(rootJoint + j),
+										 joints.position(rootJoint + j + 1),
+										 colorWhite,
+										 2);
+					}
+				}
+			}
+
+			// This doesn't super go here but it's a good place for it.
+			if (i == HandSide::LeftHand && HOL::Config.visualizer.followLeftHand)
+			{
+				this->centerTo(joints.position(XR_HAND_JOINT_PALM_EXT));
+			}
+			else if (i == HandSide::RightHand && HOL::Config.visualizer.followRightHand)
+			{
+				this->centerTo(joints.position(XR_HAND_JOINT_PALM_EXT));
+			}
+		}
+	}
+} // namespace HOL
@@ -8,6 +8,8 @@
 
 namespace HOL
 {
+	struct HandFrame;
+
 	struct Point
 	{
 		Eigen::Vector3f position;
@@ -45,6 +47,9 @@ namespace HOL
 
 		void centerTo(Eigen::Vector3f center);
 
+		// UI thread, so only from a frame it has its own copy of
+		void drawHands(HOL::HandFrame& frame);
+
 		void swapOuterDrawQueue(); // At end of main loop frame
 		void clearDrawQueue();	// before drawing ( frame start )
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base_action.h"
+#include "src/util/hol_utils.h"
 
 namespace HOL
 {
@@ -11,6 +12,8 @@ namespace HOL
 
 	void BaseAction::evaluate(GestureData data)
 	{
+		HOL_TRACE_SCOPE("BaseAction::evaluate");
+
 		float triggerGesture = this->mTriggerGesture->evaluate(data);
 		float holdGesture = triggerGesture;
 
@@ -52,7 +55,7 @@ namespace HOL
 				}
 
 				mDelayedDown = true;
-				this->mDownTime = std::chrono::steady_clock::now();
+				this->mDownTime = HOL::pipelineNow();
 			}
 
 			// Block state update until min time
@@ -74,7 +77,7 @@ namespace HOL
 				if (!mDelayedUp)
 				{
 					mDelayedUp = this->mActionData.isDown; // Only if fully down
-					this->mUpTime = std::chrono::steady_clock::now();
+					this->mUpTime = HOL::pipelineNow();
 				}
 
 				// Block state update until min time
@@ -114,6 +117,12 @@ namespace HOL
 		mActionData.isTouch
 			= triggerGesture > this->mParameters.touchThreshold || mActionData.isDown;
 
+		static HOL::MetricCounter* activations = HOL::getMetrics().getCounter("action_activations");
+		if (this->mActionData.onDown)
+		{
+			activations->add();
+		}
+
 		this->onEvaluate(data, this->mActionData);
 	}
 
@@ -146,13 +155,13 @@ namespace HOL
 
 	std::chrono::milliseconds BaseAction::timeSinceDown()
 	{
-		auto currentTime = std::chrono::steady_clock::now();
+		auto currentTime = HOL::pipelineNow();
 		return std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - mDownTime);
 	}
 
 	std::chrono::milliseconds BaseAction::timeSinceUp()
 	{
-		auto currentTime = std::chrono::steady_clock::now();
+		auto currentTime = HOL::pipelineNow();
 		return std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - mUpTime);
 	}
 
@@ -4,7 +4,7 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include <HandOfLesserCommon.h>
-#include "src/openxr/XrUtils.h"
+#include "src/openxr/xr_conversion.h"
 
 namespace HOL
 {
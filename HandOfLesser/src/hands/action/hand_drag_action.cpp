@@ -13,8 +13,8 @@ namespace HOL
 	{
 		if (actionData.onDown || actionData.isDown)
 		{
-			Eigen::Vector3f currentPos = OpenXR::toEigenVector(
-				gestureData.joints[this->mHandSide][this->mTargetJoint].pose.position);
+			const HandJoints& joints = *gestureData.joints[this->mHandSide];
+			Eigen::Vector3f currentPos = joints.position(this->mTargetJoint);
 
 			if (actionData.onDown)
 			{
@@ -27,8 +27,7 @@ namespace HOL
 
 				// We don't have access to HMD position in VD, so use hand orientation as reference
 				// instead
-				Eigen::Quaternionf currentOrientation = OpenXR::toEigenQuaternion(
-					gestureData.joints[this->mHandSide][this->mTargetJoint].pose.orientation);
+				Eigen::Quaternionf currentOrientation = joints.orientation(this->mTargetJoint);
 
 				diff = currentOrientation.inverse() * diff;
 
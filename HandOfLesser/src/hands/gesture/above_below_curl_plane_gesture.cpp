@@ -4,7 +4,6 @@
 #include <Eigen/Geometry>
 #include "src/openxr/xr_hand_utils.h"
 #include "above_below_curl_plane_gesture.h"
-#include "src/core/ui/user_interface.h"
 
 using namespace HOL::OpenXR;
 
@@ -13,25 +12,17 @@ namespace HOL::Gesture
 	float AboveBelowCurlPlaneGesture::Gesture::evaluateInternal(GestureData data)
 	{
 		// The plane is defined by the X axis of the palm, and the vector between the knucle
-		// and the tip of the finger.
-		auto planeKnuckleJoint
-			= getJointPosition(data.joints[this->parameters.side],
-							   getFirstFingerJoint(this->parameters.planeFinger));
-		auto planeTipJoint = getJointPosition(data.joints[this->parameters.side],
-							   (XrHandJointEXT)(getFingerTip(this->parameters.planeFinger)));
+		// and the tip of the finger. The same plane gets checked against every other finger,
+		// so it comes out of the cache.
+		const HandJoints& joints = *data.joints[this->parameters.side];
+		HandFeatureCache& features = *data.features[this->parameters.side];
+		const Eigen::Vector3f& planeNormal
+			= features.getCurlPlaneNormal(this->parameters.planeFinger);
 
-		auto palmOrientation = getJointOrientation(data.joints[this->parameters.side],
-												   XrHandJointEXT::XR_HAND_JOINT_PALM_EXT);
-
-		// Palm X and knucke-to-tip crossed to get plane orientation
-		Eigen::Vector3f palmX = palmOrientation * Eigen::Vector3f(1, 0, 0);
-
-		Eigen::Vector3f planeNormal = palmX.cross(planeTipJoint - planeKnuckleJoint);
-		planeNormal.normalize();
+		auto planeTipJoint = joints.position(getFingerTip(this->parameters.planeFinger));
 
 		// dot product of normal and vector from plane tip to other tip decide over/under.
-		auto otherTipJoint = getJointPosition(data.joints[this->parameters.side],
-											  getFingerTip(this->parameters.otherFinger));
+		auto otherTipJoint = joints.position(getFingerTip(this->parameters.otherFinger));
 
 		Eigen::Vector3f otherVector = otherTipJoint - planeTipJoint;
 
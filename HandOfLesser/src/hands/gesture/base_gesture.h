@@ -1,21 +1,21 @@
 #pragma once
 
-#include <d3d11.h> // Why do you need this??
-#include <openxr/openxr_platform.h>
-#include <openxr/openxr.hpp>
+#include <openxr/openxr.h>
 #include <vector>
 #include <functional>
 #include <HandOfLesserCommon.h>
 #include <memory>
 #include <src/hands/hand_pose.h>
+#include <src/hands/hand_features.h>
 
 namespace HOL::Gesture
 {
 	struct GestureData
 	{
-		XrHandJointLocationEXT* joints[HandSide::HandSide_MAX];
+		const HandJoints* joints[HandSide::HandSide_MAX];
 		XrHandTrackingAimStateFB* aimState[HandSide::HandSide_MAX];
 		HandPose* handPose[HandSide::HandSide_MAX];
+		HandFeatureCache* features[HandSide::HandSide_MAX];
 		XrPosef HMDPose;
 	};
 
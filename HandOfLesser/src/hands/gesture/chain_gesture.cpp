@@ -3,7 +3,6 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include "src/openxr/xr_hand_utils.h"
-#include "src/core/ui/user_interface.h"
 #include "chain_gesture.h"
 #include "src/util/hol_utils.h"
 
@@ -13,8 +12,6 @@ namespace HOL::Gesture
 {
 	float ChainGesture::Gesture::evaluateInternal(GestureData data)
 	{
-		// printf("Evaluate\n");
-
 		if (this->mCurrentGestureIndex > this->mChainedGestures.size())
 		{
 			printf("index Out of range\n");
@@ -34,8 +31,6 @@ namespace HOL::Gesture
 			return 0;
 		}
 
-		// printf("Current Value: %.3f", curreGestureValue);
-
 		// // We're on the final gesture
 		if (this->mCurrentGestureIndex == this->mChainedGestures.size() - 1)
 		{
@@ -64,10 +59,13 @@ namespace HOL::Gesture
 			{
 
 				this->mCurrentGestureIndex++;
-				this->mLastActivation = std::chrono::steady_clock::now();
+				this->mLastActivation = HOL::pipelineNow();
 				return 0;
 			}
 		}
+
+		// Somewhere in the middle of the chain
+		return 0;
 	}
 
 	void ChainGesture::Gesture::addGesture(std::shared_ptr<BaseGesture::Gesture> gesture)
@@ -8,37 +8,33 @@ namespace HOL::Gesture::FingerCurlGesture
 {
 	float Gesture::evaluateInternal(GestureData data)
 	{
-		/*
-		printf("Curl: %.3f, %.3f, %.3f, %.3f\n",
-			data.handPose[this->mSide]->fingers[FingerType::FingerIndex].getCurlSumWithoutDistal(),
-			   data.handPose[this->mSide]->fingers[FingerType::FingerMiddle].getCurlSumWithoutDistal(),
-			   data.handPose[this->mSide]->fingers[FingerType::FingerRing].getCurlSumWithoutDistal(),
-			   data.handPose[this->mSide]->fingers[FingerType::FingerLittle].getCurlSumWithoutDistal()
-		);
-		*/
-
 		float val = 0;
 		int count = 0;
-		if (this->parameters.first)
-		{
-			val += data.handPose[this->parameters.side]
-					   ->fingers[this->parameters.finger]
-					   .bend[FingerBendType::CurlFirst];
-			count++;
-		}
-		if (this->parameters.second)
+		const FingerBend& bend
+			= data.handPose[this->parameters.side]->fingers[this->parameters.finger];
+		if (this->parameters.first && this->parameters.second && this->parameters.third)
 		{
-			val += data.handPose[this->parameters.side]
-					   ->fingers[this->parameters.finger]
-					   .bend[FingerBendType::CurlSecond];
-			count++;
+			// Same sum as below, but other gestures may already have asked for it
+			val = data.features[this->parameters.side]->getCurlSum(this->parameters.finger);
+			count = 3;
 		}
-		if (this->parameters.third)
+		else
 		{
-			val += data.handPose[this->parameters.side]
-					   ->fingers[this->parameters.finger]
-					   .bend[FingerBendType::CurlThird];
-			count++;
+			if (this->parameters.first)
+			{
+				val += bend.bend[FingerBendType::CurlFirst];
+				count++;
+			}
+			if (this->parameters.second)
+			{
+				val += bend.bend[FingerBendType::CurlSecond];
+				count++;
+			}
+			if (this->parameters.third)
+			{
+				val += bend.bend[FingerBendType::CurlThird];
+				count++;
+			}
 		}
 
 		if (count <= 0)
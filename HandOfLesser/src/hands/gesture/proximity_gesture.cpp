@@ -8,12 +8,18 @@ namespace HOL::Gesture
 {
 	float ProximityGesture::evaluateInternal(GestureData data)
 	{
-		auto pos1 = OpenXR::getJointPosition(data.joints[this->mSide1], this->mJoint1);
-		auto pos2 = OpenXR::getJointPosition(data.joints[this->mSide2], this->mJoint2);
-
-		auto vectorBetween = pos1 - pos2;
-
-		float distance = vectorBetween.norm();
+		float distance;
+		if (this->mBothTips && this->mSide1 == this->mSide2)
+		{
+			// Every pinch on the hand asks for these, only worked out once per frame
+			distance = data.features[this->mSide1]->getTipDistance(this->mFinger1, this->mFinger2);
+		}
+		else
+		{
+			auto pos1 = data.joints[this->mSide1]->position(this->mJoint1);
+			auto pos2 = data.joints[this->mSide2]->position(this->mJoint2);
+			distance = (pos1 - pos2).norm();
+		}
 
 		distance -= this->mMinDistance;
 		distance = std::clamp(distance, 0.0f, this->mMaxDistance);
@@ -33,6 +39,10 @@ namespace HOL::Gesture
 		auto joint1 = OpenXR::getFingerTip(fingerTip1);
 		auto joint2 = OpenXR::getFingerTip(fingerTip2);
 		setup(joint1, side1, joint2, side2, minDistance, maxDistance);
+
+		this->mBothTips = true;
+		this->mFinger1 = fingerTip1;
+		this->mFinger2 = fingerTip2;
 	}
 
 	void ProximityGesture::setup(XrHandJointEXT joint1,
@@ -50,13 +60,12 @@ namespace HOL::Gesture
 		this->mSide2 = side2;
 		this->mMinDistance = minDistance;
 		this->mMaxDistance = maxDistance;
+		this->mBothTips = false;
 	}
 
 	void ProximityGesture::setup(HOL::FingerType fingerTip1, HOL::HandSide side1)
 	{
-		auto joint1 = OpenXR::getFingerTip(fingerTip1);
-		auto joint2 = OpenXR::getFingerTip(HOL::FingerType::FingerThumb);
-		setup(joint1, side1, joint2, side1);
+		setup(fingerTip1, side1, HOL::FingerType::FingerThumb, side1);
 	}
 
 }
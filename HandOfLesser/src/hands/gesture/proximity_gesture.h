@@ -37,6 +37,11 @@ namespace HOL::Gesture
 		XrHandJointEXT mJoint2;
 		HOL::HandSide mSide2;
 
+		// Set up with fingers rather than joints, so the distance can come from HandFeatureCache
+		bool mBothTips = false;
+		HOL::FingerType mFinger1;
+		HOL::FingerType mFinger2;
+
 		float mMinDistance;
 		float mMaxDistance;
 
@@ -0,0 +1,113 @@
+#include "hand_features.h"
+#include "src/openxr/xr_hand_utils.h"
+
+using namespace HOL::OpenXR;
+
+namespace HOL
+{
+	void HandFeatureCache::update(const HandJoints* joints, const HandPose* handPose)
+	{
+		this->mJoints = joints;
+		this->mHandPose = handPose;
+		this->mGeneration++;
+	}
+
+	float HandFeatureCache::getTipDistance(FingerType finger1, FingerType finger2)
+	{
+		if (this->mTipDistancesGeneration != this->mGeneration)
+		{
+			this->updateTipDistances();
+		}
+
+		return this->mTipDistances[finger1][finger2];
+	}
+
+	const Eigen::Vector3f& HandFeatureCache::getPalmAxis(int axis)
+	{
+		if (this->mPalmAxesGeneration != this->mGeneration)
+		{
+			this->updatePalmAxes();
+		}
+
+		return this->mPalmAxes[axis];
+	}
+
+	const Eigen::Vector3f& HandFeatureCache::getCurlPlaneNormal(FingerType finger)
+	{
+		if (this->mCurlPlaneNormalsGeneration != this->mGeneration)
+		{
+			this->updateCurlPlaneNormals();
+		}
+
+		return this->mCurlPlaneNormals[finger];
+	}
+
+	float HandFeatureCache::getCurlSum(FingerType finger)
+	{
+		if (this->mCurlSumsGeneration != this->mGeneration)
+		{
+			this->updateCurlSums();
+		}
+
+		return this->mCurlSums[finger];
+	}
+
+	void HandFeatureCache::updateTipDistances()
+	{
+		// Symmetric, so only half of it is actually worked out
+		for (int i = 0; i < FingerType::FingerType_MAX; i++)
+		{
+			this->mTipDistances[i][i] = 0;
+
+			auto tip = this->mJoints->position(getFingerTip((FingerType)i));
+			for (int j = i + 1; j < FingerType::FingerType_MAX; j++)
+			{
+				auto otherTip = this->mJoints->position(getFingerTip((FingerType)j));
+				float distance = (tip - otherTip).norm();
+
+				this->mTipDistances[i][j] = distance;
+				this->mTipDistances[j][i] = distance;
+			}
+		}
+
+		this->mTipDistancesGeneration = this->mGeneration;
+	}
+
+	void HandFeatureCache::updatePalmAxes()
+	{
+		auto palmOrientation = this->mJoints->orientation(XR_HAND_JOINT_PALM_EXT);
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			this->mPalmAxes[axis] = palmOrientation * Eigen::Vector3f::Unit(axis);
+		}
+
+		this->mPalmAxesGeneration = this->mGeneration;
+	}
+
+	void HandFeatureCache::updateCurlPlaneNormals()
+	{
+		const Eigen::Vector3f& palmX = this->getPalmAxis(0);
+
+		for (int i = 0; i < FingerType::FingerType_MAX; i++)
+		{
+			FingerType finger = (FingerType)i;
+			auto knuckle = this->mJoints->position(getFirstFingerJoint(finger));
+			auto tip = this->mJoints->position(getFingerTip(finger));
+
+			this->mCurlPlaneNormals[i] = palmX.cross(tip - knuckle).normalized();
+		}
+
+		this->mCurlPlaneNormalsGeneration = this->mGeneration;
+	}
+
+	void HandFeatureCache::updateCurlSums()
+	{
+		for (int i = 0; i < FingerType::FingerType_MAX; i++)
+		{
+			this->mCurlSums[i] = this->mHandPose->fingers[i].getCurlSum();
+		}
+
+		this->mCurlSumsGeneration = this->mGeneration;
+	}
+} // namespace HOL
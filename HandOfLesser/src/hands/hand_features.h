@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <HandOfLesserCommon.h>
+#include "src/hands/hand_pose.h"
+
+namespace HOL
+{
+	// Geometry several gestures want out of the same hand every frame. Nothing is worked out
+	// until something asks for it, and then only once per frame however many gestures ask.
+	// Each group remembers the generation it was computed for, so update() just bumps the
+	// generation to mark the lot dirty.
+	class HandFeatureCache
+	{
+	public:
+		// Call once per frame before any gestures run. Both have to outlive the frame.
+		void update(const HandJoints* joints, const HandPose* handPose);
+
+		uint64_t getGeneration() const
+		{
+			return this->mGeneration;
+		}
+
+		// Distance between two fingertips, 0 for the same finger
+		float getTipDistance(FingerType finger1, FingerType finger2);
+
+		// Palm orientation as vectors, 0 for X, 1 for Y, 2 for Z
+		const Eigen::Vector3f& getPalmAxis(int axis);
+
+		// Normal of the plane through palm X and the finger's knuckle-to-tip vector,
+		// what AboveBelowCurlPlaneGesture checks the other fingertips against.
+		const Eigen::Vector3f& getCurlPlaneNormal(FingerType finger);
+
+		// FingerBend::getCurlSum()
+		float getCurlSum(FingerType finger);
+
+	private:
+		void updateTipDistances();
+		void updatePalmAxes();
+		void updateCurlPlaneNormals();
+		void updateCurlSums();
+
+		const HandJoints* mJoints = nullptr;
+		const HandPose* mHandPose = nullptr;
+
+		// Starts at 1 on the first update, so nothing is ever clean against 0
+		uint64_t mGeneration = 0;
+		uint64_t mTipDistancesGeneration = 0;
+		uint64_t mPalmAxesGeneration = 0;
+		uint64_t mCurlPlaneNormalsGeneration = 0;
+		uint64_t mCurlSumsGeneration = 0;
+
+		float mTipDistances[FingerType::FingerType_MAX][FingerType::FingerType_MAX];
+		Eigen::Vector3f mPalmAxes[3];
+		Eigen::Vector3f mCurlPlaneNormals[FingerType::FingerType_MAX];
+		float mCurlSums[FingerType::FingerType_MAX];
+	};
+} // namespace HOL
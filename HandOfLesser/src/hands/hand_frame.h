@@ -0,0 +1,35 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <cstdint>
+#include <HandOfLesserCommon.h>
+#include "src/hands/hand_pose.h"
+#include "src/hands/simple_gesture.h"
+
+namespace HOL
+{
+	struct HandFrameHand
+	{
+		HandPose handPose;
+		SimpleGesture::SimpleGestureState simpleGestures[SimpleGesture::SIMPLE_GESTURE_MAX];
+		XrHandTrackingAimStateFB aimState{XR_TYPE_HAND_TRACKING_AIM_STATE_FB};
+		HandJoints joints;
+		XrHandJointVelocityEXT velocities[XR_HAND_JOINT_COUNT_EXT];
+
+		// Only for display
+		HOL::PoseLocation rawPalmLocation;
+		Eigen::Vector3f controllerTranslationOffset = Eigen::Vector3f::Zero();
+		Eigen::Vector3f controllerOrientationOffset = Eigen::Vector3f::Zero();
+	};
+
+	// Everything the tracking stage sampled for one main loop iteration.
+	// Published through a SnapshotSlot, every consumer (gestures, OSC, UI) copies out its own
+	// and can take as long as it likes with it. Nothing else reads OpenXRHand off the main loop.
+	struct HandFrame
+	{
+		uint64_t sequence = 0;
+		XrTime time = 0;		  // What the hands were predicted for
+		int64_t captureTime = 0; // steadyNanoseconds() when we started sampling
+		HandFrameHand hands[HandSide::HandSide_MAX];
+	};
+} // namespace HOL
@@ -1,5 +1,7 @@
 #include "steamvr_bool_input.h"
 #include "src/steamvr/steamvr_input.h"
+#include "src/core/settings_global.h"
+#include "src/util/hol_utils.h"
 #include <cstdio>
 
 namespace HOL
@@ -15,11 +17,14 @@ namespace HOL
 	void SteamVRBoolInput::submit(float inputData)
 	{
 		bool newValue = inputData >= 1.f;
-		// don't send if same
-		if (newValue != this->mLastValue)
+		int64_t now = HOL::pipelineNanoseconds();
+
+		// don't send if same, unless it's been a while
+		if (this->mChannel.changed(
+				newValue ? 1.f : 0.f, 0.f, HOL::settings::getKeepAliveNanoseconds(), now))
 		{
 			SteamVR::SteamVRInput::Current->submitBoolean(mSide, mInput, newValue);
-			this->mLastValue = newValue;
+			this->mChannel.sent(newValue ? 1.f : 0.f, now);
 		}
 
 	}
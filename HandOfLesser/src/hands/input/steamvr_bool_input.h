@@ -25,6 +25,6 @@ namespace HOL
 		// This stuff should be moved to a common VRC input thing
 		std::string mInput = "";
 		HOL::HandSide mSide = HOL::HandSide::LeftHand;
-		bool mLastValue = false;	// Ideally should be undefined, but good enough.
+		HOL::DeadbandChannel mChannel;
 	};
 } // namespace HOL
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "steamvr_float_input.h"
 #include "src/steamvr/steamvr_input.h"
+#include "src/core/settings_global.h"
+#include "src/util/hol_utils.h"
 #include <cstdio>
 
 namespace HOL
@@ -14,11 +16,18 @@ namespace HOL
 
 	void SteamVRFloatInput::submit(float inputData)
 	{
-		// don't send if same
-		if (inputData != this->mLastValue)
+		// don't send if about the same, unless it's been a while.
+		// Ends of the range always go through, a trigger left at 0.003 counts as touched.
+		int64_t now = HOL::pipelineNanoseconds();
+		float threshold = (inputData == 0.f || inputData == 1.f)
+							  ? 0.f
+							  : Config.transmit.steamVRInputDeadband;
+
+		if (this->mChannel.changed(
+				inputData, threshold, HOL::settings::getKeepAliveNanoseconds(), now))
 		{
 			SteamVR::SteamVRInput::Current->submitFloat(mSide, mInput, inputData);
-			this->mLastValue = inputData;
+			this->mChannel.sent(inputData, now);
 		}
 
 	}
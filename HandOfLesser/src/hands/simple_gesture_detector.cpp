@@ -44,6 +44,10 @@ namespace HOL::SimpleGesture
 					== XR_HAND_TRACKING_AIM_SYSTEM_GESTURE_BIT_FB,
 			};
 		}
+
+		default:
+			// IndexMiddlePinkyGrip was never implemented
+			return {};
 		}
 	}
 
@@ -1,12 +1,9 @@
 #include "HandTracking.h"
-#include "HandTrackingInterface.h"
 #include <HandOfLesserCommon.h>
 #include "src/hands/simple_gesture_detector.h"
 #include <algorithm>
 #include <iterator>
 #include <iostream>
-#include "src/core/ui/user_interface.h"
-#include "XrUtils.h"
 #include "src/core/settings_global.h"
 #include "xr_hand_utils.h"
 
@@ -26,17 +23,16 @@ using namespace HOL::OpenXR;
 using namespace HOL::SimpleGesture;
 using namespace std::chrono_literals;
 
-void HandTracking::init(xr::UniqueDynamicInstance& instance, xr::UniqueDynamicSession& session)
+void HandTracking::init()
 {
-	HandTrackingInterface::init(instance);
-	this->initHands(session);
+	this->initHands();
 	initGestures();
 }
 
-void HandTracking::initHands(xr::UniqueDynamicSession& session)
+void HandTracking::initHands()
 {
-	this->mLeftHand.init(session, HOL::LeftHand);
-	this->mRightHand.init(session, HOL::RightHand);
+	this->mLeftHand.init(HOL::LeftHand);
+	this->mRightHand.init(HOL::RightHand);
 }
 
 void HOL::OpenXR::HandTracking::initGestures()
@@ -253,16 +249,64 @@ void HOL::OpenXR::HandTracking::initGestures()
 	}
 }
 
-void HandTracking::updateHands(xr::UniqueDynamicSpace& space, XrTime time)
+void HandTracking::updateHands(HOL::HandSource& source, XrTime time)
 {
-	this->mLeftHand.updateJointLocations(space, time);
-	this->mRightHand.updateJointLocations(space, time);
+	HOL_TRACE_SCOPE("HandTracking::updateHands");
+
+	this->mLeftHand.updateJointLocations(source, time);
+	this->mRightHand.updateJointLocations(source, time);
+	this->calculateCurlSplay();
+
+	// Just the aim state, cheap enough to stay with the tracking
+	updateSimpleGestures();
 }
 
-void HandTracking::updateInputs()
+// Every joint pair of both hands through the SIMD kernel in one go
+void HandTracking::calculateCurlSplay()
 {
-	updateSimpleGestures();
-	updateGestures();
+	this->mFingerBatch.count = 0;
+	int leftFirst = this->mLeftHand.loadCurlSplay(this->mFingerBatch);
+	int rightFirst = this->mRightHand.loadCurlSplay(this->mFingerBatch);
+
+	if (this->mFingerBatch.count == 0)
+	{
+		return;
+	}
+
+	HOL::computeCurlSplayBatch(this->mFingerBatch);
+
+	if (leftFirst >= 0)
+	{
+		this->mLeftHand.storeCurlSplay(this->mFingerBatch, leftFirst);
+	}
+
+	if (rightFirst >= 0)
+	{
+		this->mRightHand.storeCurlSplay(this->mFingerBatch, rightFirst);
+	}
+}
+
+void HandTracking::getFrame(HOL::HandFrame& frame)
+{
+	for (int i = 0; i < HandSide::HandSide_MAX; i++)
+	{
+		OpenXRHand& hand = getHand((HandSide)i);
+		HOL::HandFrameHand& frameHand = frame.hands[i];
+
+		frameHand.handPose = hand.handPose;
+		frameHand.aimState = hand.aimState;
+		std::copy(std::begin(hand.simpleGestures),
+				  std::end(hand.simpleGestures),
+				  std::begin(frameHand.simpleGestures));
+		frameHand.joints = hand.joints;
+		std::copy(hand.getLastJointVelocities(),
+				  hand.getLastJointVelocities() + XR_HAND_JOINT_COUNT_EXT,
+				  frameHand.velocities);
+
+		frameHand.rawPalmLocation = hand.rawPalmLocation;
+		frameHand.controllerTranslationOffset = hand.controllerTranslationOffset;
+		frameHand.controllerOrientationOffset = hand.controllerOrientationOffset;
+	}
 }
 
 void HandTracking::updateSimpleGestures()
@@ -273,18 +317,21 @@ void HandTracking::updateSimpleGestures()
 
 static bool firstRun = true;
 
-void HOL::OpenXR::HandTracking::updateGestures()
+void HOL::OpenXR::HandTracking::updateGestures(HOL::HandFrame& frame)
 {
-	// printf("################\n");
+	HOL_TRACE_SCOPE("HandTracking::updateGestures");
 
 	HOL::Gesture::GestureData data;
 	for (int i = 0; i < HandSide::HandSide_MAX; i++)
 	{
-		OpenXRHand& hand = getHand((HandSide)i);
+		HOL::HandFrameHand& hand = frame.hands[i];
 
 		data.handPose[i] = &hand.handPose;
 		data.aimState[i] = &hand.aimState;
-		data.joints[i] = hand.getLastJointLocations();
+		data.joints[i] = &hand.joints;
+
+		this->mFeatures[i].update(&hand.joints, &hand.handPose);
+		data.features[i] = &this->mFeatures[i];
 	}
 
 	// TODO: HMD pose
@@ -314,7 +361,8 @@ HOL::HandTransformPacket HandTracking::getTransformPacket(HOL::HandSide side)
 {
 	OpenXRHand hand = getHand(side);
 
-	HOL::HandTransformPacket packet;
+	// Value initialized so the padding is zeroed too, it goes out as is
+	HOL::HandTransformPacket packet{};
 
 	packet.active = hand.handPose.active;
 	packet.valid = hand.handPose.poseValid;
@@ -326,6 +374,32 @@ HOL::HandTransformPacket HandTracking::getTransformPacket(HOL::HandSide side)
 	return packet;
 }
 
+HOL::HandSkeletonPacket HandTracking::getSkeletonPacket(HOL::HandSide side)
+{
+	static_assert(HOL::HAND_SKELETON_JOINT_COUNT == HOL::HAND_JOINT_COUNT);
+
+	OpenXRHand& hand = getHand(side);
+	const HOL::HandJoints& joints = hand.joints;
+
+	// Invalid joints still go out, zero them rather than send whatever was on the stack
+	HOL::HandSkeletonPacket packet{};
+	packet.side = side;
+
+	for (int i = 0; i < HOL::HAND_JOINT_COUNT; i++)
+	{
+		if (joints.isValid(i))
+		{
+			HOL::setSkeletonJoint(packet, i, joints.position(i), joints.orientation(i));
+		}
+	}
+
+	// Same palm the pose packet was built from, so the two line up in the driver
+	HOL::makeSkeletonPalmRelative(
+		packet, hand.handPose.palmLocation.position, hand.handPose.palmLocation.orientation);
+
+	return packet;
+}
+
 HOL::ControllerInputPacket HandTracking::getInputPacket(HOL::HandSide side)
 {
 	// todo we're replacing all of this
@@ -396,52 +470,3 @@ HOL::HandPose& HandTracking::getHandPose(HOL::HandSide side)
 	OpenXRHand& hand = (side == HOL::LeftHand) ? this->mLeftHand : this->mRightHand;
 	return hand.handPose;
 }
-
-void HOL::OpenXR::HandTracking::drawHands()
-{
-	auto colorGrey = IM_COL32(155, 155, 155, 255);
-	auto colorWhite = IM_COL32(255, 255, 255, 255);
-	auto vis = HOL::UserInterface::Current->getVisualizer();
-
-	for (int i = 0; i < HandSide::HandSide_MAX; i++)
-	{
-		XrHandJointLocationEXT* jointLocations = this->getHand((HandSide)i).getLastJointLocations();
-
-		for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; j++)
-		{
-			XrHandJointLocationEXT& joint = jointLocations[j];
-
-			// WIll replace this later anyway so nevermind wasteful conversion
-			vis->submitPoint(OpenXR::toEigenVector(joint.pose.position), colorGrey, 5);
-		}
-
-		// Also draw some white skeleton lines
-		{
-			for (int finger = 0; finger < FingerType_MAX; finger++)
-			{
-				XrHandJointEXT rootJoint = OpenXR::getRootJoint((FingerType)finger);
-				for (int j = 0; j < 4; j++)
-				{
-					XrHandJointLocationEXT& joint = jointLocations[rootJoint + j];
-					XrHandJointLocationEXT& nextJoint = jointLocations[rootJoint + j + 1];
-					vis->submitLine(OpenXR::toEigenVector(joint.pose.position),
-									OpenXR::toEigenVector(nextJoint.pose.position),
-									colorWhite,
-									2);
-				}
-			}
-		}
-
-		XrHandJointLocationEXT& palm = jointLocations[XR_HAND_JOINT_PALM_EXT];
-
-		// This doesn't super go here but it's a good place for it.
-		if (i == HandSide::LeftHand && HOL::Config.visualizer.followLeftHand)
-		{
-			vis->centerTo(OpenXR::toEigenVector(palm.pose.position));
-		}
-		else if (i == HandSide::RightHand && HOL::Config.visualizer.followRightHand)
-		{
-			vis->centerTo(OpenXR::toEigenVector(palm.pose.position));
-		}
-	}
-}
@@ -1,36 +1,42 @@
 #pragma once
 
-#include <d3d11.h> // Why do you need this??
 #include <memory>
 #include "openxr_hand.h"
 #include "src/hands/gesture/open_hand_pinch_gesture.h"
 #include "src/hands/action/hand_drag_action.h"
 
-#include "src/vrchat/vrchat_input.h";
+#include "src/vrchat/vrchat_input.h"
 
 #include "src/hands/gesture/combo_gesture.h"
+#include "src/hands/hand_frame.h"
 
 namespace HOL::OpenXR
 {
 	class HandTracking
 	{
 	public:
-		void init(xr::UniqueDynamicInstance& instance, xr::UniqueDynamicSession& session);
-		void updateHands(xr::UniqueDynamicSpace& space, XrTime time);
-		void updateInputs();
+		void init();
+		void updateHands(HOL::HandSource& source, XrTime time);
+		void getFrame(HOL::HandFrame& frame);
+
+		// Gesture stage only, actions aren't touched anywhere else
+		void updateGestures(HOL::HandFrame& frame);
+
 		HOL::HandTransformPacket getTransformPacket(HOL::HandSide side);
+		HOL::HandSkeletonPacket getSkeletonPacket(HOL::HandSide side);
 		HOL::ControllerInputPacket getInputPacket(HOL::HandSide side);
 		HOL::HandPose& getHandPose(HOL::HandSide side);
-		void drawHands();
 
 	private:
-		void initHands(xr::UniqueDynamicSession& session);
+		void initHands();
 		void initGestures();
 		void updateSimpleGestures();
-		void updateGestures();
+		void calculateCurlSplay();
 		OpenXRHand& getHand(HOL::HandSide side);
 		OpenXRHand mLeftHand;
 		OpenXRHand mRightHand;
+		HOL::FingerBatch mFingerBatch;
+		HOL::HandFeatureCache mFeatures[HandSide::HandSide_MAX];
 
 		std::vector<std::shared_ptr<BaseAction>> mActions;
 	};
@@ -28,29 +28,6 @@ namespace HOL::OpenXR
 		return true;
 	}
 
-	Eigen::Vector3f toEigenVector(const XrVector3f& xrVector)
-	{
-		return Eigen::Vector3f(xrVector.x, xrVector.y, xrVector.z);
-	}
-
-	Eigen::Quaternionf toEigenQuaternion(const XrQuaternionf& xrQuat)
-	{
-		return Eigen::Quaternionf(xrQuat.w, xrQuat.x, xrQuat.y, xrQuat.z);
-	}
-
-	XrHandEXT toOpenXRHandSide(HOL::HandSide side)
-	{
-		switch (side)
-		{
-			case HOL::LeftHand:
-				return XrHandEXT::XR_HAND_LEFT_EXT;
-			case HOL::RightHand:
-				return XrHandEXT::XR_HAND_RIGHT_EXT;
-			default:
-				return XrHandEXT::XR_HAND_MAX_ENUM_EXT; // Just don't do this
-		}
-	}
-
 	std::string getActiveOpenXRRuntimePath(int majorApiVersion)
 	{
 		std::string runtimePath = "Unknown";
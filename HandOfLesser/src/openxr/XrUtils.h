@@ -8,6 +8,7 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include <HandOfLesserCommon.h>
+#include "xr_conversion.h"
 
 namespace HOL::OpenXR
 {
@@ -47,12 +48,6 @@ namespace HOL::OpenXR
 
 	bool handleXR(std::string what, XrResult res);
 
-	Eigen::Vector3f toEigenVector(const XrVector3f& xrVector);
-
-	Eigen::Quaternionf toEigenQuaternion(const XrQuaternionf& xrQuat);
-
-	XrHandEXT toOpenXRHandSide(HOL::HandSide side);
-
 	std::string getActiveOpenXRRuntimePath(int majorApiVersion);
 	std::string getActiveOpenXRRuntimeName(int majorApiVersion);
 } // namespace HOL::OpenXR
\ No newline at end of file
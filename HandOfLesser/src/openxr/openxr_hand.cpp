@@ -1,10 +1,7 @@
 #include "openxr_hand.h"
-#include "XrUtils.h"
 #include "xr_hand_utils.h"
 #include <HandOfLesserCommon.h>
-#include "HandTrackingInterface.h"
 #include "src/core/settings_global.h"
-#include "src/core/ui/display_global.h"
 #include <iostream>
 #include <utility>
 
@@ -14,124 +11,199 @@
 using namespace HOL;
 using namespace HOL::OpenXR;
 
-void OpenXRHand::init(xr::UniqueDynamicSession& session, HOL::HandSide side)
+void OpenXRHand::init(HOL::HandSide side)
 {
 	this->mSide = side;
-	HandTrackingInterface::createHandTracker(session, toOpenXRHandSide(side), this->mHandTracker);
 }
 
-XrHandJointLocationEXT* OpenXRHand::getLastJointLocations()
+XrHandJointVelocityEXT* OpenXRHand::getLastJointVelocities()
 {
-	return this->mJointLocations;
+	return this->mSample.velocities;
 }
 
 void OpenXRHand::calculateCurlSplay()
 {
-	if (!this->handPose.poseTracked)
+	HOL::FingerBatch batch;
+	this->mCurlSplayPending = true;
+
+	int first = this->loadCurlSplay(batch);
+	if (first >= 0)
+	{
+		HOL::computeCurlSplayBatch(batch);
+		this->storeCurlSplay(batch, first);
+	}
+}
+
+// What the first joint of each finger curls and splays against
+Eigen::Quaternionf OpenXRHand::getFingerRootOrientation(FingerType finger)
+{
+	if (finger != FingerType::FingerThumb)
+	{
+		// For the sake of the humanoid rig, using the palm as a reference is better
+		return this->joints.orientation(XrHandJointEXT::XR_HAND_JOINT_PALM_EXT);
+	}
+
+	// The root bone for the thumb would be the bone before the metacarpal,
+	// which doesn't exist; the next bone is the wrist.
+	// Use wrist orientation, but offset by user input to calibrate correctly.
+	Eigen::Quaternionf wristOrientation = this->joints.orientation(OpenXR::getRootJoint(finger));
+	Eigen::Vector3f rawOffset = Config.fingerBend.ThumbAxisOffset;
+	if (this->mSide == HandSide::RightHand)
+	{
+		// Input values are for left hand
+		rawOffset = flipHandRotation(rawOffset);
+	}
+
+	// Z axis is probably all you want to adjust
+	Eigen::Quaternionf baseOffset
+		= HOL::quaternionFromEulerAnglesDegrees(rawOffset.x(), rawOffset.y(), rawOffset.z());
+
+	return wristOrientation * (baseOffset);
+}
+
+int OpenXRHand::loadCurlSplay(HOL::FingerBatch& batch)
+{
+	bool pending = this->mCurlSplayPending;
+	this->mCurlSplayPending = false;
+
+	if (!pending || !this->handPose.poseTracked)
 	{
 		// Leave previous pose if hand not tracked
-		return;
+		return -1;
+	}
+
+	if (batch.count + HOL::FINGER_BATCH_HAND_PAIRS > HOL::FINGER_BATCH_PAIRS)
+	{
+		return -1;
 	}
 
-	const auto getJointOrientation = [&](XrHandJointEXT joint)
-	{ return toEigenQuaternion(this->mJointLocations[joint].pose.orientation); };
+	int first = batch.count;
 
-	const auto getJointPosition = [&](XrHandJointEXT joint)
-	{ return toEigenVector(this->mJointLocations[joint].pose.position); };
+	// Reuse array to store raw orientations of joints
+	Eigen::Quaternionf rawOrientation[4];
 
-	// Get the orientation of the 4 relevant joints for each finger
-	// the thumb has a special case
-	const auto getRawOrientation = [&](FingerType finger, Eigen::Quaternionf rawOrientationOut[])
+	// Each joint + next joint, starting from METACARPAL, 3 per finger
+	for (int i = 0; i < FingerType::FingerType_MAX; i++)
 	{
+		FingerType finger = (FingerType)i;
 		XrHandJointEXT rootJoint = OpenXR::getRootJoint(finger); // METACARPAL or wrist ( thumb )
 
 		// openxr joints are hierarchical, so we can +1 until we reach the tip of the finger
-		for (int i = 0; i < 4; i++)
+		rawOrientation[0] = this->getFingerRootOrientation(finger);
+		for (int j = 1; j < 4; j++)
 		{
-			rawOrientationOut[i] = getJointOrientation((XrHandJointEXT)(rootJoint + i));
+			rawOrientation[j] = this->joints.orientation((XrHandJointEXT)(rootJoint + j));
 		}
 
-		// The root bone for the thumb would be the bone before the metacarpal,
-		// which doesn't exist; the next bone is the wrist.
-		// Use wrist orientation, but offset by user input to calibrate correctly.
-		if (finger == FingerType::FingerThumb)
-		{
-			Eigen::Quaternionf wristOrientation = getJointOrientation(rootJoint);
-			Eigen::Vector3f rawOffset = Config.fingerBend.ThumbAxisOffset;
-			if (this->mSide == HandSide::RightHand)
-			{
-				// Input values are for left hand
-				rawOffset = flipHandRotation(rawOffset);
-			}
-
-			// Z axis is probably all you want to adjust
-			Eigen::Quaternionf baseOffset = HOL::quaternionFromEulerAnglesDegrees(
-				rawOffset.x(), rawOffset.y(), rawOffset.z());
-
-			rawOrientationOut[0] = wristOrientation * (baseOffset);
-		}
-		else
+		for (int j = 0; j < 3; j++)
 		{
-			// For the sake of the humanoid rig, using the palm as a reference is better
-			rawOrientationOut[0] = getJointOrientation(XrHandJointEXT::XR_HAND_JOINT_PALM_EXT);
+			batch.add(rawOrientation[j], rawOrientation[j + 1]);
 		}
-	};
+	}
 
-	// Reuse array to store raw orientations of joints
-	Eigen::Quaternionf rawOrientation[4];
+	return first;
+}
 
-	// For each finger
+void OpenXRHand::storeCurlSplay(const HOL::FingerBatch& batch, int first)
+{
 	for (int i = 0; i < FingerType::FingerType_MAX; i++)
 	{
 		FingerBend* bend = &this->handPose.fingers[i];
 		FingerType finger = (FingerType)i;
-		getRawOrientation(finger, rawOrientation);
+		int pair = first + i * 3;
 
-		// For each joint + next joint
 		for (int j = 0; j < 3; j++)
 		{
-			// Pass current joint, and the next joint, starting from METACARPAL.
-			bend->bend[j] = computeCurl(rawOrientation[j], rawOrientation[j + 1]);
-
 			// Curling inwards is negative, outwards positive, with 0 being a straight finger.
 			// this is a bit unintuitive, so let's flip it.
-			bend->bend[j] *= -1.0f;
+			bend->bend[j] = batch.curl[pair + j] * -1.0f;
 		}
 
 		// Between metacarpal and proximal. No flipping this.
-		bend->bend[FingerBendType::Splay] = computeSplay(rawOrientation[0], rawOrientation[1]);
+		bend->bend[FingerBendType::Splay] = batch.splay[pair];
 
 		if (Config.vrchat.useUnityHumanoidSplay)
 		{
 			// Special values for unity's broken humanoid rig
 			// Only splay is different
 			Eigen::Quaternionf palmRot
-				= getJointOrientation(XrHandJointEXT::XR_HAND_JOINT_PALM_EXT);
+				= this->joints.orientation(XrHandJointEXT::XR_HAND_JOINT_PALM_EXT);
 
 			if (finger == FingerType::FingerThumb)
 			{
-				palmRot = rawOrientation[0];
+				palmRot = this->getFingerRootOrientation(finger);
 			}
 
-			Eigen::Vector3f knucklePos = getJointPosition(OpenXR::getFirstFingerJoint(finger));
-			Eigen::Vector3f splayRefPos
-				= getJointPosition((XrHandJointEXT)(OpenXR::getFirstFingerJoint(finger) + 1));
+			XrHandJointEXT knuckle = OpenXR::getFirstFingerJoint(finger);
+			Eigen::Vector3f knucklePos = this->joints.position(knuckle);
+			Eigen::Vector3f splayRefPos = this->joints.position(knuckle + 1);
 
 			bend->setSplay(computeHumanoidSplay(palmRot, knucklePos, splayRefPos));
 		}
 	}
 }
 
-void OpenXRHand::updateJointLocations(xr::UniqueDynamicSpace& space, XrTime time)
+// Smooths the joints in place, and the palm the pose is built from. False if filtering is off.
+bool OpenXRHand::filterJoints(XrTime time, PoseLocation& palm)
 {
-	this->handPose.active = HandTrackingInterface::locateHandJoints(this->mHandTracker,
-																	space,
-																	time,
-																	this->mJointLocations,
-																	this->mJointVelocities,
-																	&this->aimState);
+	const HOL::settings::FilterSettings& settings = Config.filter;
+	if (!settings.enabled)
+	{
+		// Start from scratch whenever it's turned back on
+		this->mJointFilter.reset();
+		this->mPalmFilter.reset();
+		this->mLastFilterTime = 0;
+		return false;
+	}
+
+	// After a long gap it might as well be a different hand, and the filters start over
+	float deltaTime = 0;
+	if (this->mLastFilterTime > 0 && time - this->mLastFilterTime < 500000000)
+	{
+		deltaTime = (float)(time - this->mLastFilterTime) / 1e9f;
+	}
+	this->mLastFilterTime = time;
+
+	HOL::OneEuroParameters position{
+		settings.positionMinCutoffHz, settings.positionBeta, settings.derivativeCutoffHz};
+	HOL::OneEuroParameters rotation{
+		settings.rotationMinCutoffHz, settings.rotationBeta, settings.derivativeCutoffHz};
+
+	this->mJointFilter.filter(this->joints, deltaTime, position, rotation);
+	palm = this->mPalmFilter.filter(palm, deltaTime, position, rotation);
+
+	// The skeleton goes out relative to the palm pose, keep the palm joint in agreement
+	this->joints.setJointPose(XR_HAND_JOINT_PALM_EXT, palm.position, palm.orientation);
+	return true;
+}
+
+void OpenXRHand::repeatFilteredJoints()
+{
+	if (this->mLastFilterTime == 0)
+	{
+		return;
+	}
+
+	const PoseLocation& palm = this->mPalmFilter.getPose();
+	this->mJointFilter.repeat(this->joints);
+	this->joints.setJointPose(XR_HAND_JOINT_PALM_EXT, palm.position, palm.orientation);
+}
+
+void OpenXRHand::updateJointLocations(HOL::HandSource& source, XrTime time)
+{
+	static HOL::LatencyHistogram* locateTime = HOL::getMetrics().getHistogram("openxr_locate");
+	static HOL::MetricCounter* staleFrames = HOL::getMetrics().getCounter("stale_frames");
+
+	int64_t locateStart = HOL::steadyNanoseconds();
+	source.locateHand(this->mSide, time, this->mSample);
+	locateTime->record(HOL::steadyNanoseconds() - locateStart);
 
-	auto palmLocation = this->mJointLocations[XrHandJointEXT::XR_HAND_JOINT_PALM_EXT];
+	OpenXR::toHandJoints(this->mSample.joints, this->joints);
+
+	this->handPose.active = this->mSample.active;
+	this->aimState = this->mSample.aimState;
+
+	auto palmLocation = this->mSample.joints[XrHandJointEXT::XR_HAND_JOINT_PALM_EXT];
 
 	// Orientation is not going to be set without position for hand tracking.
 	this->handPose.poseValid = (palmLocation.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT)
@@ -152,8 +224,8 @@ void OpenXRHand::updateJointLocations(xr::UniqueDynamicSpace& space, XrTime time
 
 	if (this->handPose.poseValid)
 	{
-		Eigen::Vector3f newPalmPosition = toEigenVector(palmLocation.pose.position);
-		Eigen::Quaternionf newPalmOrientation = toEigenQuaternion(palmLocation.pose.orientation);
+		Eigen::Vector3f newPalmPosition = this->joints.position(XR_HAND_JOINT_PALM_EXT);
+		Eigen::Quaternionf newPalmOrientation = this->joints.orientation(XR_HAND_JOINT_PALM_EXT);
 
 		//////////////
 		// Staleness
@@ -163,6 +235,13 @@ void OpenXRHand::updateJointLocations(xr::UniqueDynamicSpace& space, XrTime time
 		// VDXR updates at intervals of 7-16ms, Airlink updates constantly.
 		// Prediction also does nothing for VDXR.
 		this->handPose.poseStale = this->mPrevRawPose.position.isApprox(newPalmPosition);
+		if (this->handPose.poseStale)
+		{
+			staleFrames->add();
+
+			// Otherwise the raw joints would flash up between filtered frames
+			this->repeatFilteredJoints();
+		}
 
 		if (!this->handPose.poseStale)
 		{
@@ -172,16 +251,27 @@ void OpenXRHand::updateJointLocations(xr::UniqueDynamicSpace& space, XrTime time
 			this->handPose.palmLocation.position = newPalmPosition;
 			this->handPose.palmLocation.orientation = newPalmOrientation;
 
-			auto palmVelocity = this->mJointVelocities[XrHandJointEXT::XR_HAND_JOINT_PALM_EXT];
-
-			this->handPose.palmVelocity.linearVelocity = toEigenVector(palmVelocity.linearVelocity);
-			this->handPose.palmVelocity.angularVelocity
-				= toEigenVector(palmVelocity.angularVelocity);
-
-			this->handPose.palmVelocity.linearVelocity
-				*= HOL::Config.general.linearVelocityMultiplier;
-			this->handPose.palmVelocity.angularVelocity
-				*= HOL::Config.general.angularVelocityMultiplier;
+			if (this->filterJoints(time, this->handPose.palmLocation))
+			{
+				// Smooth enough to actually predict with, unlike the runtime's, so it gets its
+				// own multiplier instead of the general ones that default to 0.
+				float multiplier = HOL::Config.filter.velocityMultiplier;
+				this->handPose.palmVelocity = this->mPalmFilter.getVelocity();
+				this->handPose.palmVelocity.linearVelocity *= multiplier;
+				this->handPose.palmVelocity.angularVelocity *= multiplier;
+			}
+			else
+			{
+				auto palmVelocity
+					= this->mSample.velocities[XrHandJointEXT::XR_HAND_JOINT_PALM_EXT];
+
+				this->handPose.palmVelocity.linearVelocity
+					= toEigenVector(palmVelocity.linearVelocity)
+					  * HOL::Config.general.linearVelocityMultiplier;
+				this->handPose.palmVelocity.angularVelocity
+					= toEigenVector(palmVelocity.angularVelocity)
+					  * HOL::Config.general.angularVelocityMultiplier;
+			}
 
 			/////////////
 			// Offsets
@@ -248,7 +338,8 @@ void OpenXRHand::updateJointLocations(xr::UniqueDynamicSpace& space, XrTime time
 			// Finger movement
 			//////////////////////
 
-			this->calculateCurlSplay();
+			// Both hands at once, see HandTracking::calculateCurlSplay()
+			this->mCurlSplayPending = true;
 
 			/////////////
 			// Prev
@@ -259,42 +350,14 @@ void OpenXRHand::updateJointLocations(xr::UniqueDynamicSpace& space, XrTime time
 			this->mPrevRawPose.orientation = newPalmOrientation;
 
 			///////////////////////////
-			// Update display values
+			// Display values
 			///////////////////////////
-			{
-				// Hand orientation
-
-				HOL::display::HandTransform[this->mSide].rawPose.position = newPalmPosition;
-				HOL::display::HandTransform[this->mSide].rawPose.orientation = newPalmOrientation;
-
-				HOL::display::HandTransform[this->mSide].finalPose.position
-					= this->handPose.palmLocation.position;
-				HOL::display::HandTransform[this->mSide].finalPose.orientation
-					= this->handPose.palmLocation.orientation;
-
-				HOL::display::HandTransform[this->mSide].finalTranslationOffset
-					= controllerTranslationOffset;
-				HOL::display::HandTransform[this->mSide].finalOrientationOffset
-					= controllerRotationOffset;
-
-				// Finger curl
-				for (int i = 0; i < FingerType_MAX; i++)
-				{
-					// Turns out you cannot assign an array to an array
-					HOL::display::FingerTracking[this->mSide].rawBend[i]
-						= this->handPose.fingers[i];
-				}
-			}
-		}
-	}
-
-	///////////////////////////
-	// Update display values
-	///////////////////////////
 
-	{
-		HOL::display::HandTransform[this->mSide].active = this->handPose.active;
-		HOL::display::HandTransform[this->mSide].positionValid = this->handPose.poseValid;
-		HOL::display::HandTransform[this->mSide].positionTracked = this->handPose.poseTracked;
+			// Goes out with the HandFrame, the UI doesn't read any of this directly
+			this->rawPalmLocation.position = newPalmPosition;
+			this->rawPalmLocation.orientation = newPalmOrientation;
+			this->controllerTranslationOffset = controllerTranslationOffset;
+			this->controllerOrientationOffset = controllerRotationOffset;
+		}
 	}
 }
@@ -1,9 +1,8 @@
 #pragma once
 
-#include <d3d11.h> // Why do you need this??
-#include <openxr/openxr_platform.h>
-#include <openxr/openxr.hpp>
+#include <openxr/openxr.h>
 #include <HandOfLesserCommon.h>
+#include "src/core/hand_source.h"
 #include "src/hands/simple_gesture.h"
 #include "src/hands/hand_pose.h"
 
@@ -12,23 +11,46 @@ using namespace HOL;
 class OpenXRHand
 {
 public:
-	void init(xr::UniqueDynamicSession& session, HOL::HandSide side);
-	void updateJointLocations(xr::UniqueDynamicSpace& space, XrTime time);
+	void init(HOL::HandSide side);
+	void updateJointLocations(HOL::HandSource& source, XrTime time);
 
 	HandPose handPose;
 	SimpleGesture::SimpleGestureState
 		simpleGestures[SimpleGesture::SimpleGestureType::SIMPLE_GESTURE_MAX];
 	XrHandTrackingAimStateFB aimState{XR_TYPE_HAND_TRACKING_AIM_STATE_FB};
-	XrHandJointLocationEXT* getLastJointLocations();
 
-private:
+	// The located joints, converted as soon as they come in. Read these, not the raw sample.
+	HOL::HandJoints joints;
+
+	// For display, left as they were while the hand isn't tracked
+	HOL::PoseLocation rawPalmLocation;
+	Eigen::Vector3f controllerTranslationOffset = Eigen::Vector3f::Zero();
+	Eigen::Vector3f controllerOrientationOffset = Eigen::Vector3f::Zero(); // In degrees
+
+	XrHandJointVelocityEXT* getLastJointVelocities();
+
+	// What HandTracking does for this hand after updateJointLocations(), on its own for the
+	// benchmarks
 	void calculateCurlSplay();
 
+	// Same thing in two halves, so both hands go through computeCurlSplayBatch() together.
+	// Loading returns where this hand's pairs start, -1 if it has nothing new.
+	int loadCurlSplay(HOL::FingerBatch& batch);
+	void storeCurlSplay(const HOL::FingerBatch& batch, int first);
+
+private:
 	HOL::HandSide mSide;
-	XrHandTrackerEXT mHandTracker;
-	XrPath mInputSourcePath;
-	XrHandJointLocationEXT mJointLocations[XR_HAND_JOINT_COUNT_EXT];
-	XrHandJointVelocityEXT mJointVelocities[XR_HAND_JOINT_COUNT_EXT];
+	HOL::HandJointSample mSample;
+	bool mCurlSplayPending = false;
+
+	// See FilterSettings. Time is when the last fresh sample was for.
+	HOL::HandJointFilter mJointFilter;
+	HOL::PoseFilter mPalmFilter;
+	XrTime mLastFilterTime = 0;
+
+	Eigen::Quaternionf getFingerRootOrientation(FingerType finger);
+	bool filterJoints(XrTime time, PoseLocation& palm);
+	void repeatFilteredJoints();
 
 	HOL::PoseLocation mPrevRawPose;
 };
@@ -0,0 +1,34 @@
+#include "openxr_hand_source.h"
+#include "HandTrackingInterface.h"
+#include "XrUtils.h"
+
+using namespace HOL;
+using namespace HOL::OpenXR;
+
+void OpenXRHandSource::init(InstanceHolder* instanceHolder)
+{
+	this->mInstanceHolder = instanceHolder;
+
+	HandTrackingInterface::init(instanceHolder->mInstance);
+
+	for (int i = 0; i < HandSide::HandSide_MAX; i++)
+	{
+		HandTrackingInterface::createHandTracker(
+			instanceHolder->mSession, toOpenXRHandSide((HandSide)i), this->mHandTrackers[i]);
+	}
+}
+
+XrTime OpenXRHandSource::getTime()
+{
+	return this->mInstanceHolder->getTime();
+}
+
+void OpenXRHandSource::locateHand(HOL::HandSide side, XrTime time, HOL::HandJointSample& sample)
+{
+	sample.active = HandTrackingInterface::locateHandJoints(this->mHandTrackers[side],
+															this->mInstanceHolder->mStageSpace,
+															time,
+															sample.joints,
+															sample.velocities,
+															&sample.aimState);
+}
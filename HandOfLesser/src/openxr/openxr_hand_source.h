@@ -0,0 +1,22 @@
+#pragma once
+
+#include "src/core/hand_source.h"
+#include "InstanceHolder.h"
+
+namespace HOL::OpenXR
+{
+	// The real thing, joints straight from the runtime's hand trackers
+	class OpenXRHandSource : public HOL::HandSource
+	{
+	public:
+		// Session has to be running
+		void init(InstanceHolder* instanceHolder);
+
+		XrTime getTime() override;
+		void locateHand(HOL::HandSide side, XrTime time, HOL::HandJointSample& sample) override;
+
+	private:
+		InstanceHolder* mInstanceHolder = nullptr;
+		XrHandTrackerEXT mHandTrackers[HOL::HandSide_MAX];
+	};
+} // namespace HOL::OpenXR
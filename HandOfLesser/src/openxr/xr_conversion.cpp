@@ -0,0 +1,37 @@
+#include "xr_conversion.h"
+
+namespace HOL::OpenXR
+{
+	Eigen::Vector3f toEigenVector(const XrVector3f& xrVector)
+	{
+		return Eigen::Vector3f(xrVector.x, xrVector.y, xrVector.z);
+	}
+
+	Eigen::Quaternionf toEigenQuaternion(const XrQuaternionf& xrQuat)
+	{
+		return Eigen::Quaternionf(xrQuat.w, xrQuat.x, xrQuat.y, xrQuat.z);
+	}
+
+	XrVector3f toXrVector(const Eigen::Vector3f& vector)
+	{
+		return XrVector3f{vector.x(), vector.y(), vector.z()};
+	}
+
+	XrQuaternionf toXrQuaternion(const Eigen::Quaternionf& quat)
+	{
+		return XrQuaternionf{quat.x(), quat.y(), quat.z(), quat.w()};
+	}
+
+	XrHandEXT toOpenXRHandSide(HOL::HandSide side)
+	{
+		switch (side)
+		{
+			case HOL::LeftHand:
+				return XrHandEXT::XR_HAND_LEFT_EXT;
+			case HOL::RightHand:
+				return XrHandEXT::XR_HAND_RIGHT_EXT;
+			default:
+				return XrHandEXT::XR_HAND_MAX_ENUM_EXT; // Just don't do this
+		}
+	}
+} // namespace HOL::OpenXR
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <openxr/openxr.h>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <HandOfLesserCommon.h>
+
+// Plain conversions, no runtime or platform headers so the headless build can use them
+namespace HOL::OpenXR
+{
+	Eigen::Vector3f toEigenVector(const XrVector3f& xrVector);
+
+	Eigen::Quaternionf toEigenQuaternion(const XrQuaternionf& xrQuat);
+
+	XrVector3f toXrVector(const Eigen::Vector3f& vector);
+
+	XrQuaternionf toXrQuaternion(const Eigen::Quaternionf& quat);
+
+	XrHandEXT toOpenXRHandSide(HOL::HandSide side);
+} // namespace HOL::OpenXR
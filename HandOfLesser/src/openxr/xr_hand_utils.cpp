@@ -1,59 +1,28 @@
 
 #include "xr_hand_utils.h"
-#include "XrUtils.h"
+#include "xr_conversion.h"
 
 namespace HOL::OpenXR
 {
-	XrHandJointLocationEXT& getJoint(XrHandJointLocationEXT leftHandJoints[],
-									 XrHandJointLocationEXT rightHandJoints[],
-									 XrHandJointEXT joint,
-									 HOL::HandSide side)
+	void toHandJoints(const XrHandJointLocationEXT joints[], HOL::HandJoints& handJoints)
 	{
-		return (side == HOL::HandSide::LeftHand ? leftHandJoints[joint] : rightHandJoints[joint]);
-	}
-	XrHandJointLocationEXT& getJoint(XrHandJointLocationEXT joints[], XrHandJointEXT joint)
-	{
-		return joints[joint];
-	}
-
-	Eigen::Vector3f getJointPosition(XrHandJointLocationEXT leftHandJoints[],
-									 XrHandJointLocationEXT rightHandJoints[],
-									 XrHandJointEXT joint,
-									 HOL::HandSide side)
-	{
-		return HOL::OpenXR::toEigenVector(
-			(side == HOL::HandSide::LeftHand ? leftHandJoints[joint] : rightHandJoints[joint])
-				.pose.position);
-	}
+		static_assert(HOL::HAND_JOINT_COUNT == XR_HAND_JOINT_COUNT_EXT);
 
-	Eigen::Vector3f getJointPosition(XrHandJointLocationEXT joints[], XrHandJointEXT joint)
-	{
-		return HOL::OpenXR::toEigenVector(joints[joint].pose.position);
-	}
-
-	Eigen::Vector3f getJointPosition(XrHandJointLocationEXT joint)
-	{
-		return HOL::OpenXR::toEigenVector(joint.pose.position);
-	}
+		const XrSpaceLocationFlags validFlags
+			= XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+		const XrSpaceLocationFlags trackedFlags
+			= XR_SPACE_LOCATION_POSITION_TRACKED_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
 
-	Eigen::Quaternionf getJointOrientation(XrHandJointLocationEXT leftHandJoints[],
-										   XrHandJointLocationEXT rightHandJoints[],
-										   XrHandJointEXT joint,
-										   HOL::HandSide side)
-	{
-		return HOL::OpenXR::toEigenQuaternion(
-			(side == HOL::HandSide::LeftHand ? leftHandJoints[joint] : rightHandJoints[joint])
-				.pose.orientation);
-	}
-
-	Eigen::Quaternionf getJointOrientation(XrHandJointLocationEXT joints[], XrHandJointEXT joint)
-	{
-		return HOL::OpenXR::toEigenQuaternion(joints[joint].pose.orientation);
-	}
-
-	Eigen::Quaternionf getJointOrientation(XrHandJointLocationEXT joint)
-	{
-		return HOL::OpenXR::toEigenQuaternion(joint.pose.orientation);
+		for (int i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++)
+		{
+			const XrHandJointLocationEXT& joint = joints[i];
+			handJoints.setJoint(i,
+								toEigenVector(joint.pose.position),
+								toEigenQuaternion(joint.pose.orientation),
+								joint.radius,
+								(joint.locationFlags & validFlags) == validFlags,
+								(joint.locationFlags & trackedFlags) == trackedFlags);
+		}
 	}
 
 	XrHandJointEXT getRootJoint(HOL::FingerType fingerType)
@@ -70,6 +39,8 @@ namespace HOL::OpenXR
 				return XrHandJointEXT::XR_HAND_JOINT_RING_METACARPAL_EXT;
 			case FingerType::FingerLittle:
 				return XrHandJointEXT::XR_HAND_JOINT_LITTLE_METACARPAL_EXT;
+			default:
+				return XrHandJointEXT::XR_HAND_JOINT_MAX_ENUM_EXT; // Just don't do this
 		}
 	}
 
@@ -87,15 +58,14 @@ namespace HOL::OpenXR
 				return XrHandJointEXT::XR_HAND_JOINT_RING_PROXIMAL_EXT;
 			case FingerType::FingerLittle:
 				return XrHandJointEXT::XR_HAND_JOINT_LITTLE_PROXIMAL_EXT;
+			default:
+				return XrHandJointEXT::XR_HAND_JOINT_MAX_ENUM_EXT; // Just don't do this
 		}
 	}
 
 	XrHandJointEXT getSecondFingerJoint(HOL::FingerType fingerType)
 	{
-		switch (fingerType)
-		{
-			return (XrHandJointEXT)(getFirstFingerJoint(fingerType) + 1);
-		}
+		return (XrHandJointEXT)(getFirstFingerJoint(fingerType) + 1);
 	}
 
 	XrHandJointEXT getFingerTip(HOL::FingerType fingerType)
@@ -112,6 +82,8 @@ namespace HOL::OpenXR
 				return XrHandJointEXT::XR_HAND_JOINT_RING_TIP_EXT;
 			case FingerType::FingerLittle:
 				return XrHandJointEXT::XR_HAND_JOINT_LITTLE_TIP_EXT;
+			default:
+				return XrHandJointEXT::XR_HAND_JOINT_MAX_ENUM_EXT; // Just don't do this
 		}
 	}
 
@@ -1,39 +1,15 @@
 #pragma once
 
-#include <d3d11.h>
-#include <openxr/openxr_platform.h>
-#include "openxr/openxr_structs.hpp"
+#include <openxr/openxr.h>
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include <HandOfLesserCommon.h>
+#include "xr_conversion.h"
 
 namespace HOL::OpenXR
 {
-	XrHandJointLocationEXT& getJoint(XrHandJointLocationEXT leftHandJoints[],
-									 XrHandJointLocationEXT rightHandJoints[],
-									 XrHandJointEXT joint,
-									 HOL::HandSide side);
-
-	XrHandJointLocationEXT& getJoint(XrHandJointLocationEXT leftHandJoints[], XrHandJointEXT joint);
-
-	Eigen::Vector3f getJointPosition(XrHandJointLocationEXT leftHandJoints[],
-									 XrHandJointLocationEXT rightHandJoints[],
-									 XrHandJointEXT joint,
-									 HOL::HandSide side);
-
-	Eigen::Vector3f getJointPosition(XrHandJointLocationEXT leftHandJoints[], XrHandJointEXT joint);
-
-	Eigen::Vector3f getJointPosition(XrHandJointLocationEXT joint);
-
-	Eigen::Quaternionf getJointOrientation(XrHandJointLocationEXT leftHandJoints[],
-										   XrHandJointLocationEXT rightHandJoints[],
-										   XrHandJointEXT joint,
-										   HOL::HandSide side);
-
-	Eigen::Quaternionf getJointOrientation(XrHandJointLocationEXT leftHandJoints[],
-										   XrHandJointEXT joint);
-
-	Eigen::Quaternionf getJointOrientation(XrHandJointLocationEXT leftHandJoints);
+	// Converts everything once so the rest of the frame can read joints straight off the arrays
+	void toHandJoints(const XrHandJointLocationEXT joints[], HOL::HandJoints& handJoints);
 
 	// Returns the metacarpal for all fingers but the thumb, where the wrist is returned instead.
 	// The returned value +4 will give you the tip of each finger, even for the thumb.
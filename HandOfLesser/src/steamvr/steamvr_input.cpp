@@ -17,30 +17,60 @@ namespace HOL::SteamVR
 	{
 		//printf("SteamVR Input: %s, %.3f\n", inputName.c_str(), value);
 
-		FloatInputPacket input;
+		// Value-initialized in place, so the padding that goes out on the wire and into
+		// recordings is always zero.
+		uint16_t inputId = this->mInputIds.find(inputName);
+		if (inputId != INVALID_INPUT_ID)
+		{
+			FloatInputIdPacket& input = this->floatIdInputs.emplace_back();
+			input.side = side;
+			input.inputId = inputId;
+			input.value = value;
+			return;
+		}
+
+		FloatInputPacket& input = this->floatInputs.emplace_back();
 		input.side = side;
 		std::strncpy(&input.inputName[0], inputName.c_str(), 64); // max length 64
 		input.value = value;
-
-		this->floatInputs.push_back(input);
 	}
 
 	void SteamVRInput::submitBoolean(HandSide side, const std::string& inputName, bool value)
 	{
-		printf("SteamVR Input: %s, %s\n", inputName.c_str(), value ? "True" : "False");
+		//printf("SteamVR Input: %s, %s\n", inputName.c_str(), value ? "True" : "False");
+
+		uint16_t inputId = this->mInputIds.find(inputName);
+		if (inputId != INVALID_INPUT_ID)
+		{
+			BoolInputIdPacket& input = this->boolIdInputs.emplace_back();
+			input.side = side;
+			input.inputId = inputId;
+			input.value = value;
+			return;
+		}
 
-		BoolInputPacket input;
+		BoolInputPacket& input = this->boolInputs.emplace_back();
 		input.side = side;
 		std::strncpy(&input.inputName[0], inputName.c_str(), 64); // max length 64
 		input.value = value;
-
-		this->boolInputs.push_back(input);
 	}
 
 	void SteamVRInput::clear()
 	{
 		this->boolInputs.clear();
 		this->floatInputs.clear();
+		this->boolIdInputs.clear();
+		this->floatIdInputs.clear();
+	}
+
+	void SteamVRInput::updateInputIds(const HOL::InputIdTablePacket* packet)
+	{
+		this->mInputIds.readPage(packet);
+	}
+
+	bool SteamVRInput::hasInputIds()
+	{
+		return this->mInputIds.getGeneration() != 0;
 	}
 
 
@@ -15,8 +15,18 @@ namespace HOL::SteamVR
 		void submitBoolean(HandSide side, const std::string& inputName, bool value);
 		void clear();
 
+		void updateInputIds(const HOL::InputIdTablePacket* packet);
+		bool hasInputIds();
+
+		// Inputs the driver has given us an id for go in the Id vectors,
+		// anything else is sent by name.
 		std::vector<HOL::FloatInputPacket> floatInputs;
 		std::vector<HOL::BoolInputPacket> boolInputs;
+		std::vector<HOL::FloatInputIdPacket> floatIdInputs;
+		std::vector<HOL::BoolInputIdPacket> boolIdInputs;
+
+	private:
+		HOL::InputIdTable mInputIds;
 
 
 	};
@@ -1,12 +1,33 @@
 #pragma once
 
 #include "hol_utils.h"
+#include <atomic>
+#include <HandOfLesserCommon.h>
 
 namespace HOL
 {
+	static std::atomic<int64_t> pipelineClock = 0;
+
 	std::chrono::milliseconds timeSince(std::chrono::steady_clock::time_point time)
 	{
-		auto currentTime = std::chrono::steady_clock::now();
+		auto currentTime = pipelineNow();
 		return std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - time);
 	}
+
+	int64_t pipelineNanoseconds()
+	{
+		int64_t now = pipelineClock.load(std::memory_order_relaxed);
+		return now != 0 ? now : HOL::steadyNanoseconds();
+	}
+
+	std::chrono::steady_clock::time_point pipelineNow()
+	{
+		return std::chrono::steady_clock::time_point(
+			std::chrono::nanoseconds(pipelineNanoseconds()));
+	}
+
+	void setPipelineClock(int64_t now)
+	{
+		pipelineClock.store(now, std::memory_order_relaxed);
+	}
 } // namespace HOL
@@ -1,8 +1,18 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 
 namespace HOL
 {
 	std::chrono::milliseconds timeSince(std::chrono::steady_clock::time_point time);
-}
+
+	// What gestures, inputs and change detection think the time is.
+	// steady_clock normally, a replay pins it to each frame's time so the same recording
+	// always makes the same output no matter how fast it's played back.
+	int64_t pipelineNanoseconds();
+	std::chrono::steady_clock::time_point pipelineNow();
+
+	// 0 goes back to steady_clock
+	void setPipelineClock(int64_t now);
+} // namespace HOL
@@ -1,6 +1,5 @@
 #include "vrchat_osc.h"
 #include "src/core/settings_global.h"
-#include "src/core/ui/display_global.h"
 #include <oscpp/client.hpp>
 
 namespace HOL::VRChat
@@ -277,9 +276,8 @@ namespace HOL::VRChat
 				float leftBend = this->mOscOutput[leftSideIndex];
 				float rightBend = this->mOscOutput[rightSideIndex];
 
-				HOL::display::FingerTracking[HandSide::LeftHand].humanoidBend[i].bend[j] = leftBend;
-				HOL::display::FingerTracking[HandSide::RightHand].humanoidBend[i].bend[j]
-					= rightBend;
+				this->mDisplay.humanoidBend[HandSide::LeftHand][i].bend[j] = leftBend;
+				this->mDisplay.humanoidBend[HandSide::RightHand][i].bend[j] = rightBend;
 
 				int index = getParameterIndex((FingerType)i, (FingerBendType)j);
 				float packed = encodePacked(leftBend, rightBend);
@@ -287,9 +285,9 @@ namespace HOL::VRChat
 
 				// 0-255 values in left hand slot, -1 to +1 values in right hand slot
 				// We're recreating the 0-255 values from the -1 to +1 for display purposes
-				HOL::display::FingerTracking[HandSide::LeftHand].packedBend[i].bend[j]
+				this->mDisplay.packedBend[HandSide::LeftHand][i].bend[j]
 					= std::roundf(((packed + 1.f) * 0.5f) * 255.f);
-				HOL::display::FingerTracking[HandSide::RightHand].packedBend[i].bend[j] = packed;
+				this->mDisplay.packedBend[HandSide::RightHand][i].bend[j] = packed;
 			}
 		}
 	}
@@ -310,7 +308,7 @@ namespace HOL::VRChat
 					float bend = computeParameterValue(
 						finger.bend[j], (HandSide)side, (FingerType)i, (FingerBendType)j);
 
-					HOL::display::FingerTracking[side].humanoidBend[i].bend[j] = bend;
+					this->mDisplay.humanoidBend[side][i].bend[j] = bend;
 
 					int index = getParameterIndex((HandSide)side, (FingerType)i, (FingerBendType)j);
 					this->mOscOutput[index] = bend;
@@ -323,14 +321,28 @@ namespace HOL::VRChat
 	void HOL::VRChat::VRChatOSC::generateOscOutput(HOL::HandPose& leftHand,
 												   HOL::HandPose& rightHand)
 	{
+		HOL_TRACE_SCOPE("VRChatOSC::generateOscOutput");
+
 		generateOscOutputFull(leftHand, rightHand);
 		generateOscOutputPacked();
 	}
 
-	// includes a hand_side param denoting which hand the data is for
-	size_t HOL::VRChat::VRChatOSC::generateOscBundleAlternating()
+	// includes a hand_side param denoting which hand the data is for.
+	// The avatar copies whatever is in the shared parameters to the side we name, so a side
+	// always goes out in full. It's skipped if none of it changed.
+	size_t HOL::VRChat::VRChatOSC::generateOscBundleAlternating(int64_t now)
 	{
+		HOL_TRACE_SCOPE("VRChatOSC::generateOscBundleAlternating");
+
 		HOL::HandSide side = this->swapTransmitSide();
+		if (!this->sideChanged(side, now))
+		{
+			side = this->swapTransmitSide();
+			if (!this->sideChanged(side, now))
+			{
+				return 0;
+			}
+		}
 
 		// 0 or 40 depending on left or right side
 		// Use to offset i
@@ -343,9 +355,13 @@ namespace HOL::VRChat
 
 		for (int i = 0; i < SINGLE_HAND_JOINT_COUNT; i++)
 		{
+			float value = this->mOscOutput[i + sideIndexOffset];
+
 			packet.openMessage(VRChatOSC::OSC_PARAMETER_NAMES_ALTERNATING[i].c_str(), 1)
-				.float32(this->mOscOutput[i + sideIndexOffset])
+				.float32(value)
 				.closeMessage();
+
+			this->mAlternatingChannels[i + sideIndexOffset].sent(value, now);
 		}
 
 		packet.openMessage(OSC_ALTERNATING_HAND_SIDE_PARAMETER.c_str(), 1)
@@ -357,8 +373,16 @@ namespace HOL::VRChat
 		return packet.size();
 	}
 
-	size_t HOL::VRChat::VRChatOSC::generateOscBundlePacked()
+	// Packed values are already quantized, any change at all is a real step
+	size_t HOL::VRChat::VRChatOSC::generateOscBundlePacked(int64_t now)
 	{
+		HOL_TRACE_SCOPE("VRChatOSC::generateOscBundlePacked");
+
+		// No dead-band, see above
+		float threshold = 0;
+		int64_t keepAlive = HOL::settings::getKeepAliveNanoseconds();
+		int count = 0;
+
 		// Size param is presumably buffer size
 		OSCPP::Client::Packet packet(this->mOscPacketBuffer, OSC_PACKET_BUFFER_SIZE);
 
@@ -366,18 +390,33 @@ namespace HOL::VRChat
 
 		for (int i = 0; i < SINGLE_HAND_JOINT_COUNT; i++)
 		{
+			float value = this->mOscOutputPacked[i];
+			if (!this->mPackedChannels[i].changed(value, threshold, keepAlive, now))
+			{
+				continue;
+			}
+
 			packet.openMessage(VRChatOSC::OSC_PARAMETER_NAMES_PACKED[i].c_str(), 1)
-				.float32(this->mOscOutputPacked[i])
+				.float32(value)
 				.closeMessage();
+
+			this->mPackedChannels[i].sent(value, now);
+			count++;
 		}
 
 		packet.closeBundle();
 
-		return packet.size();
+		return count > 0 ? packet.size() : 0;
 	}
 
-	size_t HOL::VRChat::VRChatOSC::generateOscBundleFull()
+	size_t HOL::VRChat::VRChatOSC::generateOscBundleFull(int64_t now)
 	{
+		HOL_TRACE_SCOPE("VRChatOSC::generateOscBundleFull");
+
+		float threshold = Config.transmit.oscDeadband;
+		int64_t keepAlive = HOL::settings::getKeepAliveNanoseconds();
+		int count = 0;
+
 		// Size param is presumably buffer size
 		OSCPP::Client::Packet packet(this->mOscPacketBuffer, OSC_PACKET_BUFFER_SIZE);
 
@@ -385,14 +424,23 @@ namespace HOL::VRChat
 
 		for (int i = 0; i < BOTH_HAND_JOINT_COUNT; i++)
 		{
+			float value = this->mOscOutput[i];
+			if (!this->mFullChannels[i].changed(value, threshold, keepAlive, now))
+			{
+				continue;
+			}
+
 			packet.openMessage(VRChatOSC::OSC_PARAMETER_NAMES_FULL[i].c_str(), 1)
-				.float32(this->mOscOutput[i])
+				.float32(value)
 				.closeMessage();
+
+			this->mFullChannels[i].sent(value, now);
+			count++;
 		}
 
 		packet.closeBundle();
 
-		return packet.size();
+		return count > 0 ? packet.size() : 0;
 	}
 
 	char* HOL::VRChat::VRChatOSC::getPacketBuffer()
@@ -400,6 +448,11 @@ namespace HOL::VRChat
 		return this->mOscPacketBuffer;
 	}
 
+	const HOL::VRChat::OscOutputDisplay& HOL::VRChat::VRChatOSC::getDisplay()
+	{
+		return this->mDisplay;
+	}
+
 	HOL::HandSide HOL::VRChat::VRChatOSC::swapTransmitSide()
 	{
 		// Swap side, return new side.
@@ -410,4 +463,22 @@ namespace HOL::VRChat
 		return this->mNextNextTransmitSide;
 	}
 
+	bool HOL::VRChat::VRChatOSC::sideChanged(HOL::HandSide side, int64_t now)
+	{
+		float threshold = Config.transmit.oscDeadband;
+		int64_t keepAlive = HOL::settings::getKeepAliveNanoseconds();
+		int sideIndexOffset = VRChat::SINGLE_HAND_JOINT_COUNT * side;
+
+		for (int i = sideIndexOffset; i < sideIndexOffset + SINGLE_HAND_JOINT_COUNT; i++)
+		{
+			float value = this->mOscOutput[i];
+			if (this->mAlternatingChannels[i].changed(value, threshold, keepAlive, now))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 } // namespace HOL::VRChat
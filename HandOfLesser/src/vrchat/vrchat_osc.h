@@ -21,6 +21,13 @@ namespace HOL::VRChat
 	static const std::string OSC_ALTERNATING_HAND_SIDE_PARAMETER
 		= OSC_PREFIX + NAMESPACE_PREFIX + OSC_ALTERNATING_PREFIX + "hand_side";
 
+	// What we last sent, for the UI. Packed is 0-255 in the left slot, -1 to +1 in the right.
+	struct OscOutputDisplay
+	{
+		FingerBend humanoidBend[HandSide::HandSide_MAX][FingerType::FingerType_MAX];
+		FingerBend packedBend[HandSide::HandSide_MAX][FingerType::FingerType_MAX];
+	};
+
 	class VRChatOSC
 	{
 
@@ -44,11 +51,14 @@ namespace HOL::VRChat
 		static float HUMAN_RIG_RANGE[SINGLE_HAND_JOINT_COUNT];
 		static float HUMAN_RIG_CENTER[SINGLE_HAND_JOINT_COUNT];
 
-		size_t generateOscBundleFull();
-		size_t generateOscBundleAlternating();
-		size_t generateOscBundlePacked();
+		// Only parameters that changed since they were last sent, see TransmitSettings.
+		// Return 0 when there's nothing to send.
+		size_t generateOscBundleFull(int64_t now);
+		size_t generateOscBundleAlternating(int64_t now);
+		size_t generateOscBundlePacked(int64_t now);
 
 		char* getPacketBuffer();
+		const OscOutputDisplay& getDisplay();
 
 	private:		
 		static void initParameters();
@@ -62,6 +72,7 @@ namespace HOL::VRChat
 		void generateOscOutputPacked();
 
 		HOL::HandSide swapTransmitSide();
+		bool sideChanged(HOL::HandSide side, int64_t now);
 		HOL::HandSide mNextNextTransmitSide;
 
 		static std::string OSC_PARAMETER_NAMES_FULL[SINGLE_HAND_JOINT_COUNT * 2];
@@ -72,6 +83,13 @@ namespace HOL::VRChat
 		float mOscOutputPacked[SINGLE_HAND_JOINT_COUNT];	// Packed, generated from Full.
 
 		char mOscPacketBuffer[OSC_PACKET_BUFFER_SIZE]; // 2560 Should be plenty
+
+		// What each mode last sent per parameter
+		HOL::DeadbandChannel mFullChannels[BOTH_HAND_JOINT_COUNT];
+		HOL::DeadbandChannel mAlternatingChannels[BOTH_HAND_JOINT_COUNT];
+		HOL::DeadbandChannel mPackedChannels[SINGLE_HAND_JOINT_COUNT];
+
+		OscOutputDisplay mDisplay;
 	};
 
 } // namespace HOL::VRChat
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "src/math/one_euro_filter.h"
+
+using namespace HOL;
+
+// A second or so of frames, jittered around a resting hand
+static const int FILTER_BENCHMARK_FRAMES = 128;
+
+struct FilterBenchmarkFrames
+{
+	std::vector<HandJoints> joints;
+	std::vector<PoseLocation> palms;
+
+	FilterBenchmarkFrames()
+	{
+		// Seeded, so every run does the same work
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> offset(-0.1f, 0.1f);
+		std::uniform_real_distribution<float> jitter(-0.002f, 0.002f);
+
+		HandJoints rest;
+		for (int joint = 0; joint < HAND_JOINT_COUNT; joint++)
+		{
+			rest.setJoint(joint,
+						  Eigen::Vector3f(offset(random), offset(random), offset(random)),
+						  Eigen::Quaternionf::UnitRandom(),
+						  0.01f,
+						  true,
+						  true);
+		}
+
+		this->joints.resize(FILTER_BENCHMARK_FRAMES, rest);
+		for (HandJoints& frame : this->joints)
+		{
+			for (int joint = 0; joint < HAND_JOINT_COUNT; joint++)
+			{
+				Eigen::Vector3f noise(jitter(random), jitter(random), jitter(random));
+				Eigen::Quaternionf wobble(1, jitter(random), jitter(random), jitter(random));
+				frame.setJointPose(joint,
+								   rest.position(joint) + noise,
+								   (rest.orientation(joint) * wobble).normalized());
+			}
+
+			PoseLocation palm;
+			palm.position = frame.position(0);
+			palm.orientation = frame.orientation(0);
+			this->palms.push_back(palm);
+		}
+	}
+};
+
+static const FilterBenchmarkFrames& getFrames()
+{
+	static FilterBenchmarkFrames frames;
+	return frames;
+}
+
+// Both hands' worth of joints, what OpenXRHand does every frame with filtering on
+static void BM_FilterHandJoints(benchmark::State& state)
+{
+	const FilterBenchmarkFrames& frames = getFrames();
+	auto filters = std::make_unique<HandJointFilter[]>(2);
+	auto joints = std::make_unique<HandJoints[]>(2);
+	OneEuroParameters position{1.f, 20.f, 1.f};
+	OneEuroParameters rotation{1.f, 5.f, 1.f};
+	int i = 0;
+
+	for (auto _ : state)
+	{
+		for (int hand = 0; hand < 2; hand++)
+		{
+			joints[hand] = frames.joints[(i + hand) % FILTER_BENCHMARK_FRAMES];
+			filters[hand].filter(joints[hand], 1 / 90.f, position, rotation);
+		}
+		benchmark::DoNotOptimize(joints.get());
+		i = (i + 1) % FILTER_BENCHMARK_FRAMES;
+	}
+}
+BENCHMARK(BM_FilterHandJoints);
+
+static void BM_FilterPalmPose(benchmark::State& state)
+{
+	const FilterBenchmarkFrames& frames = getFrames();
+	PoseFilter filter;
+	OneEuroParameters position{1.f, 20.f, 1.f};
+	OneEuroParameters rotation{1.f, 5.f, 1.f};
+	int i = 0;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(filter.filter(frames.palms[i], 1 / 90.f, position, rotation));
+		i = (i + 1) % FILTER_BENCHMARK_FRAMES;
+	}
+}
+BENCHMARK(BM_FilterPalmPose);
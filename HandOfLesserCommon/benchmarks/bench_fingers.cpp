@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "src/math/finger_batch.h"
+#include "src/math/fingers.h"
+
+using namespace HOL;
+
+// Enough that it doesn't all sit in registers, few enough to stay in cache like a real frame
+static const int FINGER_BENCHMARK_JOINTS = 256;
+
+struct FingerBenchmarkJoints
+{
+	std::vector<Eigen::Quaternionf> orientations;
+	std::vector<Eigen::Vector3f> positions;
+
+	FingerBenchmarkJoints()
+	{
+		// Seeded, so every run does the same work
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> angle(-1.2f, 1.2f);
+		std::uniform_real_distribution<float> offset(-0.1f, 0.1f);
+
+		for (int i = 0; i < FINGER_BENCHMARK_JOINTS; i++)
+		{
+			this->orientations.push_back(
+				Eigen::Quaternionf(Eigen::AngleAxisf(angle(random), Eigen::Vector3f::UnitX())
+								   * Eigen::AngleAxisf(angle(random), Eigen::Vector3f::UnitY())
+								   * Eigen::AngleAxisf(angle(random), Eigen::Vector3f::UnitZ())));
+			this->positions.push_back(
+				Eigen::Vector3f(offset(random), offset(random), offset(random)));
+		}
+	}
+};
+
+static const FingerBenchmarkJoints& getJoints()
+{
+	static FingerBenchmarkJoints joints;
+	return joints;
+}
+
+static void BM_ComputeCurl(benchmark::State& state)
+{
+	const FingerBenchmarkJoints& joints = getJoints();
+	int i = 0;
+
+	for (auto _ : state)
+	{
+		int next = (i + 1) % FINGER_BENCHMARK_JOINTS;
+		benchmark::DoNotOptimize(computeCurl(joints.orientations[i], joints.orientations[next]));
+		i = next;
+	}
+}
+BENCHMARK(BM_ComputeCurl);
+
+static void BM_ComputeSplay(benchmark::State& state)
+{
+	const FingerBenchmarkJoints& joints = getJoints();
+	int i = 0;
+
+	for (auto _ : state)
+	{
+		int next = (i + 1) % FINGER_BENCHMARK_JOINTS;
+		benchmark::DoNotOptimize(computeSplay(joints.orientations[i], joints.orientations[next]));
+		i = next;
+	}
+}
+BENCHMARK(BM_ComputeSplay);
+
+static void BM_ComputeHumanoidSplay(benchmark::State& state)
+{
+	const FingerBenchmarkJoints& joints = getJoints();
+	int i = 0;
+
+	for (auto _ : state)
+	{
+		int next = (i + 1) % FINGER_BENCHMARK_JOINTS;
+		benchmark::DoNotOptimize(computeHumanoidSplay(
+			joints.orientations[i], joints.positions[i], joints.positions[next]));
+		i = next;
+	}
+}
+BENCHMARK(BM_ComputeHumanoidSplay);
+
+// What a hand actually does per frame, 5 fingers of 3 curls and a splay
+static void BM_ComputeHandCurlSplay(benchmark::State& state)
+{
+	const FingerBenchmarkJoints& joints = getJoints();
+	int i = 0;
+
+	for (auto _ : state)
+	{
+		for (int finger = 0; finger < 5; finger++)
+		{
+			const Eigen::Quaternionf* orientations
+				= &joints.orientations[(i + finger * 4) % (FINGER_BENCHMARK_JOINTS - 4)];
+			for (int joint = 0; joint < 3; joint++)
+			{
+				benchmark::DoNotOptimize(computeCurl(orientations[joint], orientations[joint + 1]));
+			}
+			benchmark::DoNotOptimize(computeSplay(orientations[0], orientations[1]));
+		}
+		i = (i + 20) % FINGER_BENCHMARK_JOINTS;
+	}
+}
+BENCHMARK(BM_ComputeHandCurlSplay);
+
+// Same work as BM_ComputeHandCurlSplay, but for both hands at once. Splays come out of every
+// pair whether they're wanted or not, so this is 30 of each against 20 calls per hand.
+static void BM_ComputeCurlSplayBatch(benchmark::State& state)
+{
+	const FingerBenchmarkJoints& joints = getJoints();
+	auto batch = std::make_unique<FingerBatch>();
+	int i = 0;
+
+	state.SetLabel(getFingerBatchBackend());
+
+	for (auto _ : state)
+	{
+		batch->count = 0;
+		for (int hand = 0; hand < 2; hand++)
+		{
+			for (int finger = 0; finger < 5; finger++)
+			{
+				int first = (i + (hand * 5 + finger) * 4) % (FINGER_BENCHMARK_JOINTS - 4);
+				const Eigen::Quaternionf* orientations = &joints.orientations[first];
+				for (int joint = 0; joint < 3; joint++)
+				{
+					batch->add(orientations[joint], orientations[joint + 1]);
+				}
+			}
+		}
+
+		computeCurlSplayBatch(*batch);
+		benchmark::DoNotOptimize(batch->curl);
+		benchmark::DoNotOptimize(batch->splay);
+		i = (i + 40) % FINGER_BENCHMARK_JOINTS;
+	}
+}
+BENCHMARK(BM_ComputeCurlSplayBatch);
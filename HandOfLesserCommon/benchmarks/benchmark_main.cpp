@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "src/benchmark/benchmark_results.h"
+
+// Shared main for every HandOfLesser benchmark executable. Takes the usual --benchmark_*
+// arguments, plus:
+//
+//   --hol_results <file>      Write results in our own format, see benchmark_results.h
+//   --hol_baseline <file>     Compare against earlier results, fail if anything regressed
+//   --hol_threshold <percent> How much slower counts as regressed, 10 by default
+
+// Console output as usual, and keeps the numbers for us
+class ResultCollector : public benchmark::ConsoleReporter
+{
+public:
+	void ReportRuns(const std::vector<Run>& runs) override
+	{
+		benchmark::ConsoleReporter::ReportRuns(runs);
+
+		for (const Run& run : runs)
+		{
+			// With --benchmark_repetitions the median beats any single run
+			bool median = run.run_type == Run::RT_Aggregate && run.aggregate_name == "median";
+			if ((run.run_type != Run::RT_Iteration && !median) || run.iterations == 0)
+			{
+				continue;
+			}
+
+			HOL::BenchmarkResult result;
+			result.name = run.run_name.str();
+			result.nanoseconds = run.GetAdjustedCPUTime()
+								 / benchmark::GetTimeUnitMultiplier(run.time_unit) * 1e9;
+			result.iterations = (uint64_t)run.iterations;
+			this->add(result, median);
+		}
+	}
+
+	std::vector<HOL::BenchmarkResult> results;
+
+private:
+	void add(const HOL::BenchmarkResult& result, bool median)
+	{
+		for (HOL::BenchmarkResult& existing : this->results)
+		{
+			if (existing.name == result.name)
+			{
+				// Repetitions all land here, the median comes last and wins
+				if (median)
+				{
+					existing = result;
+				}
+				return;
+			}
+		}
+
+		this->results.push_back(result);
+	}
+};
+
+static int compareToBaseline(const std::string& path,
+							 const std::vector<HOL::BenchmarkResult>& results,
+							 float threshold)
+{
+	std::vector<HOL::BenchmarkResult> baseline;
+	if (!HOL::readBenchmarkResults(path, baseline))
+	{
+		return 1;
+	}
+
+	int regressions = 0;
+	printf("\n%-50s %12s %12s %9s\n", "benchmark", "baseline ns", "current ns", "change");
+	for (const HOL::BenchmarkComparison& comparison :
+		 HOL::compareBenchmarkResults(baseline, results, threshold))
+	{
+		printf("%-50s %12.2f %12.2f %+8.1f%%%s\n",
+			   comparison.name.c_str(),
+			   comparison.baseline,
+			   comparison.current,
+			   comparison.change,
+			   comparison.regressed ? "  REGRESSED" : "");
+
+		if (comparison.regressed)
+		{
+			regressions++;
+		}
+	}
+
+	if (regressions > 0)
+	{
+		printf("\n%d benchmark(s) more than %.1f%% slower than %s\n",
+			   regressions,
+			   threshold,
+			   path.c_str());
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	std::string resultsPath;
+	std::string baselinePath;
+	float threshold = 10.f;
+
+	// Take ours out before benchmark complains about them
+	std::vector<char*> remaining = {argv[0]};
+	for (int i = 1; i < argc; i++)
+	{
+		bool hasValue = i + 1 < argc;
+
+		if (strcmp(argv[i], "--hol_results") == 0 && hasValue)
+		{
+			resultsPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--hol_baseline") == 0 && hasValue)
+		{
+			baselinePath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--hol_threshold") == 0 && hasValue)
+		{
+			threshold = (float)atof(argv[++i]);
+		}
+		else
+		{
+			remaining.push_back(argv[i]);
+		}
+	}
+
+	int remainingCount = (int)remaining.size();
+	benchmark::Initialize(&remainingCount, remaining.data());
+	if (benchmark::ReportUnrecognizedArguments(remainingCount, remaining.data()))
+	{
+		return 1;
+	}
+
+	ResultCollector collector;
+	benchmark::RunSpecifiedBenchmarks(&collector);
+	benchmark::Shutdown();
+
+	if (!resultsPath.empty() && !HOL::writeBenchmarkResults(resultsPath, collector.results))
+	{
+		return 1;
+	}
+
+	if (!baselinePath.empty())
+	{
+		return compareToBaseline(baselinePath, collector.results, threshold);
+	}
+
+	return 0;
+}
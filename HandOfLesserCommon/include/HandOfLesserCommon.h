@@ -2,9 +2,30 @@
 
 #include "src/transport/nativetransport.h"
 #include "src/packet/nativepacket.h"
+#include "src/packet/frame_bundle.h"
+#include "src/packet/packet_statistics.h"
+#include "src/packet/pose_codec.h"
+#include "src/packet/hand_skeleton.h"
+#include "src/packet/frame_timing.h"
+#include "src/packet/metrics_packet.h"
+#include "src/packet/change_detection.h"
+#include "src/packet/packet_view.h"
+#include "src/packet/packet_table.h"
+#include "src/input/input_id_table.h"
+#include "src/util/latest_value_mailbox.h"
+#include "src/util/snapshot_slot.h"
+#include "src/util/time_utils.h"
+#include "src/util/frame_scheduler.h"
+#include "src/util/trace.h"
+#include "src/util/metrics.h"
+#include "src/recording/recording_file.h"
 #include "src/hand/hand.h"
 #include "src//hand/finger_bend.h"
+#include "src/hand/hand_joints.h"
 #include "src/math/fingers.h"
+#include "src/math/finger_batch.h"
+#include "src/math/joint_angles.h"
+#include "src/math/one_euro_filter.h"
 #include "src/math/math_utils.h"
 #include "src/controller/controller.h"
 #include "src/settings/settings.h"
@@ -0,0 +1,118 @@
+#include "benchmark_results.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+namespace HOL
+{
+	static const char* BENCHMARK_RESULTS_HEADER = "# HandOfLesser benchmark results ";
+
+	bool writeBenchmarkResults(const std::string& path, const std::vector<BenchmarkResult>& results)
+	{
+		std::ofstream file(path);
+		if (!file)
+		{
+			std::cerr << "Failed to write benchmark results to " << path << std::endl;
+			return false;
+		}
+
+		file << BENCHMARK_RESULTS_HEADER << BENCHMARK_RESULTS_VERSION << "\n";
+		file.precision(6);
+		for (const BenchmarkResult& result : results)
+		{
+			file << result.name << "\t" << std::fixed << result.nanoseconds << "\t"
+				 << result.iterations << "\n";
+		}
+
+		return (bool)file;
+	}
+
+	bool readBenchmarkResults(const std::string& path, std::vector<BenchmarkResult>& results)
+	{
+		std::ifstream file(path);
+		if (!file)
+		{
+			std::cerr << "Failed to read benchmark results from " << path << std::endl;
+			return false;
+		}
+
+		std::string line;
+		if (!std::getline(file, line)
+			|| line != BENCHMARK_RESULTS_HEADER + std::to_string(BENCHMARK_RESULTS_VERSION))
+		{
+			std::cerr << path << " isn't benchmark results, or is from another version"
+					  << std::endl;
+			return false;
+		}
+
+		results.clear();
+		while (std::getline(file, line))
+		{
+			if (line.empty() || line[0] == '#')
+			{
+				continue;
+			}
+
+			// Names can have spaces in them, never tabs
+			std::istringstream stream(line);
+			BenchmarkResult result;
+			std::string nanoseconds;
+			std::string iterations;
+			char* nanosecondsEnd = nullptr;
+			char* iterationsEnd = nullptr;
+
+			if (std::getline(stream, result.name, '\t') && std::getline(stream, nanoseconds, '\t')
+				&& std::getline(stream, iterations))
+			{
+				result.nanoseconds = strtod(nanoseconds.c_str(), &nanosecondsEnd);
+				result.iterations = strtoull(iterations.c_str(), &iterationsEnd, 10);
+			}
+
+			if (nanosecondsEnd == nullptr || *nanosecondsEnd != 0 || nanoseconds.empty()
+				|| iterationsEnd == nullptr || *iterationsEnd != 0 || iterations.empty())
+			{
+				std::cerr << "Bad line in " << path << ": " << line << std::endl;
+				return false;
+			}
+
+			results.push_back(result);
+		}
+
+		return true;
+	}
+
+	std::vector<BenchmarkComparison> compareBenchmarkResults(
+		const std::vector<BenchmarkResult>& baseline,
+		const std::vector<BenchmarkResult>& current,
+		float thresholdPercent)
+	{
+		std::unordered_map<std::string, double> baselineTimes;
+		for (const BenchmarkResult& result : baseline)
+		{
+			baselineTimes[result.name] = result.nanoseconds;
+		}
+
+		std::vector<BenchmarkComparison> comparisons;
+		for (const BenchmarkResult& result : current)
+		{
+			auto found = baselineTimes.find(result.name);
+			if (found == baselineTimes.end() || found->second <= 0)
+			{
+				continue; // New, nothing to compare to
+			}
+
+			BenchmarkComparison comparison;
+			comparison.name = result.name;
+			comparison.baseline = found->second;
+			comparison.current = result.nanoseconds;
+			comparison.change = (float)((result.nanoseconds / found->second - 1.0) * 100.0);
+			comparison.regressed = comparison.change > thresholdPercent;
+			comparisons.push_back(comparison);
+		}
+
+		return comparisons;
+	}
+} // namespace HOL
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HOL
+{
+	// One line per benchmark, tab separated, so results diff nicely when they're committed:
+	//   # HandOfLesser benchmark results 1
+	//   <name>	<cpu ns per iteration>	<iterations>
+	// Lines starting with # are comments, the first one says which version this is.
+	static const int BENCHMARK_RESULTS_VERSION = 1;
+
+	struct BenchmarkResult
+	{
+		std::string name;
+		double nanoseconds = 0; // CPU time per iteration
+		uint64_t iterations = 0;
+	};
+
+	struct BenchmarkComparison
+	{
+		std::string name;
+		double baseline = 0;
+		double current = 0;
+		float change = 0; // Percent, positive is slower
+		bool regressed = false;
+	};
+
+	bool writeBenchmarkResults(const std::string& path, const std::vector<BenchmarkResult>& results);
+	bool readBenchmarkResults(const std::string& path, std::vector<BenchmarkResult>& results);
+
+	// Only benchmarks in both are compared, in the order they are in current.
+	// Anything more than thresholdPercent slower than the baseline regressed.
+	std::vector<BenchmarkComparison> compareBenchmarkResults(
+		const std::vector<BenchmarkResult>& baseline,
+		const std::vector<BenchmarkResult>& current,
+		float thresholdPercent);
+} // namespace HOL
@@ -1,6 +1,6 @@
 #include "finger_bend.h"
 
-float HOL::FingerBend::getCurlSum()
+float HOL::FingerBend::getCurlSum() const
 {
 	float sum = 0;
 	for (int i = 0; i < 3; i++)
@@ -11,7 +11,7 @@ float HOL::FingerBend::getCurlSum()
 	return sum;
 }
 
-float HOL::FingerBend::getCurlSumWithoutDistal()
+float HOL::FingerBend::getCurlSumWithoutDistal() const
 {
 	float sum = 0;
 	for (int i = 0; i < 2; i++)
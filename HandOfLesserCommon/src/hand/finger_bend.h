@@ -7,8 +7,8 @@ namespace HOL
 	struct FingerBend
 	{
 		float bend[FingerBendType::FingerBendType_MAX];
-		float getCurlSum();
-		float getCurlSumWithoutDistal();
+		float getCurlSum() const;
+		float getCurlSumWithoutDistal() const;
 		void setSplay(float humanoidSplay);
 	};
 } // namespace HOL
@@ -0,0 +1,36 @@
+#include "hand_joints.h"
+
+namespace HOL
+{
+	void HandJoints::setJoint(int joint,
+							  const Eigen::Vector3f& position,
+							  const Eigen::Quaternionf& orientation,
+							  float radius,
+							  bool valid,
+							  bool tracked)
+	{
+		this->setJointPose(joint, position, orientation);
+		this->radii[joint] = radius;
+
+		uint32_t bit = 1u << joint;
+		this->validJoints = valid ? (this->validJoints | bit) : (this->validJoints & ~bit);
+		this->trackedJoints = tracked ? (this->trackedJoints | bit) : (this->trackedJoints & ~bit);
+	}
+
+	void HandJoints::setJointPose(int joint,
+								  const Eigen::Vector3f& position,
+								  const Eigen::Quaternionf& orientation)
+	{
+		float* jointPosition = &this->positions[joint * 4];
+		jointPosition[0] = position.x();
+		jointPosition[1] = position.y();
+		jointPosition[2] = position.z();
+		jointPosition[3] = 0;
+
+		float* jointOrientation = &this->orientations[joint * 4];
+		jointOrientation[0] = orientation.x();
+		jointOrientation[1] = orientation.y();
+		jointOrientation[2] = orientation.z();
+		jointOrientation[3] = orientation.w();
+	}
+} // namespace HOL
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+namespace HOL
+{
+	// Same joints in the same order as XrHandJointEXT, palm first
+	static const int HAND_JOINT_COUNT = 26;
+
+	using JointPosition = Eigen::Map<const Eigen::Vector3f, Eigen::Aligned16>;
+	using JointOrientation = Eigen::Map<const Eigen::Quaternionf, Eigen::Aligned16>;
+
+	// One hand's joints, converted from whatever the runtime gave us once per frame so
+	// nothing downstream has to. One array per attribute, each joint padded to 4 floats so it
+	// starts on a 16 byte boundary and can be read in place rather than copied out.
+	struct HandJoints
+	{
+		alignas(16) float positions[HAND_JOINT_COUNT * 4] = {};	// x, y, z, unused
+		alignas(16) float orientations[HAND_JOINT_COUNT * 4] = {}; // x, y, z, w like Eigen
+		float radii[HAND_JOINT_COUNT] = {};
+
+		uint32_t validJoints = 0;	// Bit per joint, both position and orientation valid
+		uint32_t trackedJoints = 0; // Same, but actually tracked rather than inferred
+
+		JointPosition position(int joint) const
+		{
+			return JointPosition(&this->positions[joint * 4]);
+		}
+
+		JointOrientation orientation(int joint) const
+		{
+			return JointOrientation(&this->orientations[joint * 4]);
+		}
+
+		float radius(int joint) const
+		{
+			return this->radii[joint];
+		}
+
+		bool isValid(int joint) const
+		{
+			return (this->validJoints & (1u << joint)) != 0;
+		}
+
+		void setJoint(int joint,
+					  const Eigen::Vector3f& position,
+					  const Eigen::Quaternionf& orientation,
+					  float radius,
+					  bool valid,
+					  bool tracked);
+
+		// Moves a joint without touching its radius or flags
+		void setJointPose(int joint,
+						  const Eigen::Vector3f& position,
+						  const Eigen::Quaternionf& orientation);
+	};
+} // namespace HOL
@@ -0,0 +1,124 @@
+#include "input_id_table.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace HOL
+{
+	uint16_t InputIdTable::intern(const std::string& inputName)
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+
+		auto existing = this->mIds.find(inputName);
+		if (existing != this->mIds.end())
+		{
+			return existing->second;
+		}
+
+		// Names longer than what fits in the packet would never match on the other end
+		if (this->mNames.size() >= MAX_INPUT_IDS || inputName.size() >= INPUT_NAME_LENGTH)
+		{
+			return INVALID_INPUT_ID;
+		}
+
+		uint16_t id = (uint16_t)this->mNames.size();
+		this->mNames.push_back(inputName);
+		this->mIds[inputName] = id;
+
+		return id;
+	}
+
+	uint16_t InputIdTable::find(const std::string& inputName)
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+
+		auto existing = this->mIds.find(inputName);
+		if (existing != this->mIds.end())
+		{
+			return existing->second;
+		}
+
+		return INVALID_INPUT_ID;
+	}
+
+	void InputIdTable::clear(uint32_t generation)
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+
+		this->mGeneration = generation;
+		this->mNames.clear();
+		this->mIds.clear();
+	}
+
+	uint32_t InputIdTable::getGeneration()
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+		return this->mGeneration;
+	}
+
+	uint16_t InputIdTable::size()
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+		return (uint16_t)this->mNames.size();
+	}
+
+	uint16_t InputIdTable::writePage(uint16_t firstId, InputIdTablePacket* packet)
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+
+		uint16_t total = (uint16_t)this->mNames.size();
+		uint16_t count = 0;
+		if (firstId < total)
+		{
+			count = std::min<uint16_t>(INPUT_ID_TABLE_PAGE_SIZE, total - firstId);
+		}
+
+		packet->generation = this->mGeneration;
+		packet->firstId = firstId;
+		packet->count = count;
+		packet->totalCount = total;
+
+		for (uint16_t i = 0; i < count; i++)
+		{
+			std::strncpy(packet->inputNames[i], this->mNames[firstId + i].c_str(), INPUT_NAME_LENGTH);
+		}
+
+		return count;
+	}
+
+	void InputIdTable::readPage(const InputIdTablePacket* packet)
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+
+		// Driver restarted, everything we know is wrong now.
+		if (packet->generation != this->mGeneration)
+		{
+			this->mGeneration = packet->generation;
+			this->mNames.clear();
+			this->mIds.clear();
+		}
+
+		uint16_t count = std::min<uint16_t>(packet->count, INPUT_ID_TABLE_PAGE_SIZE);
+		for (uint16_t i = 0; i < count; i++)
+		{
+			uint16_t id = packet->firstId + i;
+			if (id >= MAX_INPUT_IDS)
+			{
+				break;
+			}
+
+			// Don't trust the terminator
+			std::string name(packet->inputNames[i],
+							 strnlen(packet->inputNames[i], INPUT_NAME_LENGTH));
+
+			if (this->mNames.size() <= id)
+			{
+				this->mNames.resize(id + 1);
+			}
+
+			this->mNames[id] = name;
+			this->mIds[name] = id;
+		}
+	}
+
+} // namespace HOL
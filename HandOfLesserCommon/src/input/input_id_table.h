@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "src/packet/nativepacket.h"
+
+namespace HOL
+{
+	static const uint16_t INVALID_INPUT_ID = 0xFFFF;
+
+	// Fixed upper bound so the driver can index handles with a plain array
+	static const uint16_t MAX_INPUT_IDS = 256;
+
+	// Maps input paths ( /input/trigger/value etc. ) to small ids so we don't have to send
+	// or look up strings for every input. The driver owns the table and interns names as
+	// components are created, the app fills in its copy from InputIdTablePackets.
+	// Lookups lock, but neither side does them per-packet anymore.
+	class InputIdTable
+	{
+	public:
+		uint16_t intern(const std::string& inputName);
+		uint16_t find(const std::string& inputName);
+		void clear(uint32_t generation = 0);
+
+		uint32_t getGeneration();
+		uint16_t size();
+
+		// Returns how many names were written, 0 once firstId is past the end
+		uint16_t writePage(uint16_t firstId, InputIdTablePacket* packet);
+		void readPage(const InputIdTablePacket* packet);
+
+	private:
+		std::mutex mMutex;
+		uint32_t mGeneration = 0;
+		std::vector<std::string> mNames;
+		std::unordered_map<std::string, uint16_t> mIds;
+	};
+
+} // namespace HOL
@@ -0,0 +1,414 @@
+#include "finger_batch.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numbers>
+
+#if defined(__AVX__)
+#define HOL_FINGER_BATCH_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HOL_FINGER_BATCH_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define HOL_FINGER_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace HOL
+{
+	// Just enough of a float vector for the kernel below, one per instruction set.
+	// Masks are lanes too, all bits set where the comparison held.
+	namespace
+	{
+#if defined(HOL_FINGER_BATCH_AVX)
+		static const int LANE_WIDTH = 8;
+
+		struct Lanes
+		{
+			__m256 v;
+		};
+
+		inline Lanes load(const float* values)
+		{
+			return {_mm256_load_ps(values)};
+		}
+
+		inline void store(float* values, Lanes a)
+		{
+			_mm256_store_ps(values, a.v);
+		}
+
+		inline Lanes splat(float value)
+		{
+			return {_mm256_set1_ps(value)};
+		}
+
+		inline Lanes operator+(Lanes a, Lanes b)
+		{
+			return {_mm256_add_ps(a.v, b.v)};
+		}
+
+		inline Lanes operator-(Lanes a, Lanes b)
+		{
+			return {_mm256_sub_ps(a.v, b.v)};
+		}
+
+		inline Lanes operator*(Lanes a, Lanes b)
+		{
+			return {_mm256_mul_ps(a.v, b.v)};
+		}
+
+		inline Lanes operator/(Lanes a, Lanes b)
+		{
+			return {_mm256_div_ps(a.v, b.v)};
+		}
+
+		inline Lanes min(Lanes a, Lanes b)
+		{
+			return {_mm256_min_ps(a.v, b.v)};
+		}
+
+		inline Lanes max(Lanes a, Lanes b)
+		{
+			return {_mm256_max_ps(a.v, b.v)};
+		}
+
+		inline Lanes abs(Lanes a)
+		{
+			return {_mm256_andnot_ps(_mm256_set1_ps(-0.f), a.v)};
+		}
+
+		inline Lanes sqrt(Lanes a)
+		{
+			return {_mm256_sqrt_ps(a.v)};
+		}
+
+		inline Lanes greater(Lanes a, Lanes b)
+		{
+			return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)};
+		}
+
+		inline Lanes select(Lanes mask, Lanes a, Lanes b)
+		{
+			return {_mm256_blendv_ps(b.v, a.v, mask.v)};
+		}
+
+		static const char* LANE_BACKEND = "AVX";
+#elif defined(HOL_FINGER_BATCH_SSE2)
+		static const int LANE_WIDTH = 4;
+
+		struct Lanes
+		{
+			__m128 v;
+		};
+
+		inline Lanes load(const float* values)
+		{
+			return {_mm_load_ps(values)};
+		}
+
+		inline void store(float* values, Lanes a)
+		{
+			_mm_store_ps(values, a.v);
+		}
+
+		inline Lanes splat(float value)
+		{
+			return {_mm_set1_ps(value)};
+		}
+
+		inline Lanes operator+(Lanes a, Lanes b)
+		{
+			return {_mm_add_ps(a.v, b.v)};
+		}
+
+		inline Lanes operator-(Lanes a, Lanes b)
+		{
+			return {_mm_sub_ps(a.v, b.v)};
+		}
+
+		inline Lanes operator*(Lanes a, Lanes b)
+		{
+			return {_mm_mul_ps(a.v, b.v)};
+		}
+
+		inline Lanes operator/(Lanes a, Lanes b)
+		{
+			return {_mm_div_ps(a.v, b.v)};
+		}
+
+		inline Lanes min(Lanes a, Lanes b)
+		{
+			return {_mm_min_ps(a.v, b.v)};
+		}
+
+		inline Lanes max(Lanes a, Lanes b)
+		{
+			return {_mm_max_ps(a.v, b.v)};
+		}
+
+		inline Lanes abs(Lanes a)
+		{
+			return {_mm_andnot_ps(_mm_set1_ps(-0.f), a.v)};
+		}
+
+		inline Lanes sqrt(Lanes a)
+		{
+			return {_mm_sqrt_ps(a.v)};
+		}
+
+		inline Lanes greater(Lanes a, Lanes b)
+		{
+			return {_mm_cmpgt_ps(a.v, b.v)};
+		}
+
+		// No blendv before SSE4.1
+		inline Lanes select(Lanes mask, Lanes a, Lanes b)
+		{
+			return {_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))};
+		}
+
+		static const char* LANE_BACKEND = "SSE2";
+#elif defined(HOL_FINGER_BATCH_NEON)
+		static const int LANE_WIDTH = 4;
+
+		struct Lanes
+		{
+			float32x4_t v;
+		};
+
+		inline Lanes load(const float* values)
+		{
+			return {vld1q_f32(values)};
+		}
+
+		inline void store(float* values, Lanes a)
+		{
+			vst1q_f32(values, a.v);
+		}
+
+		inline Lanes splat(float value)
+		{
+			return {vdupq_n_f32(value)};
+		}
+
+		inline Lanes operator+(Lanes a, Lanes b)
+		{
+			return {vaddq_f32(a.v, b.v)};
+		}
+
+		inline Lanes operator-(Lanes a, Lanes b)
+		{
+			return {vsubq_f32(a.v, b.v)};
+		}
+
+		inline Lanes operator*(Lanes a, Lanes b)
+		{
+			return {vmulq_f32(a.v, b.v)};
+		}
+
+		inline Lanes operator/(Lanes a, Lanes b)
+		{
+			return {vdivq_f32(a.v, b.v)};
+		}
+
+		inline Lanes min(Lanes a, Lanes b)
+		{
+			return {vminq_f32(a.v, b.v)};
+		}
+
+		inline Lanes max(Lanes a, Lanes b)
+		{
+			return {vmaxq_f32(a.v, b.v)};
+		}
+
+		inline Lanes abs(Lanes a)
+		{
+			return {vabsq_f32(a.v)};
+		}
+
+		inline Lanes sqrt(Lanes a)
+		{
+			return {vsqrtq_f32(a.v)};
+		}
+
+		inline Lanes greater(Lanes a, Lanes b)
+		{
+			return {vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v))};
+		}
+
+		inline Lanes select(Lanes mask, Lanes a, Lanes b)
+		{
+			return {vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v)};
+		}
+
+		static const char* LANE_BACKEND = "NEON";
+#else
+		static const int LANE_WIDTH = 1;
+
+		struct Lanes
+		{
+			float v;
+		};
+
+		inline Lanes load(const float* values)
+		{
+			return {*values};
+		}
+
+		inline void store(float* values, Lanes a)
+		{
+			*values = a.v;
+		}
+
+		inline Lanes splat(float value)
+		{
+			return {value};
+		}
+
+		inline Lanes operator+(Lanes a, Lanes b)
+		{
+			return {a.v + b.v};
+		}
+
+		inline Lanes operator-(Lanes a, Lanes b)
+		{
+			return {a.v - b.v};
+		}
+
+		inline Lanes operator*(Lanes a, Lanes b)
+		{
+			return {a.v * b.v};
+		}
+
+		inline Lanes operator/(Lanes a, Lanes b)
+		{
+			return {a.v / b.v};
+		}
+
+		inline Lanes min(Lanes a, Lanes b)
+		{
+			return {std::min(a.v, b.v)};
+		}
+
+		inline Lanes max(Lanes a, Lanes b)
+		{
+			return {std::max(a.v, b.v)};
+		}
+
+		inline Lanes abs(Lanes a)
+		{
+			return {std::abs(a.v)};
+		}
+
+		inline Lanes sqrt(Lanes a)
+		{
+			return {std::sqrt(a.v)};
+		}
+
+		// Only ever fed to select(), so a bool is as good as a mask
+		inline Lanes greater(Lanes a, Lanes b)
+		{
+			return {a.v > b.v ? 1.f : 0.f};
+		}
+
+		inline Lanes select(Lanes mask, Lanes a, Lanes b)
+		{
+			return mask.v != 0 ? a : b;
+		}
+
+		static const char* LANE_BACKEND = "Scalar";
+#endif
+
+		static_assert(FINGER_BATCH_PAIRS % LANE_WIDTH == 0, "Batch must be whole lanes");
+
+		// Cephes' atanf, folded down to [0, tan(pi/8)] first. Within a couple of ulp
+		// of std::atan2 everywhere except atan2(0, 0), which is 0 either way.
+		inline Lanes atan2(Lanes y, Lanes x)
+		{
+			const float pi = std::numbers::pi_v<float>;
+			const Lanes zero = splat(0.f);
+			Lanes absY = abs(y);
+			Lanes absX = abs(x);
+
+			Lanes t = min(absY, absX) / max(max(absY, absX), splat(FLT_MIN));
+
+			Lanes folded = greater(t, splat(0.41421356f)); // tan(pi/8)
+			t = select(folded, (t - splat(1.f)) / (t + splat(1.f)), t);
+
+			Lanes z = t * t;
+			Lanes polynomial = splat(8.05374449538e-2f);
+			polynomial = polynomial * z - splat(1.38776856032e-1f);
+			polynomial = polynomial * z + splat(1.99777106478e-1f);
+			polynomial = polynomial * z - splat(3.33329491539e-1f);
+
+			Lanes angle = polynomial * z * t + t;
+			angle = select(folded, angle + splat(pi / 4), angle);
+
+			// Back out to the octant and quadrant we started in
+			angle = select(greater(absY, absX), splat(pi / 2) - angle, angle);
+			angle = select(greater(zero, x), splat(pi) - angle, angle);
+			return select(greater(zero, y), zero - angle, angle);
+		}
+	} // namespace
+
+	int FingerBatch::add(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next)
+	{
+		if (this->count >= FINGER_BATCH_PAIRS)
+		{
+			return -1;
+		}
+
+		int index = this->count++;
+		this->previousW[index] = previous.w();
+		this->previousX[index] = previous.x();
+		this->previousY[index] = previous.y();
+		this->previousZ[index] = previous.z();
+		this->nextW[index] = next.w();
+		this->nextX[index] = next.x();
+		this->nextY[index] = next.y();
+		this->nextZ[index] = next.z();
+		return index;
+	}
+
+	void computeCurlSplayBatch(FingerBatch& batch)
+	{
+		const Lanes zero = splat(0.f);
+		const Lanes two = splat(2.f);
+
+		for (int i = 0; i < batch.count; i += LANE_WIDTH)
+		{
+			Lanes pw = load(&batch.previousW[i]);
+			Lanes px = load(&batch.previousX[i]);
+			Lanes py = load(&batch.previousY[i]);
+			Lanes pz = load(&batch.previousZ[i]);
+			Lanes nw = load(&batch.nextW[i]);
+			Lanes nx = load(&batch.nextX[i]);
+			Lanes ny = load(&batch.nextY[i]);
+			Lanes nz = load(&batch.nextZ[i]);
+
+			// computeRelativeRotation()
+			Lanes w = pw * nw + px * nx + py * ny + pz * nz;
+			Lanes x = pw * nx - px * nw - py * nz + pz * ny;
+			Lanes y = pw * ny + px * nz - py * nw - pz * nx;
+			Lanes z = pw * nz - px * ny + py * nx - pz * nw;
+
+			// Twist about X, see computeTwistAngle()
+			Lanes flip = greater(zero, w);
+			store(&batch.curl[i], two * atan2(select(flip, zero - x, x), abs(w)));
+
+			// Where X ends up, see computeJointSplay()
+			Lanes forward = w * w + x * x - y * y - z * z;
+			Lanes side = two * (x * y + w * z);
+			Lanes up = two * (w * y - x * z);
+			store(&batch.splay[i], atan2(up, sqrt(forward * forward + side * side)));
+		}
+	}
+
+	const char* getFingerBatchBackend()
+	{
+		return LANE_BACKEND;
+	}
+} // namespace HOL
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+namespace HOL
+{
+	// 5 fingers of 3 joint pairs per hand. Both hands fit in one batch, rounded up to
+	// a multiple of the widest SIMD width so the kernel never needs a scalar tail.
+	static const int FINGER_BATCH_HAND_PAIRS = 15;
+	static const int FINGER_BATCH_PAIRS = 32;
+
+	// Joint pairs laid out one component per array, so the kernel can load a lane's worth
+	// of each straight from memory. Lanes past count are still computed, just never read.
+	struct FingerBatch
+	{
+		alignas(32) float previousW[FINGER_BATCH_PAIRS] = {};
+		alignas(32) float previousX[FINGER_BATCH_PAIRS] = {};
+		alignas(32) float previousY[FINGER_BATCH_PAIRS] = {};
+		alignas(32) float previousZ[FINGER_BATCH_PAIRS] = {};
+		alignas(32) float nextW[FINGER_BATCH_PAIRS] = {};
+		alignas(32) float nextX[FINGER_BATCH_PAIRS] = {};
+		alignas(32) float nextY[FINGER_BATCH_PAIRS] = {};
+		alignas(32) float nextZ[FINGER_BATCH_PAIRS] = {};
+
+		// Same as computeJointCurl() and computeJointSplay() on each pair
+		alignas(32) float curl[FINGER_BATCH_PAIRS] = {};
+		alignas(32) float splay[FINGER_BATCH_PAIRS] = {};
+
+		int count = 0;
+
+		// Appends a pair and returns its index, or -1 if the batch is full
+		int add(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next);
+	};
+
+	// Relative rotation and both angles, several pairs at a time. Matches the scalar
+	// functions to within a few microradians.
+	void computeCurlSplayBatch(FingerBatch& batch);
+
+	// "AVX", "SSE2", "NEON" or "Scalar", whichever this was built with
+	const char* getFingerBatchBackend();
+} // namespace HOL
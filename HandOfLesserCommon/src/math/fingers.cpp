@@ -2,6 +2,7 @@
 
 #include <numbers>
 
+#include "joint_angles.h"
 #include "math_utils.h"
 
 #include <Eigen/Core>
@@ -17,47 +18,25 @@ namespace HOL
 		return acos(dotProduct / length);
 	}
 
+	// Both are twists of the joint's rotation relative to the previous one, see joint_angles.h
 	float computeCurl(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next)
 	{
-		Eigen::Quaternionf localRot = previous.inverse() * next;
-		Eigen::Vector3f euler = localRot.toRotationMatrix().canonicalEulerAngles(0, 1, 2);
-		return euler.x();
+		return computeJointCurl(previous, next);
 	}
 
-	// Would return the actual roll of the joint ( z axie before curl ), but is unused 
-	// at the moment because we're dealing with unity humanoid garbage instead.
-	// This is probably not correct, though it looks vaguely correctish.
 	float computeSplay(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next)
 	{
-		
-		Eigen::Quaternionf localRot = previous.inverse() * next;
-		Eigen::Vector3f euler = localRot.toRotationMatrix().canonicalEulerAngles(2, 1, 0);
-		return euler.y();
+		return computeJointSplay(previous, next);
 	}
 
 	// Creates a plane defined by palmOrientation and knucklePosition, returns angle between
 	// tip position and its closest point on the plane. This emulates how Humanoid spread works.
+	// Treat as negative rotation if above 0.
 	float computeHumanoidSplay(const Eigen::Quaternionf& palmOrientation,
 							   const Eigen::Vector3f& knuclePosition,
 							   const Eigen::Vector3f& tipPosition)
 	{
-		Eigen::Vector3f tipLocal = palmOrientation.inverse() * (tipPosition - knuclePosition);
-		Eigen::Vector3f xPlane = Eigen::Vector3f(1, 0, 0); // Plane defined by x axis
-
-		// Project tip onto plane
-		float planeDot = tipLocal.dot(xPlane); // distance from plane
-		Eigen::Vector3f forwardProjected = tipLocal - (xPlane * planeDot);
-		forwardProjected.normalize();	// Don't really need this do we
-
-		// Splay is the angle between original and projected
-		// Treat as negative rotation if above 0
-		float splay = computeAngleBetweenVectors(forwardProjected, tipLocal);
-		if (planeDot > 0)
-		{
-			splay *= -1.f;
-		}
-
-		return splay;
+		return computeJointHumanoidSplay(palmOrientation, knuclePosition, tipPosition);
 	}
 
 	float mapCurlToSteamVR(float curlInRadians, float maxCurlRadians)
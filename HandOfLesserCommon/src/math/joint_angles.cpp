@@ -0,0 +1,58 @@
+#include "joint_angles.h"
+
+#include <cmath>
+
+namespace HOL
+{
+	float computeTwistAngle(const Eigen::Quaternionf& rotation, int axis)
+	{
+		// Projecting the vector part onto the axis gives the twist quaternion, unnormalized.
+		// q and -q are the same rotation, keep w positive so the angle stays within +-pi.
+		float twist = rotation.vec()[axis];
+		float w = rotation.w();
+		if (w < 0)
+		{
+			twist = -twist;
+			w = -w;
+		}
+
+		return 2.f * std::atan2(twist, w);
+	}
+
+	Eigen::Quaternionf computeRelativeRotation(const Eigen::Quaternionf& previous,
+											   const Eigen::Quaternionf& next)
+	{
+		return previous.conjugate() * next;
+	}
+
+	float computeJointCurl(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next)
+	{
+		return computeTwistAngle(computeRelativeRotation(previous, next), 0);
+	}
+
+	float computeJointSplay(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next)
+	{
+		Eigen::Quaternionf rotation = computeRelativeRotation(previous, next);
+		float w = rotation.w();
+		float x = rotation.x();
+		float y = rotation.y();
+		float z = rotation.z();
+
+		// Where X ends up, all scaled by the squared norm so it doesn't need normalizing
+		float forward = w * w + x * x - y * y - z * z;
+		float side = 2.f * (x * y + w * z);
+		float up = 2.f * (w * y - x * z);
+
+		return std::atan2(up, std::hypot(forward, side));
+	}
+
+	float computeJointHumanoidSplay(const Eigen::Quaternionf& palmOrientation,
+									const Eigen::Vector3f& knucklePosition,
+									const Eigen::Vector3f& tipPosition)
+	{
+		Eigen::Vector3f tipLocal = palmOrientation.conjugate() * (tipPosition - knucklePosition);
+
+		// Distance from the plane against distance along it
+		return std::atan2(-tipLocal.x(), std::hypot(tipLocal.y(), tipLocal.z()));
+	}
+} // namespace HOL
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+namespace HOL
+{
+	// Angle of the twist part of a swing-twist decomposition, the rotation about the given
+	// axis (0 for X, 1 for Y, 2 for Z) once everything perpendicular to it is taken out.
+	// One atan2 straight off the quaternion, which doesn't need to be normalized.
+	float computeTwistAngle(const Eigen::Quaternionf& rotation, int axis);
+
+	// Rotation of next in previous' space, previous.inverse() * next for unit quaternions
+	Eigen::Quaternionf computeRelativeRotation(const Eigen::Quaternionf& previous,
+											   const Eigen::Quaternionf& next);
+
+	// Twist about X. Same as the X of an XYZ euler decomposition if the joint only bends about
+	// X and one other axis, and within a few hundredths of a radian over what fingers can do.
+	// Unlike euler angles it still makes sense once the joint swings past 90 degrees.
+	float computeJointCurl(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next);
+
+	// How far the swing tilts the joint's X axis out of the XY plane, positive towards -Z.
+	// Twisting about X doesn't move X, so curl never leaks in. Same as the Y of a ZYX euler
+	// decomposition.
+	float computeJointSplay(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next);
+
+	// Angle between the knuckle-to-tip vector and the palm's YZ plane, negative when the
+	// tip is on the +X side. Same as projecting onto the plane and taking the acos.
+	float computeJointHumanoidSplay(const Eigen::Quaternionf& palmOrientation,
+									const Eigen::Vector3f& knucklePosition,
+									const Eigen::Vector3f& tipPosition);
+} // namespace HOL
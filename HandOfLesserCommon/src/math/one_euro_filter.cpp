@@ -0,0 +1,179 @@
+#include "one_euro_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace HOL
+{
+	float computeOneEuroAlpha(float cutoffHz, float deltaTime)
+	{
+		float rate = 2.f * std::numbers::pi_v<float> * cutoffHz * deltaTime;
+		return rate / (rate + 1.f);
+	}
+
+	void filterOneEuro(float* values,
+					   float* filtered,
+					   float* speeds,
+					   int count,
+					   float deltaTime,
+					   const OneEuroParameters& parameters)
+	{
+		const float derivativeAlpha
+			= computeOneEuroAlpha(parameters.derivativeCutoffHz, deltaTime);
+		const float rateScale = 2.f * std::numbers::pi_v<float> * deltaTime;
+		const float inverseDeltaTime = 1.f / deltaTime;
+
+		for (int i = 0; i < count; i++)
+		{
+			float difference = values[i] - filtered[i];
+			speeds[i] += derivativeAlpha * (difference * inverseDeltaTime - speeds[i]);
+
+			float cutoff = parameters.minCutoffHz + parameters.beta * std::abs(speeds[i]);
+			float rate = rateScale * cutoff;
+			filtered[i] += difference * (rate / (rate + 1.f));
+			values[i] = filtered[i];
+		}
+	}
+
+	void HandJointFilter::filter(HandJoints& joints,
+								 float deltaTime,
+								 const OneEuroParameters& position,
+								 const OneEuroParameters& rotation)
+	{
+		if (!this->mPrimed || deltaTime <= 0)
+		{
+			std::copy(std::begin(joints.positions), std::end(joints.positions), this->mPositions);
+			std::copy(std::begin(joints.orientations),
+					  std::end(joints.orientations),
+					  this->mOrientations);
+			std::fill(std::begin(this->mPositionSpeeds), std::end(this->mPositionSpeeds), 0.f);
+			std::fill(
+				std::begin(this->mOrientationSpeeds), std::end(this->mOrientationSpeeds), 0.f);
+			this->mPrimed = true;
+			return;
+		}
+
+		for (int joint = 0; joint < HAND_JOINT_COUNT; joint++)
+		{
+			float* orientation = &joints.orientations[joint * 4];
+			const float* previous = &this->mOrientations[joint * 4];
+
+			if (!joints.isValid(joint))
+			{
+				// Filtering towards whatever the runtime left there would drag the joint off
+				std::copy(&this->mPositions[joint * 4],
+						  &this->mPositions[joint * 4] + 4,
+						  &joints.positions[joint * 4]);
+				std::copy(previous, previous + 4, orientation);
+				continue;
+			}
+
+			// q and -q are the same rotation, but averaging them gives nothing
+			float dot = orientation[0] * previous[0] + orientation[1] * previous[1]
+						+ orientation[2] * previous[2] + orientation[3] * previous[3];
+			if (dot < 0)
+			{
+				for (int i = 0; i < 4; i++)
+				{
+					orientation[i] = -orientation[i];
+				}
+			}
+		}
+
+		filterOneEuro(joints.positions,
+					  this->mPositions,
+					  this->mPositionSpeeds,
+					  HAND_JOINT_COUNT * 4,
+					  deltaTime,
+					  position);
+		filterOneEuro(joints.orientations,
+					  this->mOrientations,
+					  this->mOrientationSpeeds,
+					  HAND_JOINT_COUNT * 4,
+					  deltaTime,
+					  rotation);
+
+		// Smoothing shortens the quaternions a little, put them back on the unit sphere
+		for (int joint = 0; joint < HAND_JOINT_COUNT; joint++)
+		{
+			float* orientation = &joints.orientations[joint * 4];
+			float norm = std::sqrt(orientation[0] * orientation[0] + orientation[1] * orientation[1]
+								   + orientation[2] * orientation[2]
+								   + orientation[3] * orientation[3]);
+			if (norm > 0)
+			{
+				for (int i = 0; i < 4; i++)
+				{
+					orientation[i] /= norm;
+					this->mOrientations[joint * 4 + i] = orientation[i];
+				}
+			}
+		}
+	}
+
+	void HandJointFilter::repeat(HandJoints& joints) const
+	{
+		if (!this->mPrimed)
+		{
+			return;
+		}
+
+		std::copy(std::begin(this->mPositions), std::end(this->mPositions), joints.positions);
+		std::copy(
+			std::begin(this->mOrientations), std::end(this->mOrientations), joints.orientations);
+	}
+
+	void HandJointFilter::reset()
+	{
+		this->mPrimed = false;
+	}
+
+	PoseLocation PoseFilter::filter(const PoseLocation& pose,
+									float deltaTime,
+									const OneEuroParameters& position,
+									const OneEuroParameters& rotation)
+	{
+		if (!this->mPrimed || deltaTime <= 0)
+		{
+			this->mPose = pose;
+			this->mRawPose = pose;
+			this->mVelocity.linearVelocity = Eigen::Vector3f::Zero();
+			this->mVelocity.angularVelocity = Eigen::Vector3f::Zero();
+			this->mPrimed = true;
+			return this->mPose;
+		}
+
+		// Same as filterOneEuro(), but the cutoff follows the speed of the whole vector
+		Eigen::Vector3f& linearVelocity = this->mVelocity.linearVelocity;
+		Eigen::Vector3f rawLinearVelocity = (pose.position - this->mRawPose.position) / deltaTime;
+		linearVelocity += computeOneEuroAlpha(position.derivativeCutoffHz, deltaTime)
+						  * (rawLinearVelocity - linearVelocity);
+
+		float positionCutoff = position.minCutoffHz + position.beta * linearVelocity.norm();
+		this->mPose.position += computeOneEuroAlpha(positionCutoff, deltaTime)
+								* (pose.position - this->mPose.position);
+
+		// The rotation since the last sample, as a rate. Never more than half a turn, Eigen
+		// picks the short way round.
+		Eigen::AngleAxisf delta(pose.orientation * this->mRawPose.orientation.conjugate());
+		Eigen::Vector3f& angularVelocity = this->mVelocity.angularVelocity;
+		Eigen::Vector3f rawAngularVelocity = delta.axis() * (delta.angle() / deltaTime);
+		angularVelocity += computeOneEuroAlpha(rotation.derivativeCutoffHz, deltaTime)
+						   * (rawAngularVelocity - angularVelocity);
+
+		float rotationCutoff = rotation.minCutoffHz + rotation.beta * angularVelocity.norm();
+		this->mPose.orientation
+			= this->mPose.orientation
+				  .slerp(computeOneEuroAlpha(rotationCutoff, deltaTime), pose.orientation)
+				  .normalized();
+
+		this->mRawPose = pose;
+		return this->mPose;
+	}
+
+	void PoseFilter::reset()
+	{
+		this->mPrimed = false;
+	}
+} // namespace HOL
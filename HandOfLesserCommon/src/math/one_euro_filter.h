@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include "src/hand/hand.h"
+#include "src/hand/hand_joints.h"
+
+namespace HOL
+{
+	// One-euro filter, a low-pass whose cutoff goes up with speed. Slow movement gets
+	// smoothed heavily, fast movement hardly lags. Cutoffs in Hz, beta in Hz per unit/s.
+	struct OneEuroParameters
+	{
+		float minCutoffHz = 1.f;
+		float beta = 0.f;
+		float derivativeCutoffHz = 1.f;
+	};
+
+	// Exponential smoothing factor of a first order low-pass at cutoffHz
+	float computeOneEuroAlpha(float cutoffHz, float deltaTime);
+
+	// Every value filtered on its own, count of them. values goes in raw and comes out
+	// filtered, filtered and speeds are the state carried between calls.
+	// No branches, so it vectorizes.
+	void filterOneEuro(float* values,
+					   float* filtered,
+					   float* speeds,
+					   int count,
+					   float deltaTime,
+					   const OneEuroParameters& parameters);
+
+	// Every joint of one hand, filtered in place. Orientations are filtered component-wise
+	// and renormalized, so rotation beta is per quaternion component per second, about half
+	// the angular speed. Joints that aren't valid hold their last filtered value.
+	class HandJointFilter
+	{
+	public:
+		// deltaTime is seconds since the last call. The first call, and any without time
+		// passing, only seeds the state.
+		void filter(HandJoints& joints,
+					float deltaTime,
+					const OneEuroParameters& position,
+					const OneEuroParameters& rotation);
+
+		// Puts the last filtered joints back, for frames where nothing new came in
+		void repeat(HandJoints& joints) const;
+
+		void reset();
+
+	private:
+		alignas(16) float mPositions[HAND_JOINT_COUNT * 4] = {};
+		alignas(16) float mPositionSpeeds[HAND_JOINT_COUNT * 4] = {};
+		alignas(16) float mOrientations[HAND_JOINT_COUNT * 4] = {};
+		alignas(16) float mOrientationSpeeds[HAND_JOINT_COUNT * 4] = {};
+		bool mPrimed = false;
+	};
+
+	// Same thing for a whole pose, on speed and angular speed in rad/s rather than per
+	// component, with the orientation slerped. Speeds come from consecutive raw samples rather
+	// than against the lagging output, so they double as velocities, and steadier ones than
+	// what the runtime reports.
+	class PoseFilter
+	{
+	public:
+		PoseLocation filter(const PoseLocation& pose,
+							float deltaTime,
+							const OneEuroParameters& position,
+							const OneEuroParameters& rotation);
+
+		const PoseLocation& getPose() const
+		{
+			return this->mPose;
+		}
+
+		// Angular velocity is in the same space as the pose, not local to it
+		const PoseVelocity& getVelocity() const
+		{
+			return this->mVelocity;
+		}
+
+		void reset();
+
+	private:
+		PoseLocation mPose;
+		PoseLocation mRawPose;
+		PoseVelocity mVelocity;
+		bool mPrimed = false;
+	};
+} // namespace HOL
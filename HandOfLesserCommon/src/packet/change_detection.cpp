@@ -0,0 +1,118 @@
+#include "change_detection.h"
+
+#include <cmath>
+
+namespace HOL
+{
+	// Velocity that would carry the pose past its dead-band within this long counts as a change,
+	// otherwise the driver keeps extrapolating with whatever it had when the hand stopped.
+	static const float VELOCITY_DEADBAND_SECONDS = 0.1f;
+
+	static bool keepAliveExpired(bool sent, int64_t lastSentTime, int64_t keepAlive, int64_t now)
+	{
+		return !sent || now - lastSentTime >= keepAlive;
+	}
+
+	bool DeadbandChannel::changed(float value, float threshold, int64_t keepAlive, int64_t now) const
+	{
+		return keepAliveExpired(this->mSent, this->mLastSentTime, keepAlive, now)
+			   || std::abs(value - this->mLastSent) > threshold;
+	}
+
+	void DeadbandChannel::sent(float value, int64_t now)
+	{
+		this->mLastSent = value;
+		this->mLastSentTime = now;
+		this->mSent = true;
+	}
+
+	void DeadbandChannel::reset()
+	{
+		this->mSent = false;
+	}
+
+	bool PoseChangeDetector::shouldSend(const HandTransformPacket& packet,
+										float positionThreshold,
+										float angleThreshold,
+										int64_t keepAlive,
+										int64_t now)
+	{
+		const HandTransformPacket& last = this->mLastSent;
+
+		bool changed = keepAliveExpired(this->mSent, this->mLastSentTime, keepAlive, now)
+					   || packet.active != last.active || packet.valid != last.valid
+					   || packet.stale != last.stale || packet.side != last.side;
+
+		if (!changed)
+		{
+			float moved = (packet.location.position - last.location.position).norm();
+			float rotated = packet.location.orientation.angularDistance(last.location.orientation);
+
+			float linearVelocityChange
+				= (packet.velocity.linearVelocity - last.velocity.linearVelocity).norm();
+			float angularVelocityChange
+				= (packet.velocity.angularVelocity - last.velocity.angularVelocity).norm();
+
+			changed = moved > positionThreshold || rotated > angleThreshold
+					  || linearVelocityChange * VELOCITY_DEADBAND_SECONDS > positionThreshold
+					  || angularVelocityChange * VELOCITY_DEADBAND_SECONDS > angleThreshold;
+		}
+
+		if (changed)
+		{
+			this->mLastSent = packet;
+			this->mLastSentTime = now;
+			this->mSent = true;
+		}
+
+		return changed;
+	}
+
+	void PoseChangeDetector::reset()
+	{
+		this->mSent = false;
+	}
+
+	bool SkeletonChangeDetector::shouldSend(const HandSkeletonPacket& packet,
+											float positionThreshold,
+											int64_t keepAlive,
+											int64_t now)
+	{
+		const HandSkeletonPacket& last = this->mLastSent;
+
+		bool changed = keepAliveExpired(this->mSent, this->mLastSentTime, keepAlive, now)
+					   || packet.validJoints != last.validJoints || packet.side != last.side;
+
+		// Squared, no need for a square root per joint
+		float thresholdSquared = positionThreshold * positionThreshold;
+
+		for (int i = 0; i < HAND_SKELETON_JOINT_COUNT && !changed; i++)
+		{
+			if ((packet.validJoints & (1u << i)) == 0)
+			{
+				continue;
+			}
+
+			float x = packet.positionX[i] - last.positionX[i];
+			float y = packet.positionY[i] - last.positionY[i];
+			float z = packet.positionZ[i] - last.positionZ[i];
+
+			changed = x * x + y * y + z * z > thresholdSquared;
+		}
+
+		if (changed)
+		{
+			this->mLastSent = packet;
+			this->mLastSentTime = now;
+			this->mSent = true;
+		}
+
+		return changed;
+	}
+
+	void SkeletonChangeDetector::reset()
+	{
+		this->mSent = false;
+	}
+
+} // namespace HOL
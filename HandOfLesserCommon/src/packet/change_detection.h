@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include "nativepacket.h"
+#include "hand_skeleton.h"
+
+namespace HOL
+{
+	// Whether a value has moved far enough from what we last sent to be worth sending again.
+	// Also says yes once keepAlive has passed since the last send, so a lost packet or a
+	// receiver that came up late catches up eventually. A keepAlive of 0 sends everything.
+	class DeadbandChannel
+	{
+	public:
+		bool changed(float value, float threshold, int64_t keepAlive, int64_t now) const;
+		void sent(float value, int64_t now);
+		void reset();
+
+	private:
+		float mLastSent = 0;
+		int64_t mLastSentTime = 0;
+		bool mSent = false;
+	};
+
+	// Same thing for a hand pose. Position and rotation get their own dead-band,
+	// any flag change always goes through.
+	class PoseChangeDetector
+	{
+	public:
+		// Records the packet as sent if it returns true
+		bool shouldSend(const HandTransformPacket& packet,
+						float positionThreshold,
+						float angleThreshold,
+						int64_t keepAlive,
+						int64_t now);
+		void reset();
+
+	private:
+		HandTransformPacket mLastSent;
+		int64_t mLastSentTime = 0;
+		bool mSent = false;
+	};
+
+	// Fingers move without the palm moving, so the skeleton is checked on its own.
+	// Joints are palm-relative, only positions are compared since any rotation that
+	// matters moves the joints further down the finger.
+	class SkeletonChangeDetector
+	{
+	public:
+		// Records the packet as sent if it returns true
+		bool shouldSend(const HandSkeletonPacket& packet,
+						float positionThreshold,
+						int64_t keepAlive,
+						int64_t now);
+		void reset();
+
+	private:
+		HandSkeletonPacket mLastSent;
+		int64_t mLastSentTime = 0;
+		bool mSent = false;
+	};
+
+} // namespace HOL
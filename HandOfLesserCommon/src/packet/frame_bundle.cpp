@@ -0,0 +1,132 @@
+#include "frame_bundle.h"
+#include "packet_table.h"
+
+#include <cstring>
+
+namespace HOL
+{
+	static size_t alignEntrySize(size_t size)
+	{
+		return (size + FRAME_BUNDLE_ALIGNMENT - 1) & ~(FRAME_BUNDLE_ALIGNMENT - 1);
+	}
+
+	void FrameBundleWriter::reset()
+	{
+		*header() = FrameBundleHeader();
+		this->mSize = sizeof(FrameBundleHeader);
+	}
+
+	// Returns false if the packet doesn't fit, in which case the caller should
+	// send what we have and start a new bundle.
+	bool FrameBundleWriter::add(const void* packet, size_t size)
+	{
+		size_t required = sizeof(FrameBundleEntry) + alignEntrySize(size);
+		if (this->mSize + required > FRAME_BUNDLE_MAX_SIZE)
+		{
+			return false;
+		}
+
+		// Padding goes out too, don't send whatever was left in the buffer
+		std::memset(this->mBuffer + this->mSize, 0, required);
+
+		FrameBundleEntry* entry = (FrameBundleEntry*)(this->mBuffer + this->mSize);
+		entry->size = (uint32_t)size;
+		std::memcpy(this->mBuffer + this->mSize + sizeof(FrameBundleEntry), packet, size);
+
+		this->mSize += required;
+		header()->entryCount++;
+		header()->totalSize = (uint32_t)this->mSize;
+
+		return true;
+	}
+
+	bool FrameBundleWriter::empty()
+	{
+		return header()->entryCount == 0;
+	}
+
+	size_t FrameBundleWriter::size()
+	{
+		return this->mSize;
+	}
+
+	char* FrameBundleWriter::getBuffer()
+	{
+		return this->mBuffer;
+	}
+
+	FrameBundleHeader* FrameBundleWriter::header()
+	{
+		return (FrameBundleHeader*)this->mBuffer;
+	}
+
+	FrameBundleReader::FrameBundleReader(const char* buffer, size_t length)
+		: mBuffer(buffer), mLength(length), mOffset(sizeof(FrameBundleHeader)), mRemaining(0)
+	{
+		if (length < sizeof(FrameBundleHeader))
+		{
+			return;
+		}
+
+		const FrameBundleHeader* header = (const FrameBundleHeader*)buffer;
+		if (header->packetType != NativePacketType::FrameBundle || header->totalSize > length)
+		{
+			return;
+		}
+
+		// Never trust anything past what the sender says it wrote
+		this->mLength = header->totalSize;
+		this->mRemaining = header->entryCount;
+	}
+
+	FrameBundleReader::FrameBundleReader(const ReceivedPacket& bundle)
+		: FrameBundleReader((const char*)bundle.packet, bundle.length)
+	{
+		this->mPool = bundle.pool;
+	}
+
+	NativePacket* FrameBundleReader::next()
+	{
+		ReceivedPacket packet;
+		next(packet);
+		return packet.packet;
+	}
+
+	bool FrameBundleReader::next(ReceivedPacket& packetOut)
+	{
+		packetOut = ReceivedPacket();
+
+		if (this->mRemaining == 0
+			|| this->mOffset + sizeof(FrameBundleEntry) > this->mLength)
+		{
+			return false;
+		}
+
+		const FrameBundleEntry* entry = (const FrameBundleEntry*)(this->mBuffer + this->mOffset);
+		size_t packetOffset = this->mOffset + sizeof(FrameBundleEntry);
+
+		if (entry->size < sizeof(NativePacket) || packetOffset + entry->size > this->mLength)
+		{
+			this->mRemaining = 0;
+			return false;
+		}
+
+		// Unknown types count as malformed too, we can't tell how much of them is there
+		const NativePacket* packet = (const NativePacket*)(this->mBuffer + packetOffset);
+		size_t packetSize = NativePacketTable::getPacketSize(packet->packetType);
+		if (packetSize == 0 || entry->size < packetSize)
+		{
+			this->mRemaining = 0;
+			return false;
+		}
+
+		this->mOffset = packetOffset + alignEntrySize(entry->size);
+		this->mRemaining--;
+
+		packetOut.packet = (NativePacket*)packet;
+		packetOut.length = entry->size;
+		packetOut.pool = this->mPool;
+		return true;
+	}
+
+} // namespace HOL
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "nativepacket.h"
+#include "packet_view.h"
+
+namespace HOL
+{
+	// Must fit in a single receive slot on the other end, see RECEIVE_SLOT_SIZE
+	static const size_t FRAME_BUNDLE_MAX_SIZE = 4096;
+
+	// Entries are padded so every packet inside the bundle stays aligned, and the driver can
+	// read them in place. Poses hold Eigen quaternions, which want 16.
+	// Fixed rather than alignof(std::max_align_t) so it's the same on every platform.
+	static const size_t FRAME_BUNDLE_ALIGNMENT = 16;
+	static_assert(FRAME_BUNDLE_ALIGNMENT >= alignof(std::max_align_t));
+
+	// Everything we want the driver to apply for a single frame, in one datagram.
+	// Followed by entryCount entries, each a FrameBundleEntry and then the packet itself.
+	struct FrameBundleHeader : TypedNativePacket<NativePacketType::FrameBundle>
+	{
+		uint32_t entryCount = 0;
+		uint32_t totalSize = sizeof(FrameBundleHeader);
+		uint32_t padding = 0;
+	};
+
+	struct alignas(FRAME_BUNDLE_ALIGNMENT) FrameBundleEntry
+	{
+		uint32_t size = 0; // Size of the packet, not including this header or padding
+	};
+
+	static_assert(sizeof(FrameBundleHeader) % FRAME_BUNDLE_ALIGNMENT == 0);
+	static_assert(sizeof(FrameBundleEntry) == FRAME_BUNDLE_ALIGNMENT);
+
+	class FrameBundleWriter
+	{
+	public:
+		void reset();
+		bool add(const void* packet, size_t size);
+		bool empty();
+		size_t size();
+		char* getBuffer();
+
+		template <typename T> bool add(const T& packet)
+		{
+			static_assert(alignof(T) <= FRAME_BUNDLE_ALIGNMENT,
+						  "Packet would end up misaligned inside the bundle");
+			return add(&packet, sizeof(T));
+		}
+
+	private:
+		FrameBundleHeader* header();
+
+		alignas(FRAME_BUNDLE_ALIGNMENT) char mBuffer[FRAME_BUNDLE_MAX_SIZE];
+		size_t mSize = sizeof(FrameBundleHeader);
+	};
+
+	// Walks the entries of a received bundle. Returns nullptr once done, or as soon as
+	// something doesn't add up, so a truncated or malformed bundle is never read past.
+	// Every entry must be at least as big as the packet type it claims to be.
+	class FrameBundleReader
+	{
+	public:
+		FrameBundleReader(const char* buffer, size_t length);
+		explicit FrameBundleReader(const ReceivedPacket& bundle);
+		NativePacket* next();
+
+		// Same as above, entries share the pool slot of the bundle
+		bool next(ReceivedPacket& packetOut);
+
+	private:
+		const char* mBuffer;
+		size_t mLength;
+		size_t mOffset;
+		uint32_t mRemaining;
+		PacketSlotPool* mPool = nullptr;
+	};
+
+} // namespace HOL
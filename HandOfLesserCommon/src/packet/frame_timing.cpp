@@ -0,0 +1,146 @@
+#include "frame_timing.h"
+#include "src/util/time_utils.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace HOL
+{
+	// Residuals bigger than this fraction of the period and it's not really a fixed cadence
+	static const double FRAME_CADENCE_MAX_RESIDUAL = 0.25;
+
+	void FrameCadenceEstimator::addFrame(int64_t time)
+	{
+		if (this->mCount > 0)
+		{
+			int64_t last = this->mTimes[(this->mNext + FRAME_CADENCE_SAMPLES - 1)
+										% FRAME_CADENCE_SAMPLES];
+			if (time <= last || time - last > FRAME_CADENCE_RESET_GAP_NS)
+			{
+				this->reset();
+			}
+		}
+
+		this->mTimes[this->mNext] = time;
+		this->mNext = (this->mNext + 1) % FRAME_CADENCE_SAMPLES;
+		this->mCount = std::min(this->mCount + 1, FRAME_CADENCE_SAMPLES);
+		this->mFrameCount++;
+
+		this->fit();
+	}
+
+	void FrameCadenceEstimator::reset()
+	{
+		this->mCount = 0;
+		this->mNext = 0;
+		this->mLocked = false;
+		this->mPeriod = 0;
+		this->mReference = 0;
+	}
+
+	void FrameCadenceEstimator::fit()
+	{
+		if (this->mCount < FRAME_CADENCE_MIN_SAMPLES)
+		{
+			this->mLocked = false;
+			return;
+		}
+
+		// Oldest first
+		int64_t times[FRAME_CADENCE_SAMPLES];
+		int first = (this->mNext + FRAME_CADENCE_SAMPLES - this->mCount) % FRAME_CADENCE_SAMPLES;
+		for (int i = 0; i < this->mCount; i++)
+		{
+			times[i] = this->mTimes[(first + i) % FRAME_CADENCE_SAMPLES];
+		}
+
+		// Median interval for a first guess, dropped frames show up as double intervals
+		// and won't move it.
+		int64_t intervals[FRAME_CADENCE_SAMPLES];
+		int intervalCount = this->mCount - 1;
+		for (int i = 0; i < intervalCount; i++)
+		{
+			intervals[i] = times[i + 1] - times[i];
+		}
+
+		std::nth_element(intervals, intervals + intervalCount / 2, intervals + intervalCount);
+		double guess = (double)intervals[intervalCount / 2];
+		if (guess <= 0)
+		{
+			this->mLocked = false;
+			return;
+		}
+
+		// Number every frame by how many periods it is after the first,
+		// then least squares time against frame number.
+		double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+		double frameNumbers[FRAME_CADENCE_SAMPLES];
+		for (int i = 0; i < this->mCount; i++)
+		{
+			double y = (double)(times[i] - times[0]);
+			double x = std::round(y / guess);
+			frameNumbers[i] = x;
+
+			sumX += x;
+			sumY += y;
+			sumXX += x * x;
+			sumXY += x * y;
+		}
+
+		double n = (double)this->mCount;
+		double denominator = n * sumXX - sumX * sumX;
+		if (denominator <= 0)
+		{
+			this->mLocked = false;
+			return;
+		}
+
+		double period = (n * sumXY - sumX * sumY) / denominator;
+		double intercept = (sumY - period * sumX) / n;
+
+		double residualSum = 0;
+		for (int i = 0; i < this->mCount; i++)
+		{
+			double residual = (double)(times[i] - times[0]) - (intercept + period * frameNumbers[i]);
+			residualSum += residual * residual;
+		}
+
+		double residualRms = std::sqrt(residualSum / n);
+
+		this->mPeriod = (int64_t)std::llround(period);
+		this->mReference
+			= times[0] + (int64_t)std::llround(intercept + period * frameNumbers[this->mCount - 1]);
+		this->mLocked = this->mPeriod > 0 && residualRms < period * FRAME_CADENCE_MAX_RESIDUAL;
+	}
+
+	bool FrameCadenceEstimator::isLocked()
+	{
+		return this->mLocked;
+	}
+
+	int64_t FrameCadenceEstimator::getPeriod()
+	{
+		return this->mPeriod;
+	}
+
+	int64_t FrameCadenceEstimator::getReference()
+	{
+		return this->mReference;
+	}
+
+	uint32_t FrameCadenceEstimator::getFrameCount()
+	{
+		return this->mFrameCount;
+	}
+
+	int64_t FrameCadenceEstimator::nextFrameAfter(int64_t time)
+	{
+		if (!this->mLocked)
+		{
+			return time;
+		}
+
+		return nextTimeOnGrid(this->mReference, this->mPeriod, time);
+	}
+
+} // namespace HOL
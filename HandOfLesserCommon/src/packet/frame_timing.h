@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include "nativepacket.h"
+
+namespace HOL
+{
+	static const int FRAME_CADENCE_SAMPLES = 64;
+	static const int FRAME_CADENCE_MIN_SAMPLES = 16;
+
+	// Anything longer than this between frames means SteamVR stalled or went idle,
+	// whatever we learned before doesn't apply anymore.
+	static const int64_t FRAME_CADENCE_RESET_GAP_NS = 250000000;
+
+	// Driver -> app, a few times a second. When SteamVR runs its frames, going by RunFrame().
+	// Times are steadyNanoseconds(), which both processes share.
+	struct FrameTimingPacket : TypedNativePacket<NativePacketType::FrameTiming>
+	{
+		uint32_t locked = 0; // Nothing below is any use otherwise
+		uint32_t frameCount = 0;
+		int64_t framePeriod = 0;
+		int64_t frameReference = 0; // A recent frame, on the fitted grid
+	};
+
+	// Learns a fixed-rate cadence from timestamps that are roughly on it.
+	// Fits a line through the last few seconds of frames, so jitter on individual frames
+	// averages out and the odd dropped one doesn't matter. Fixed size, allocation free.
+	class FrameCadenceEstimator
+	{
+	public:
+		void addFrame(int64_t time);
+		void reset();
+
+		bool isLocked();
+		int64_t getPeriod();
+		int64_t getReference();
+		uint32_t getFrameCount();
+
+		// Next frame strictly after time, time itself if we're not locked
+		int64_t nextFrameAfter(int64_t time);
+
+	private:
+		void fit();
+
+		int64_t mTimes[FRAME_CADENCE_SAMPLES];
+		int mCount = 0;
+		int mNext = 0;
+		uint32_t mFrameCount = 0;
+
+		bool mLocked = false;
+		int64_t mPeriod = 0;
+		int64_t mReference = 0;
+	};
+
+} // namespace HOL
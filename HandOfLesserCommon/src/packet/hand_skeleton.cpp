@@ -0,0 +1,57 @@
+#include "hand_skeleton.h"
+
+namespace HOL
+{
+	void setSkeletonJoint(HandSkeletonPacket& packet,
+						  int joint,
+						  const Eigen::Vector3f& position,
+						  const Eigen::Quaternionf& orientation)
+	{
+		packet.positionX[joint] = position.x();
+		packet.positionY[joint] = position.y();
+		packet.positionZ[joint] = position.z();
+
+		packet.orientationX[joint] = orientation.x();
+		packet.orientationY[joint] = orientation.y();
+		packet.orientationZ[joint] = orientation.z();
+		packet.orientationW[joint] = orientation.w();
+
+		packet.validJoints |= 1u << joint;
+	}
+
+	Eigen::Vector3f getSkeletonJointPosition(const HandSkeletonPacket& packet, int joint)
+	{
+		return Eigen::Vector3f(
+			packet.positionX[joint], packet.positionY[joint], packet.positionZ[joint]);
+	}
+
+	Eigen::Quaternionf getSkeletonJointOrientation(const HandSkeletonPacket& packet, int joint)
+	{
+		return Eigen::Quaternionf(packet.orientationW[joint],
+								  packet.orientationX[joint],
+								  packet.orientationY[joint],
+								  packet.orientationZ[joint]);
+	}
+
+	void makeSkeletonPalmRelative(HandSkeletonPacket& packet,
+								  const Eigen::Vector3f& palmPosition,
+								  const Eigen::Quaternionf& palmOrientation)
+	{
+		Eigen::Quaternionf inversePalm = palmOrientation.conjugate();
+
+		for (int i = 0; i < HAND_SKELETON_JOINT_COUNT; i++)
+		{
+			if (!(packet.validJoints & (1u << i)))
+			{
+				continue;
+			}
+
+			Eigen::Vector3f position
+				= inversePalm * (getSkeletonJointPosition(packet, i) - palmPosition);
+			Eigen::Quaternionf orientation = inversePalm * getSkeletonJointOrientation(packet, i);
+
+			setSkeletonJoint(packet, i, position, orientation);
+		}
+	}
+
+} // namespace HOL
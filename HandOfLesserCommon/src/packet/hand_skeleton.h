@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include "nativepacket.h"
+
+namespace HOL
+{
+	// Same joints in the same order as XrHandJointEXT, palm first
+	static const int HAND_SKELETON_JOINT_COUNT = 26;
+	static const uint32_t HAND_SKELETON_ALL_JOINTS = (1u << HAND_SKELETON_JOINT_COUNT) - 1;
+
+	// Every tracked joint of one hand, relative to the palm. The palm is also the pose we
+	// send in HandTransformPacket, so the driver doesn't need to know where the hand is.
+	// Stored as separate arrays per component so the driver can go through them in one pass
+	// without any shuffling, and so there's no padding between joints.
+	struct HandSkeletonPacket : TypedNativePacket<NativePacketType::HandSkeleton>
+	{
+		uint8_t side = HOL::HandSide::LeftHand;
+		uint8_t reserved[3] = {0, 0, 0};
+		uint32_t validJoints = 0; // Bit per joint, both position and orientation valid
+
+		float positionX[HAND_SKELETON_JOINT_COUNT];
+		float positionY[HAND_SKELETON_JOINT_COUNT];
+		float positionZ[HAND_SKELETON_JOINT_COUNT];
+
+		float orientationX[HAND_SKELETON_JOINT_COUNT];
+		float orientationY[HAND_SKELETON_JOINT_COUNT];
+		float orientationZ[HAND_SKELETON_JOINT_COUNT];
+		float orientationW[HAND_SKELETON_JOINT_COUNT];
+	};
+
+	void setSkeletonJoint(HandSkeletonPacket& packet,
+						  int joint,
+						  const Eigen::Vector3f& position,
+						  const Eigen::Quaternionf& orientation);
+	Eigen::Vector3f getSkeletonJointPosition(const HandSkeletonPacket& packet, int joint);
+	Eigen::Quaternionf getSkeletonJointOrientation(const HandSkeletonPacket& packet, int joint);
+
+	// Joints come from the app in world space, this makes them relative to the palm.
+	// Joints that weren't valid are left alone.
+	void makeSkeletonPalmRelative(HandSkeletonPacket& packet,
+								  const Eigen::Vector3f& palmPosition,
+								  const Eigen::Quaternionf& palmOrientation);
+
+	inline bool isSkeletonComplete(const HandSkeletonPacket& packet)
+	{
+		return (packet.validJoints & HAND_SKELETON_ALL_JOINTS) == HAND_SKELETON_ALL_JOINTS;
+	}
+
+} // namespace HOL
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "nativepacket.h"
+#include "src/util/metrics.h"
+
+namespace HOL
+{
+	// App -> driver. Driver replies with a MetricsPacket.
+	struct MetricsRequestPacket : TypedNativePacket<NativePacketType::MetricsRequest>
+	{
+		bool reset = false; // Start over after replying
+	};
+
+	// Driver -> app, everything in the driver's registry
+	struct MetricsPacket : TypedNativePacket<NativePacketType::Metrics>
+	{
+		MetricsSnapshot snapshot;
+	};
+} // namespace HOL
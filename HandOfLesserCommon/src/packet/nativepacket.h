@@ -1,45 +1,129 @@
 #pragma once
 
+#include <cstdint>
 #include "src/hand/hand.h"
 #include <src/settings/settings.h>
 
 namespace HOL
 {
-	enum class NativePacketType : __int32
+	enum class NativePacketType : int32_t
 	{
 		InvalidPacket = 100,
 		HandTransform = 500,
+		CompactHandTransform = 501,
+		PoseAck = 502,
+		PoseEncoding = 510,
+		HandSkeleton = 520,
 		ControllerInput = 600,
 		FloatInput = 601,
 		BoolInput = 602,
-		Settings = 700
+		FloatInputId = 603,
+		BoolInputId = 604,
+		InputIdTable = 650,
+		InputIdTableRequest = 651,
+		Settings = 700,
+		FrameBundle = 800,
+		PacketStatisticsRequest = 900,
+		PacketStatistics = 901,
+		FrameTiming = 920,
+		TraceControl = 940,
+		MetricsRequest = 950,
+		Metrics = 951
 	};
 
+	// Bump whenever the layout of any packet changes, so an app and driver that
+	// were built from different versions ignore each other instead of reading garbage.
+	static const uint32_t NATIVE_PACKET_VERSION = 9;
+
+	// Common header at the start of every packet.
+	// Sequence counts up per packet type, so the receiver can tell what got lost or reordered.
+	// captureTime is the XrTime the data was sampled for, if any.
+	// sendTime is steady_clock nanoseconds, which is the same clock in both processes.
 	struct NativePacket
 	{
 		NativePacketType packetType = NativePacketType::InvalidPacket;
+		uint32_t version = NATIVE_PACKET_VERSION;
+		uint32_t sequence = 0;
+		uint32_t padding = 0;
+		int64_t captureTime = 0;
+		int64_t sendTime = 0;
+
+		NativePacket(NativePacketType type = NativePacketType::InvalidPacket) : packetType(type)
+		{
+		}
+	};
+
+	// Types that are just different encodings of the same data count up the same sequence,
+	// so the receiver can tell which is newer when they're mixed.
+	inline NativePacketType getSequenceType(NativePacketType type)
+	{
+		return type == NativePacketType::CompactHandTransform ? NativePacketType::HandTransform
+															  : type;
+	}
+
+	template <NativePacketType Type> struct TypedNativePacket : NativePacket
+	{
+		static constexpr NativePacketType PacketType = Type;
+
+		TypedNativePacket() : NativePacket(Type)
+		{
+		}
 	};
 
 	// these'll ultimately handle all controller inputs
-	struct FloatInputPacket
+	struct FloatInputPacket : TypedNativePacket<NativePacketType::FloatInput>
 	{
-		NativePacketType packetType = NativePacketType::FloatInput;
 		HOL::HandSide side = HOL::HandSide::LeftHand;
 		char inputName[64];
 		float value = 0;
 	};
 
-	struct BoolInputPacket
+	struct BoolInputPacket : TypedNativePacket<NativePacketType::BoolInput>
 	{
-		NativePacketType packetType = NativePacketType::BoolInput;
 		HOL::HandSide side = HOL::HandSide::LeftHand;
 		char inputName[64];
 		bool value = 0;
 	};
 
-	struct ControllerInputPacket
+	// Same as above, but referring to the input by the id the driver gave it,
+	// see InputIdTablePacket. Sent once we know the id, names are the fallback.
+	struct FloatInputIdPacket : TypedNativePacket<NativePacketType::FloatInputId>
+	{
+		uint8_t side = HOL::HandSide::LeftHand;
+		uint16_t inputId = 0;
+		float value = 0;
+	};
+
+	struct BoolInputIdPacket : TypedNativePacket<NativePacketType::BoolInputId>
+	{
+		uint8_t side = HOL::HandSide::LeftHand;
+		uint16_t inputId = 0;
+		bool value = 0;
+	};
+
+	static const int INPUT_ID_TABLE_PAGE_SIZE = 32;
+	static const int INPUT_NAME_LENGTH = 64;
+
+	// Driver -> app. One page of the driver's input name table, the id of each
+	// name is firstId + its index. Generation changes whenever the driver restarts,
+	// at which point any ids the app knows about are worthless.
+	struct InputIdTablePacket : TypedNativePacket<NativePacketType::InputIdTable>
+	{
+		uint32_t generation = 0;
+		uint16_t firstId = 0;
+		uint16_t count = 0;
+		uint16_t totalCount = 0;
+		char inputNames[INPUT_ID_TABLE_PAGE_SIZE][INPUT_NAME_LENGTH];
+	};
+
+	// App -> driver. Asks the driver to send us the whole table.
+	struct InputIdTableRequestPacket : TypedNativePacket<NativePacketType::InputIdTableRequest>
+	{
+		uint32_t generation = 0; // Whatever we have now, 0 if nothing
+	};
+
+	struct ControllerInputPacket : TypedNativePacket<NativePacketType::ControllerInput>
 	{
-		NativePacketType packetType = NativePacketType::ControllerInput;
 		bool valid = 0;
 		HOL::HandSide side = HOL::HandSide::LeftHand;
 
@@ -59,18 +143,27 @@ namespace HOL
 		float fingerCurlPinky = 0.0f;
 	};
 
-	struct SettingsPacket
+	struct SettingsPacket : TypedNativePacket<NativePacketType::Settings>
 	{
-		NativePacketType packetType = NativePacketType::Settings;
 		HOL::settings::HandOfLesserSettings config;
 	};
 
+	static const int TRACE_FILE_NAME_LENGTH = 64;
+
+	// App -> driver, see trace.h. When tracing stops the driver writes what it has to fileName
+	// in getTraceDirectory(), if there is one, for the app to merge into its own.
+	// Only ever a bare file name, the driver picks where it goes.
+	struct TraceControlPacket : TypedNativePacket<NativePacketType::TraceControl>
+	{
+		bool enabled = false;
+		char fileName[TRACE_FILE_NAME_LENGTH] = {};
+	};
+
 	// Mimics vr::DriverPose_t, but only contains the bits we care about.
 	// Subject to change.
-	// include packet type in packet itself so we can just memcpy the whole thing
-	struct HandTransformPacket
+	// header is part of the packet itself so we can just memcpy the whole thing
+	struct HandTransformPacket : TypedNativePacket<NativePacketType::HandTransform>
 	{
-		NativePacketType packetType = NativePacketType::HandTransform;
 		bool active = false;
 		bool valid = false;
 		bool stale = false;
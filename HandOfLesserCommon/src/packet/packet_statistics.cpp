@@ -0,0 +1,132 @@
+#include "packet_statistics.h"
+
+#include <algorithm>
+
+namespace HOL
+{
+	static float percentile(float* samples, uint32_t count, float fraction)
+	{
+		if (count == 0)
+		{
+			return 0;
+		}
+
+		uint32_t index = std::min(count - 1, (uint32_t)(fraction * count));
+		std::nth_element(samples, samples + index, samples + count);
+		return samples[index];
+	}
+
+	bool PacketStatistics::record(const NativePacket* packet, int64_t receiveTime)
+	{
+		// Mixing encodings would look like loss otherwise, see getSequenceType()
+		TypeTracker* tracker = getTracker(getSequenceType(packet->packetType));
+		if (tracker == nullptr)
+		{
+			// Out of slots, just don't track it.
+			return true;
+		}
+
+		bool inOrder = true;
+
+		// Sequence 0 means the sender didn't stamp it
+		if (packet->sequence != 0)
+		{
+			if (!tracker->sequenceKnown
+				|| isNewerSequence(packet->sequence, tracker->highestSequence))
+			{
+				int32_t gap = (int32_t)(packet->sequence - tracker->highestSequence);
+				if (tracker->sequenceKnown && gap > 1)
+				{
+					tracker->lost += gap - 1;
+				}
+
+				tracker->highestSequence = packet->sequence;
+				tracker->sequenceKnown = true;
+			}
+			else
+			{
+				// Counted as lost when we skipped past it, it wasn't.
+				tracker->reordered++;
+				if (tracker->lost > 0)
+				{
+					tracker->lost--;
+				}
+
+				inOrder = false;
+			}
+		}
+
+		tracker->received++;
+
+		if (packet->sendTime != 0)
+		{
+			tracker->latencies[tracker->latencyNext] = (receiveTime - packet->sendTime) / 1000.f;
+			tracker->latencyNext = (tracker->latencyNext + 1) % PACKET_STATISTICS_LATENCY_SAMPLES;
+			tracker->latencyCount
+				= std::min<uint32_t>(tracker->latencyCount + 1, PACKET_STATISTICS_LATENCY_SAMPLES);
+		}
+
+		return inOrder;
+	}
+
+	uint32_t PacketStatistics::snapshot(PacketTypeStatistics* out, uint32_t maxCount)
+	{
+		uint32_t count = std::min(this->mTrackerCount, maxCount);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			TypeTracker& tracker = this->mTrackers[i];
+			PacketTypeStatistics& stats = out[i];
+
+			stats.packetType = tracker.packetType;
+			stats.received = tracker.received;
+			stats.lost = tracker.lost;
+			stats.reordered = tracker.reordered;
+
+			uint32_t expected = tracker.received + tracker.lost;
+			stats.lossRate = expected > 0 ? (float)tracker.lost / expected : 0;
+
+			// nth_element shuffles, so work on a copy
+			std::copy_n(tracker.latencies, tracker.latencyCount, this->mPercentileScratch);
+			stats.latencyP50 = percentile(this->mPercentileScratch, tracker.latencyCount, 0.5f);
+			stats.latencyP99 = percentile(this->mPercentileScratch, tracker.latencyCount, 0.99f);
+		}
+
+		return count;
+	}
+
+	void PacketStatistics::reset()
+	{
+		for (uint32_t i = 0; i < this->mTrackerCount; i++)
+		{
+			// Keep the type and sequence so the next packet isn't counted as reordered
+			TypeTracker& tracker = this->mTrackers[i];
+			tracker.received = 0;
+			tracker.lost = 0;
+			tracker.reordered = 0;
+			tracker.latencyCount = 0;
+			tracker.latencyNext = 0;
+		}
+	}
+
+	PacketStatistics::TypeTracker* PacketStatistics::getTracker(NativePacketType packetType)
+	{
+		for (uint32_t i = 0; i < this->mTrackerCount; i++)
+		{
+			if (this->mTrackers[i].packetType == packetType)
+			{
+				return &this->mTrackers[i];
+			}
+		}
+
+		if (this->mTrackerCount >= PACKET_STATISTICS_MAX_TYPES)
+		{
+			return nullptr;
+		}
+
+		TypeTracker* tracker = &this->mTrackers[this->mTrackerCount++];
+		tracker->packetType = packetType;
+		return tracker;
+	}
+
+} // namespace HOL
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include "nativepacket.h"
+
+namespace HOL
+{
+	static const int PACKET_STATISTICS_MAX_TYPES = 16;
+	static const int PACKET_STATISTICS_LATENCY_SAMPLES = 1024;
+
+	// A jump backwards this big means the sender restarted, not that the packet is late.
+	// Nothing on loopback arrives anywhere near this late, and we don't want to throw away
+	// poses for long after the app restarts.
+	static const int32_t PACKET_SEQUENCE_RESTART_THRESHOLD = 64;
+
+	// True if sequence comes after last, accounting for wraparound and sender restarts.
+	inline bool isNewerSequence(uint32_t sequence, uint32_t last)
+	{
+		int32_t difference = (int32_t)(sequence - last);
+		return difference > 0 || difference < -PACKET_SEQUENCE_RESTART_THRESHOLD;
+	}
+
+	struct PacketTypeStatistics
+	{
+		NativePacketType packetType = NativePacketType::InvalidPacket;
+		uint32_t received = 0;
+		uint32_t lost = 0;
+		uint32_t reordered = 0;
+		float lossRate = 0;
+		float latencyP50 = 0; // microseconds, send to receive
+		float latencyP99 = 0;
+	};
+
+	// App -> driver. Driver replies with a PacketStatisticsPacket.
+	struct PacketStatisticsRequestPacket
+		: TypedNativePacket<NativePacketType::PacketStatisticsRequest>
+	{
+		bool reset = false; // Start counting from scratch after replying
+	};
+
+	struct PacketStatisticsPacket : TypedNativePacket<NativePacketType::PacketStatistics>
+	{
+		uint32_t count = 0;
+		PacketTypeStatistics types[PACKET_STATISTICS_MAX_TYPES];
+	};
+
+	// Receiver side accounting of loss, reordering and transit latency, per packet type.
+	// Fixed size, nothing is allocated after construction. Not thread safe, keep it on
+	// the receive thread.
+	class PacketStatistics
+	{
+	public:
+		// Returns false if the packet is older than one of the same type we've already seen
+		bool record(const NativePacket* packet, int64_t receiveTime);
+		uint32_t snapshot(PacketTypeStatistics* out, uint32_t maxCount);
+		void reset();
+
+	private:
+		struct TypeTracker
+		{
+			NativePacketType packetType = NativePacketType::InvalidPacket;
+			bool sequenceKnown = false;
+			uint32_t highestSequence = 0;
+			uint32_t received = 0;
+			uint32_t lost = 0;
+			uint32_t reordered = 0;
+
+			// Rolling window, oldest gets overwritten
+			float latencies[PACKET_STATISTICS_LATENCY_SAMPLES];
+			uint32_t latencyCount = 0;
+			uint32_t latencyNext = 0;
+		};
+
+		TypeTracker* getTracker(NativePacketType packetType);
+
+		TypeTracker mTrackers[PACKET_STATISTICS_MAX_TYPES];
+		uint32_t mTrackerCount = 0;
+		float mPercentileScratch[PACKET_STATISTICS_LATENCY_SAMPLES];
+	};
+
+} // namespace HOL
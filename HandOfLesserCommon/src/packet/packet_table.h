@@ -0,0 +1,103 @@
+#pragma once
+
+#include "nativepacket.h"
+#include "frame_bundle.h"
+#include "packet_statistics.h"
+#include "pose_codec.h"
+#include "hand_skeleton.h"
+#include "frame_timing.h"
+#include "metrics_packet.h"
+#include "packet_view.h"
+
+namespace HOL
+{
+	// Maps a NativePacketType to the struct that goes with it, at compile time.
+	// Dispatch hands the handler a validated PacketView of the right type, so nobody has to
+	// cast a NativePacket* themselves.
+	template <typename... Packets> struct PacketTable
+	{
+		static constexpr bool hasUniqueTypes()
+		{
+			NativePacketType types[] = {Packets::PacketType...};
+			for (size_t i = 0; i < sizeof...(Packets); i++)
+			{
+				for (size_t j = i + 1; j < sizeof...(Packets); j++)
+				{
+					if (types[i] == types[j])
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		static_assert(hasUniqueTypes(), "Every packet type must only appear once");
+
+		// Any of them can go in a FrameBundle, which only guarantees so much alignment
+		static_assert(((alignof(Packets) <= FRAME_BUNDLE_ALIGNMENT) && ...),
+					  "Packet would end up misaligned inside a bundle");
+
+		// Size of the struct for the given type, or 0 if it isn't in the table
+		static constexpr size_t getPacketSize(NativePacketType type)
+		{
+			size_t size = 0;
+			((type == Packets::PacketType ? (size = sizeof(Packets), true) : false) || ...);
+			return size;
+		}
+
+		// Returns false if the type is unknown, or the packet didn't pass validation
+		template <typename Handler> static bool dispatch(const ReceivedPacket& received,
+														 Handler&& handler)
+		{
+			if (received.packet == nullptr || received.length < sizeof(NativePacket))
+			{
+				return false;
+			}
+
+			return (dispatchAs<Packets>(received, handler) || ...);
+		}
+
+	private:
+		template <typename T, typename Handler>
+		static bool dispatchAs(const ReceivedPacket& received, Handler& handler)
+		{
+			if (received.packet->packetType != T::PacketType)
+			{
+				return false;
+			}
+
+			PacketView<T> view(received);
+			if (!view)
+			{
+				return false;
+			}
+
+			handler(std::move(view));
+			return true;
+		}
+	};
+
+	using NativePacketTable = PacketTable<HandTransformPacket,
+										  CompactHandTransformPacket,
+										  PoseAckPacket,
+										  PoseEncodingPacket,
+										  HandSkeletonPacket,
+										  ControllerInputPacket,
+										  FloatInputPacket,
+										  BoolInputPacket,
+										  FloatInputIdPacket,
+										  BoolInputIdPacket,
+										  InputIdTablePacket,
+										  InputIdTableRequestPacket,
+										  SettingsPacket,
+										  FrameBundleHeader,
+										  PacketStatisticsRequestPacket,
+										  PacketStatisticsPacket,
+										  FrameTimingPacket,
+										  TraceControlPacket,
+										  MetricsRequestPacket,
+										  MetricsPacket>;
+
+} // namespace HOL
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include "nativepacket.h"
+#include "src/transport/packet_slot_pool.h"
+
+namespace HOL
+{
+	// A packet as it came off the wire. Pool is the slot pool it lives in, if any,
+	// and is what PacketView holds a reference on.
+	struct ReceivedPacket
+	{
+		NativePacket* packet = nullptr;
+		size_t length = 0;
+		PacketSlotPool* pool = nullptr;
+	};
+
+	template <typename T> bool isValidPacket(const NativePacket* packet, size_t length)
+	{
+		return packet != nullptr && length >= sizeof(T) && packet->packetType == T::PacketType
+			   && packet->version == NATIVE_PACKET_VERSION;
+	}
+
+	// Typed, read-only view of a received packet. Only ever non-empty if the packet is
+	// the right type and version and wasn't truncated, so a bad datagram can't be read
+	// as something it isn't. Keeps the slot it was received into alive until released,
+	// so there's no need to copy the packet out of the receive buffer to hang on to it.
+	template <typename T> class PacketView
+	{
+	public:
+		PacketView() = default;
+
+		explicit PacketView(const ReceivedPacket& received)
+		{
+			if (isValidPacket<T>(received.packet, received.length))
+			{
+				this->mPacket = (const T*)received.packet;
+				this->mLength = received.length;
+				this->mPool = received.pool;
+				retain();
+			}
+		}
+
+		PacketView(const PacketView& other)
+			: mPacket(other.mPacket), mLength(other.mLength), mPool(other.mPool)
+		{
+			retain();
+		}
+
+		PacketView(PacketView&& other) noexcept
+			: mPacket(std::exchange(other.mPacket, nullptr)), mLength(other.mLength),
+			  mPool(other.mPool)
+		{
+		}
+
+		PacketView& operator=(PacketView other) noexcept
+		{
+			std::swap(this->mPacket, other.mPacket);
+			std::swap(this->mLength, other.mLength);
+			std::swap(this->mPool, other.mPool);
+			return *this;
+		}
+
+		~PacketView()
+		{
+			release();
+		}
+
+		void release()
+		{
+			if (this->mPacket != nullptr && this->mPool != nullptr)
+			{
+				this->mPool->release(this->mPacket);
+			}
+
+			this->mPacket = nullptr;
+		}
+
+		explicit operator bool() const
+		{
+			return this->mPacket != nullptr;
+		}
+
+		const T* get() const
+		{
+			return this->mPacket;
+		}
+
+		const T* operator->() const
+		{
+			return this->mPacket;
+		}
+
+		const T& operator*() const
+		{
+			return *this->mPacket;
+		}
+
+		// For packets that contain other packets
+		ReceivedPacket getReceived() const
+		{
+			return ReceivedPacket{(NativePacket*)this->mPacket, this->mLength, this->mPool};
+		}
+
+	private:
+		void retain()
+		{
+			if (this->mPacket != nullptr && this->mPool != nullptr)
+			{
+				this->mPool->retain(this->mPacket);
+			}
+		}
+
+		const T* mPacket = nullptr;
+		size_t mLength = 0;
+		PacketSlotPool* mPool = nullptr;
+	};
+
+} // namespace HOL
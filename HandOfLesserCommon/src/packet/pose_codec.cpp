@@ -0,0 +1,232 @@
+#include "pose_codec.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace HOL
+{
+	// The three smallest components of a unit quaternion are at most 1/sqrt(2)
+	static const float ORIENTATION_SCALE = 32767.f * 1.41421356f;
+
+	static int16_t quantize(float value, float scale)
+	{
+		float scaled = std::round(value * scale);
+		return (int16_t)std::clamp(scaled, -32767.f, 32767.f);
+	}
+
+	static bool fitsInt16(int32_t value)
+	{
+		return value >= -32767 && value <= 32767;
+	}
+
+	void encodeOrientation(const Eigen::Quaternionf& orientation,
+						   int16_t encoded[3],
+						   uint8_t& largestIndex)
+	{
+		Eigen::Vector4f components = orientation.normalized().coeffs();
+
+		Eigen::Index largest = 0;
+		components.cwiseAbs().maxCoeff(&largest);
+		largestIndex = (uint8_t)largest;
+
+		// q and -q are the same rotation, pick the one where the dropped component is positive
+		if (components[largestIndex] < 0)
+		{
+			components = -components;
+		}
+
+		int written = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if (i != largestIndex)
+			{
+				encoded[written++] = quantize(components[i], ORIENTATION_SCALE);
+			}
+		}
+	}
+
+	Eigen::Quaternionf decodeOrientation(const int16_t encoded[3], uint8_t largestIndex)
+	{
+		Eigen::Vector4f components;
+		float sumSquares = 0;
+
+		int read = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if (i != largestIndex)
+			{
+				components[i] = encoded[read++] / ORIENTATION_SCALE;
+				sumSquares += components[i] * components[i];
+			}
+		}
+
+		components[largestIndex] = std::sqrt(std::max(0.f, 1.f - sumSquares));
+
+		// coeffs() order is x, y, z, w
+		Eigen::Quaternionf orientation(components[3], components[0], components[1], components[2]);
+		return orientation.normalized();
+	}
+
+	void PoseEncoder::reset()
+	{
+		for (int side = 0; side < HandSide_MAX; side++)
+		{
+			this->mAcknowledged[side] = 0;
+			for (HistoryEntry& entry : this->mHistory[side])
+			{
+				entry = HistoryEntry();
+			}
+		}
+	}
+
+	void PoseEncoder::acknowledge(HandSide side, uint32_t sequence)
+	{
+		if (side < HandSide_MAX)
+		{
+			this->mAcknowledged[side] = sequence;
+		}
+	}
+
+	bool PoseEncoder::encode(const HandTransformPacket& pose, CompactHandTransformPacket& out)
+	{
+		if (pose.side >= HandSide_MAX || out.sequence == 0)
+		{
+			return false;
+		}
+
+		uint8_t largestIndex = 0;
+		encodeOrientation(pose.location.orientation, out.orientation, largestIndex);
+
+		out.flags = (pose.active ? CompactPoseActive : 0) | (pose.valid ? CompactPoseValid : 0)
+					| (pose.stale ? CompactPoseStale : 0)
+					| (pose.side == HandSide::RightHand ? CompactPoseRightHand : 0)
+					| (largestIndex << COMPACT_POSE_LARGEST_SHIFT);
+
+		for (int i = 0; i < 3; i++)
+		{
+			out.linearVelocity[i]
+				= quantize(pose.velocity.linearVelocity[i], POSE_LINEAR_VELOCITY_UNITS);
+			out.angularVelocity[i]
+				= quantize(pose.velocity.angularVelocity[i], POSE_ANGULAR_VELOCITY_UNITS);
+		}
+
+		// Delta units are what both ends store, so reconstructing from a delta is exact
+		int32_t position[3];
+		for (int i = 0; i < 3; i++)
+		{
+			position[i] = (int32_t)std::round(pose.location.position[i] * POSE_DELTA_UNITS_PER_METER);
+		}
+
+		// Delta against the newest frame the driver has told us about, if we still have it
+		uint32_t acknowledged = this->mAcknowledged[pose.side];
+		uint32_t baseOffset = out.sequence - acknowledged;
+		const HistoryEntry& base = this->mHistory[pose.side][acknowledged % POSE_HISTORY_SIZE];
+
+		bool delta = acknowledged != 0 && base.sequence == acknowledged && baseOffset > 0
+					 && baseOffset < POSE_HISTORY_SIZE;
+
+		for (int i = 0; i < 3 && delta; i++)
+		{
+			delta = fitsInt16(position[i] - base.position[i]);
+		}
+
+		if (delta)
+		{
+			out.flags |= CompactPoseDelta;
+			out.baseOffset = (uint8_t)baseOffset;
+			for (int i = 0; i < 3; i++)
+			{
+				out.position[i] = (int16_t)(position[i] - base.position[i]);
+			}
+		}
+		else
+		{
+			out.baseOffset = 0;
+			for (int i = 0; i < 3; i++)
+			{
+				int32_t keyframe = (int32_t)std::round(pose.location.position[i]
+													   * POSE_KEYFRAME_UNITS_PER_METER);
+				if (!fitsInt16(keyframe))
+				{
+					return false;
+				}
+
+				out.position[i] = (int16_t)keyframe;
+				position[i] = keyframe * POSE_KEYFRAME_TO_DELTA_UNITS;
+			}
+		}
+
+		HistoryEntry& entry = this->mHistory[pose.side][out.sequence % POSE_HISTORY_SIZE];
+		entry.sequence = out.sequence;
+		std::copy_n(position, 3, entry.position);
+
+		return true;
+	}
+
+	void PoseDecoder::reset()
+	{
+		for (int side = 0; side < HandSide_MAX; side++)
+		{
+			for (HistoryEntry& entry : this->mHistory[side])
+			{
+				entry = HistoryEntry();
+			}
+		}
+	}
+
+	bool PoseDecoder::decode(const CompactHandTransformPacket& packet, HandTransformPacket& out)
+	{
+		HandSide side = (packet.flags & CompactPoseRightHand) ? HandSide::RightHand
+															  : HandSide::LeftHand;
+
+		int32_t position[3];
+		if (packet.flags & CompactPoseDelta)
+		{
+			uint32_t baseSequence = packet.sequence - packet.baseOffset;
+			const HistoryEntry& base = this->mHistory[side][baseSequence % POSE_HISTORY_SIZE];
+			if (packet.baseOffset == 0 || base.sequence != baseSequence)
+			{
+				return false;
+			}
+
+			for (int i = 0; i < 3; i++)
+			{
+				position[i] = base.position[i] + packet.position[i];
+			}
+		}
+		else
+		{
+			for (int i = 0; i < 3; i++)
+			{
+				position[i] = packet.position[i] * POSE_KEYFRAME_TO_DELTA_UNITS;
+			}
+		}
+
+		HistoryEntry& entry = this->mHistory[side][packet.sequence % POSE_HISTORY_SIZE];
+		entry.sequence = packet.sequence;
+		std::copy_n(position, 3, entry.position);
+
+		out.sequence = packet.sequence;
+		out.captureTime = packet.captureTime;
+		out.sendTime = packet.sendTime;
+		out.active = packet.flags & CompactPoseActive;
+		out.valid = packet.flags & CompactPoseValid;
+		out.stale = packet.flags & CompactPoseStale;
+		out.side = side;
+
+		uint8_t largestIndex = (packet.flags >> COMPACT_POSE_LARGEST_SHIFT) & 0x3;
+		out.location.orientation = decodeOrientation(packet.orientation, largestIndex);
+
+		for (int i = 0; i < 3; i++)
+		{
+			out.location.position[i] = position[i] / POSE_DELTA_UNITS_PER_METER;
+			out.velocity.linearVelocity[i]
+				= packet.linearVelocity[i] / POSE_LINEAR_VELOCITY_UNITS;
+			out.velocity.angularVelocity[i]
+				= packet.angularVelocity[i] / POSE_ANGULAR_VELOCITY_UNITS;
+		}
+
+		return true;
+	}
+
+} // namespace HOL
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "nativepacket.h"
+
+namespace HOL
+{
+	// Positions are fixed-point millimetres. Keyframes are absolute in quarter millimetres,
+	// which covers +-8m. Deltas are relative to a frame the driver has acknowledged, in
+	// sixteenths of a millimetre, which covers +-2m of movement since then.
+	static const float POSE_KEYFRAME_UNITS_PER_METER = 4000.f;
+	static const float POSE_DELTA_UNITS_PER_METER = 16000.f;
+	static const int32_t POSE_KEYFRAME_TO_DELTA_UNITS = 4;
+
+	static const float POSE_LINEAR_VELOCITY_UNITS = 1000.f;  // mm/s
+	static const float POSE_ANGULAR_VELOCITY_UNITS = 1000.f; // mrad/s
+
+	// How many frames back a delta can refer to. Both ends remember this many per hand.
+	static const int POSE_HISTORY_SIZE = 128;
+
+	enum class PoseEncodingType : uint32_t
+	{
+		Full = 0,
+		Compact = 1
+	};
+
+	enum CompactPoseFlags : uint8_t
+	{
+		CompactPoseActive = 1 << 0,
+		CompactPoseValid = 1 << 1,
+		CompactPoseStale = 1 << 2,
+		CompactPoseRightHand = 1 << 3,
+		CompactPoseDelta = 1 << 4,
+	};
+
+	// Top bits of the flags are which quaternion component was dropped, see below
+	static const int COMPACT_POSE_LARGEST_SHIFT = 5;
+
+	// HandTransformPacket at a fraction of the size, fits in a single cache line header and all.
+	// Orientation is smallest-three, the largest component is left out and rebuilt from
+	// the other three since the quaternion is unit length.
+	struct CompactHandTransformPacket : TypedNativePacket<NativePacketType::CompactHandTransform>
+	{
+		uint8_t flags = 0;
+		uint8_t baseOffset = 0; // Delta against sequence - baseOffset
+		int16_t orientation[3] = {0, 0, 0};
+		int16_t position[3] = {0, 0, 0};
+		int16_t linearVelocity[3] = {0, 0, 0};
+		int16_t angularVelocity[3] = {0, 0, 0};
+	};
+
+	static_assert(sizeof(CompactHandTransformPacket) <= 64, "Should fit in a cache line");
+
+	// Driver -> app. Latest compact pose we decoded for a hand, so the app can send deltas
+	// against it. Sequence 0 means we got a delta we couldn't decode, send a keyframe.
+	struct PoseAckPacket : TypedNativePacket<NativePacketType::PoseAck>
+	{
+		uint32_t side = 0;
+		uint32_t acknowledged = 0;
+	};
+
+	// App asks for an encoding, driver replies with the one it's going to accept.
+	// Either end forgets any delta state when this goes by.
+	struct PoseEncodingPacket : TypedNativePacket<NativePacketType::PoseEncoding>
+	{
+		PoseEncodingType encoding = PoseEncodingType::Full;
+	};
+
+	void encodeOrientation(const Eigen::Quaternionf& orientation,
+						   int16_t encoded[3],
+						   uint8_t& largestIndex);
+	Eigen::Quaternionf decodeOrientation(const int16_t encoded[3], uint8_t largestIndex);
+
+	// App side. encode() is called from the main thread, acknowledge() from the receive thread.
+	class PoseEncoder
+	{
+	public:
+		void reset();
+
+		// Out must already be stamped, the sequence is what the driver acknowledges.
+		// Returns false if the pose can't be represented, send the full packet instead.
+		bool encode(const HandTransformPacket& pose, CompactHandTransformPacket& out);
+		void acknowledge(HandSide side, uint32_t sequence);
+
+	private:
+		struct HistoryEntry
+		{
+			uint32_t sequence = 0;
+			int32_t position[3] = {0, 0, 0}; // Delta units, exactly what the decoder has
+		};
+
+		HistoryEntry mHistory[HandSide_MAX][POSE_HISTORY_SIZE];
+		std::atomic<uint32_t> mAcknowledged[HandSide_MAX] = {0, 0};
+	};
+
+	// Driver side
+	class PoseDecoder
+	{
+	public:
+		void reset();
+
+		// Returns false if it's a delta against a frame we don't have
+		bool decode(const CompactHandTransformPacket& packet, HandTransformPacket& out);
+
+	private:
+		struct HistoryEntry
+		{
+			uint32_t sequence = 0;
+			int32_t position[3] = {0, 0, 0};
+		};
+
+		HistoryEntry mHistory[HandSide_MAX][POSE_HISTORY_SIZE];
+	};
+
+} // namespace HOL
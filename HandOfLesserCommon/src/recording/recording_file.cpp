@@ -0,0 +1,456 @@
+#include "recording_file.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace HOL;
+
+static uint32_t alignRecordStride(uint32_t size)
+{
+	return (size + 7) & ~7u;
+}
+
+static uint64_t chunkSize(uint32_t recordCount, uint32_t recordStride)
+{
+	return sizeof(RecordingChunkHeader) + recordCount * (sizeof(int64_t) + recordStride);
+}
+
+RecordingWriter::~RecordingWriter()
+{
+	close();
+}
+
+bool RecordingWriter::open(const std::string& path,
+						   uint32_t recordType,
+						   uint32_t recordSize,
+						   uint32_t recordsPerChunk)
+{
+	close();
+
+	this->mFile = fopen(path.c_str(), "wb");
+	if (this->mFile == nullptr)
+	{
+		std::cerr << "Failed to open recording " << path << std::endl;
+		return false;
+	}
+
+	this->mHeader = RecordingHeader();
+	this->mHeader.recordType = recordType;
+	this->mHeader.recordSize = recordSize;
+	this->mHeader.recordStride = alignRecordStride(recordSize);
+	this->mHeader.recordsPerChunk = std::max<uint32_t>(recordsPerChunk, 1);
+	this->mHeader.created = std::chrono::duration_cast<std::chrono::seconds>(
+								std::chrono::system_clock::now().time_since_epoch())
+								.count();
+
+	fwrite(&this->mHeader, sizeof(RecordingHeader), 1, this->mFile);
+
+	this->mRecordCount = 0;
+	this->mNextOffset = sizeof(RecordingHeader);
+	this->mIndex.clear();
+	this->mTimestamps.clear();
+	this->mTimestamps.reserve(this->mHeader.recordsPerChunk);
+	this->mRecords.clear();
+	this->mRecords.reserve((size_t)this->mHeader.recordsPerChunk * this->mHeader.recordStride);
+
+	this->mClosing = false;
+	this->mThread = std::thread(&RecordingWriter::writeLoop, this);
+	return true;
+}
+
+void RecordingWriter::append(const void* record, int64_t timestamp)
+{
+	if (this->mFile == nullptr)
+	{
+		return;
+	}
+
+	// Padding is zeroed so the same records always make the same file
+	size_t offset = this->mRecords.size();
+	this->mRecords.resize(offset + this->mHeader.recordStride, 0);
+	memcpy(this->mRecords.data() + offset, record, this->mHeader.recordSize);
+	this->mTimestamps.push_back(timestamp);
+
+	if (this->mTimestamps.size() >= this->mHeader.recordsPerChunk)
+	{
+		this->flushChunk();
+	}
+}
+
+void RecordingWriter::flushChunk()
+{
+	if (this->mTimestamps.empty())
+	{
+		return;
+	}
+
+	RecordingChunkHeader header;
+	header.recordCount = (uint32_t)this->mTimestamps.size();
+	header.firstRecord = this->mRecordCount;
+	header.firstTimestamp = this->mTimestamps.front();
+	header.lastTimestamp = this->mTimestamps.back();
+
+	RecordingIndexEntry entry;
+	entry.offset = this->mNextOffset;
+	entry.firstRecord = header.firstRecord;
+	entry.recordCount = header.recordCount;
+	entry.firstTimestamp = header.firstTimestamp;
+	entry.lastTimestamp = header.lastTimestamp;
+	this->mIndex.push_back(entry);
+
+	size_t timestampBytes = this->mTimestamps.size() * sizeof(int64_t);
+	std::vector<char> chunk(sizeof(RecordingChunkHeader) + timestampBytes + this->mRecords.size());
+	memcpy(chunk.data(), &header, sizeof(RecordingChunkHeader));
+	memcpy(chunk.data() + sizeof(RecordingChunkHeader), this->mTimestamps.data(), timestampBytes);
+	memcpy(chunk.data() + sizeof(RecordingChunkHeader) + timestampBytes,
+		   this->mRecords.data(),
+		   this->mRecords.size());
+
+	this->mRecordCount += header.recordCount;
+	this->mNextOffset += chunk.size();
+	this->mTimestamps.clear();
+	this->mRecords.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+		this->mPending.push_back(std::move(chunk));
+	}
+	this->mCondition.notify_one();
+}
+
+void RecordingWriter::writeLoop()
+{
+	std::unique_lock<std::mutex> lock(this->mMutex);
+
+	while (true)
+	{
+		this->mCondition.wait(lock,
+							  [this]() { return this->mClosing || !this->mPending.empty(); });
+
+		if (this->mPending.empty())
+		{
+			return; // Closing and nothing left
+		}
+
+		std::vector<char> chunk = std::move(this->mPending.front());
+		this->mPending.pop_front();
+
+		lock.unlock();
+		fwrite(chunk.data(), 1, chunk.size(), this->mFile);
+		fflush(this->mFile); // Whole chunks or nothing, if we crash after this
+		lock.lock();
+	}
+}
+
+void RecordingWriter::close()
+{
+	if (this->mFile == nullptr)
+	{
+		return;
+	}
+
+	this->flushChunk();
+
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+		this->mClosing = true;
+	}
+	this->mCondition.notify_one();
+	this->mThread.join();
+
+	RecordingFooter footer;
+	footer.indexOffset = this->mNextOffset;
+	footer.chunkCount = this->mIndex.size();
+	footer.recordCount = this->mRecordCount;
+
+	fwrite(this->mIndex.data(), sizeof(RecordingIndexEntry), this->mIndex.size(), this->mFile);
+	fwrite(&footer, sizeof(RecordingFooter), 1, this->mFile);
+	fclose(this->mFile);
+	this->mFile = nullptr;
+}
+
+bool RecordingWriter::isOpen()
+{
+	return this->mFile != nullptr;
+}
+
+uint64_t RecordingWriter::getRecordCount()
+{
+	return this->mRecordCount + this->mTimestamps.size();
+}
+
+RecordingReader::~RecordingReader()
+{
+	close();
+}
+
+bool RecordingReader::open(const std::string& path)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(),
+							  GENERIC_READ,
+							  FILE_SHARE_READ,
+							  nullptr,
+							  OPEN_EXISTING,
+							  FILE_ATTRIBUTE_NORMAL,
+							  nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		std::cerr << "Failed to open recording " << path << std::endl;
+		return false;
+	}
+	this->mFile = file;
+
+	LARGE_INTEGER size;
+	GetFileSizeEx(file, &size);
+	this->mSize = (uint64_t)size.QuadPart;
+
+	if (this->mSize > 0)
+	{
+		this->mMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (this->mMapping != nullptr)
+		{
+			this->mData = (const char*)MapViewOfFile(this->mMapping, FILE_MAP_READ, 0, 0, 0);
+		}
+	}
+#else
+	this->mFile = ::open(path.c_str(), O_RDONLY);
+	if (this->mFile < 0)
+	{
+		std::cerr << "Failed to open recording " << path << std::endl;
+		return false;
+	}
+
+	struct stat info;
+	fstat(this->mFile, &info);
+	this->mSize = (uint64_t)info.st_size;
+
+	if (this->mSize > 0)
+	{
+		void* data = mmap(nullptr, this->mSize, PROT_READ, MAP_PRIVATE, this->mFile, 0);
+		this->mData = data == MAP_FAILED ? nullptr : (const char*)data;
+	}
+#endif
+
+	if (this->mData == nullptr || this->mSize < sizeof(RecordingHeader))
+	{
+		std::cerr << "Recording " << path << " is empty or couldn't be mapped" << std::endl;
+		close();
+		return false;
+	}
+
+	memcpy(&this->mHeader, this->mData, sizeof(RecordingHeader));
+	if (this->mHeader.magic != RECORDING_MAGIC || this->mHeader.version != RECORDING_VERSION
+		|| this->mHeader.recordStride < this->mHeader.recordSize
+		|| this->mHeader.recordStride == 0)
+	{
+		std::cerr << "Recording " << path << " isn't one, or is from another version"
+				  << std::endl;
+		close();
+		return false;
+	}
+
+	this->mRecovered = !this->readIndex();
+	if (this->mRecovered && !this->scanChunks())
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+bool RecordingReader::readIndex()
+{
+	if (this->mSize < sizeof(RecordingHeader) + sizeof(RecordingFooter))
+	{
+		return false;
+	}
+
+	RecordingFooter footer;
+	memcpy(&footer, this->mData + this->mSize - sizeof(RecordingFooter), sizeof(RecordingFooter));
+
+	uint64_t indexSize = footer.chunkCount * sizeof(RecordingIndexEntry);
+	if (footer.magic != RECORDING_FOOTER_MAGIC
+		|| footer.indexOffset + indexSize + sizeof(RecordingFooter) != this->mSize)
+	{
+		return false;
+	}
+
+	this->mIndex.resize(footer.chunkCount);
+	memcpy(this->mIndex.data(), this->mData + footer.indexOffset, indexSize);
+	this->mRecordCount = footer.recordCount;
+
+	// Don't trust an index that points outside the file
+	for (const RecordingIndexEntry& entry : this->mIndex)
+	{
+		if (entry.offset + chunkSize(entry.recordCount, this->mHeader.recordStride)
+			> footer.indexOffset)
+		{
+			this->mIndex.clear();
+			this->mRecordCount = 0;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool RecordingReader::scanChunks()
+{
+	this->mIndex.clear();
+	this->mRecordCount = 0;
+
+	uint64_t offset = sizeof(RecordingHeader);
+	while (offset + sizeof(RecordingChunkHeader) <= this->mSize)
+	{
+		RecordingChunkHeader header;
+		memcpy(&header, this->mData + offset, sizeof(RecordingChunkHeader));
+
+		uint64_t size = chunkSize(header.recordCount, this->mHeader.recordStride);
+		if (header.magic != RECORDING_CHUNK_MAGIC || header.recordCount == 0
+			|| header.firstRecord != this->mRecordCount || offset + size > this->mSize)
+		{
+			break; // Cut off mid-chunk, or the index
+		}
+
+		RecordingIndexEntry entry;
+		entry.offset = offset;
+		entry.firstRecord = header.firstRecord;
+		entry.recordCount = header.recordCount;
+		entry.firstTimestamp = header.firstTimestamp;
+		entry.lastTimestamp = header.lastTimestamp;
+		this->mIndex.push_back(entry);
+
+		this->mRecordCount += header.recordCount;
+		offset += size;
+	}
+
+	return true;
+}
+
+void RecordingReader::close()
+{
+#ifdef _WIN32
+	if (this->mData != nullptr)
+	{
+		UnmapViewOfFile(this->mData);
+	}
+	if (this->mMapping != nullptr)
+	{
+		CloseHandle(this->mMapping);
+	}
+	if (this->mFile != nullptr)
+	{
+		CloseHandle(this->mFile);
+	}
+	this->mMapping = nullptr;
+	this->mFile = nullptr;
+#else
+	if (this->mData != nullptr)
+	{
+		munmap((void*)this->mData, this->mSize);
+	}
+	if (this->mFile >= 0)
+	{
+		::close(this->mFile);
+	}
+	this->mFile = -1;
+#endif
+
+	this->mData = nullptr;
+	this->mSize = 0;
+	this->mIndex.clear();
+	this->mRecordCount = 0;
+}
+
+bool RecordingReader::isOpen()
+{
+	return this->mData != nullptr;
+}
+
+const RecordingHeader& RecordingReader::getHeader()
+{
+	return this->mHeader;
+}
+
+uint64_t RecordingReader::getRecordCount()
+{
+	return this->mRecordCount;
+}
+
+bool RecordingReader::wasRecovered()
+{
+	return this->mRecovered;
+}
+
+const RecordingIndexEntry& RecordingReader::getChunk(uint64_t record)
+{
+	// Last chunk starting at or before the record
+	auto chunk = std::upper_bound(this->mIndex.begin(),
+								  this->mIndex.end(),
+								  record,
+								  [](uint64_t record, const RecordingIndexEntry& entry)
+								  { return record < entry.firstRecord; });
+	return *(chunk - 1);
+}
+
+int64_t RecordingReader::getTimestamp(uint64_t record)
+{
+	const RecordingIndexEntry& chunk = this->getChunk(record);
+	const char* timestamps = this->mData + chunk.offset + sizeof(RecordingChunkHeader);
+
+	int64_t timestamp;
+	memcpy(&timestamp,
+		   timestamps + (record - chunk.firstRecord) * sizeof(int64_t),
+		   sizeof(int64_t));
+	return timestamp;
+}
+
+const void* RecordingReader::getRecord(uint64_t record)
+{
+	const RecordingIndexEntry& chunk = this->getChunk(record);
+	const char* records = this->mData + chunk.offset + sizeof(RecordingChunkHeader)
+						  + chunk.recordCount * sizeof(int64_t);
+
+	return records + (record - chunk.firstRecord) * this->mHeader.recordStride;
+}
+
+uint64_t RecordingReader::findRecord(int64_t timestamp)
+{
+	if (this->mRecordCount == 0)
+	{
+		return 0;
+	}
+
+	// Index narrows it down to a chunk, then search the chunk's timestamps
+	auto chunk = std::upper_bound(this->mIndex.begin(),
+								  this->mIndex.end(),
+								  timestamp,
+								  [](int64_t timestamp, const RecordingIndexEntry& entry)
+								  { return timestamp < entry.firstTimestamp; });
+	if (chunk == this->mIndex.begin())
+	{
+		return 0;
+	}
+	chunk--;
+
+	const int64_t* timestamps
+		= (const int64_t*)(this->mData + chunk->offset + sizeof(RecordingChunkHeader));
+	const int64_t* found = std::upper_bound(timestamps, timestamps + chunk->recordCount, timestamp);
+
+	return chunk->firstRecord + (found - timestamps) - 1;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace HOL
+{
+	static const uint32_t RECORDING_MAGIC = 0x524c4f48;		  // HOLR
+	static const uint32_t RECORDING_CHUNK_MAGIC = 0x4b4e4843; // CHNK
+	static const uint32_t RECORDING_FOOTER_MAGIC = 0x58444e49; // INDX
+	static const uint32_t RECORDING_VERSION = 1;
+
+	// About 2.8 seconds of hands at 90hz
+	static const uint32_t RECORDING_DEFAULT_CHUNK_RECORDS = 256;
+
+	// File layout, all little endian and 8 byte aligned:
+	//   RecordingHeader
+	//   Chunks of [RecordingChunkHeader][int64_t timestamps[n]][records[n], each recordStride]
+	//   RecordingIndexEntry per chunk, then RecordingFooter
+	// Chunks are only written whole, so a file that was never closed is still good up to
+	// its last chunk. The index and footer are just there so we don't have to scan for them.
+	struct RecordingHeader
+	{
+		uint32_t magic = RECORDING_MAGIC;
+		uint32_t version = RECORDING_VERSION;
+		uint32_t recordType = 0; // Whatever the writer says it is, readers check it
+		uint32_t recordSize = 0;
+		uint32_t recordStride = 0; // recordSize rounded up to 8
+		uint32_t recordsPerChunk = 0;
+		int64_t created = 0; // Seconds since the unix epoch
+		uint8_t reserved[32] = {};
+	};
+
+	struct RecordingChunkHeader
+	{
+		uint32_t magic = RECORDING_CHUNK_MAGIC;
+		uint32_t recordCount = 0;
+		uint64_t firstRecord = 0;
+		int64_t firstTimestamp = 0;
+		int64_t lastTimestamp = 0;
+	};
+
+	struct RecordingIndexEntry
+	{
+		uint64_t offset = 0; // Of the chunk header
+		uint64_t firstRecord = 0;
+		uint32_t recordCount = 0;
+		uint32_t padding = 0;
+		int64_t firstTimestamp = 0;
+		int64_t lastTimestamp = 0;
+	};
+
+	struct RecordingFooter
+	{
+		uint64_t indexOffset = 0;
+		uint64_t chunkCount = 0;
+		uint64_t recordCount = 0;
+		uint32_t magic = RECORDING_FOOTER_MAGIC;
+		uint32_t padding = 0;
+	};
+
+	// Append-only writer. Records are batched into chunks in memory and a thread of its own
+	// writes them out, so append() never waits on the disk.
+	class RecordingWriter
+	{
+	public:
+		~RecordingWriter();
+
+		bool open(const std::string& path,
+				  uint32_t recordType,
+				  uint32_t recordSize,
+				  uint32_t recordsPerChunk = RECORDING_DEFAULT_CHUNK_RECORDS);
+
+		// Timestamps should never go backwards, readers search on them
+		void append(const void* record, int64_t timestamp);
+
+		// Writes the last chunk and the index. Also happens on destruction.
+		void close();
+
+		bool isOpen();
+		uint64_t getRecordCount();
+
+	private:
+		void flushChunk();
+		void writeLoop();
+
+		FILE* mFile = nullptr;
+		RecordingHeader mHeader;
+		uint64_t mRecordCount = 0;
+		uint64_t mNextOffset = 0;
+
+		// Chunk being filled
+		std::vector<int64_t> mTimestamps;
+		std::vector<char> mRecords;
+		std::vector<RecordingIndexEntry> mIndex;
+
+		// Chunks waiting for the write thread
+		std::thread mThread;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::deque<std::vector<char>> mPending;
+		bool mClosing = false;
+	};
+
+	// Maps the whole file and reads straight out of the mapping
+	class RecordingReader
+	{
+	public:
+		~RecordingReader();
+
+		// Falls back to scanning the chunks if the file was never closed
+		bool open(const std::string& path);
+		void close();
+
+		bool isOpen();
+		const RecordingHeader& getHeader();
+		uint64_t getRecordCount();
+		bool wasRecovered(); // No index, had to scan for it
+
+		int64_t getTimestamp(uint64_t record);
+		const void* getRecord(uint64_t record);
+
+		// Last record at or before timestamp, 0 if they're all after it
+		uint64_t findRecord(int64_t timestamp);
+
+	private:
+		bool readIndex();
+		bool scanChunks();
+		const RecordingIndexEntry& getChunk(uint64_t record);
+
+		const char* mData = nullptr;
+		uint64_t mSize = 0;
+		RecordingHeader mHeader;
+		std::vector<RecordingIndexEntry> mIndex;
+		uint64_t mRecordCount = 0;
+		bool mRecovered = false;
+
+#ifdef _WIN32
+		void* mFile = nullptr;
+		void* mMapping = nullptr;
+#else
+		int mFile = -1;
+#endif
+	};
+} // namespace HOL
@@ -59,11 +59,18 @@ namespace HOL
 		struct GeneralSettings
 		{
 			int MotionPredictionMS = 15; // ms
-			int UpdateIntervalMS = 1;
+			float UpdateRateHz = 1000.f;
+			float UpdatePhaseMS = 0.f; // Where in the period the main loop wakes up
+			int UpdateSpinUS = 200;	   // Spin instead of sleeping this close to the deadline
+			bool runtimeFramePacing = false; // Sample and predict for SteamVR's frames
+			float runtimeLatencyMS = 10.f;	 // From SteamVR's frame to photons
 			float steamPoseTimeOffset = .0f;
 			float linearVelocityMultiplier = 0.f;
 			float angularVelocityMultiplier = 0.f;
 			bool forceInactive = false;
+			bool useSharedMemory = false; // UDP otherwise
+			bool compactPoseEncoding = false; // Quantized poses, for when the driver isn't local
+			bool sendSkeleton = true; // Full joint skeleton for SteamVR skeletal input
 		};
 
 		struct HandPoseSettings
@@ -95,6 +102,32 @@ namespace HOL
 	
 		};
 
+		// Dead-bands for change detection, anything that moved less than this since we last
+		// sent it isn't sent again until the keep-alive runs out.
+		struct TransmitSettings
+		{
+			bool changeDetection = true;
+			int keepAliveMS = 500;
+			float poseDeadbandMM = 0.5f;
+			float poseDeadbandDegrees = 0.25f;
+			float skeletonDeadbandMM = 1.f; // Any one joint
+			float steamVRInputDeadband = 0.005f;
+			float oscDeadband = 0.003f; // VRChat only has 8 bits, 0.0078 per step
+		};
+
+		// One-euro smoothing on the joints and palm, before curl, gestures or anything else
+		// looks at them. Cutoffs go up by beta per m/s or rad/s, so moving fast doesn't lag.
+		struct FilterSettings
+		{
+			bool enabled = false;
+			float positionMinCutoffHz = 1.f;
+			float positionBeta = 20.f;
+			float rotationMinCutoffHz = 1.f;
+			float rotationBeta = 5.f;
+			float derivativeCutoffHz = 1.f;
+			float velocityMultiplier = 1.f; // Filtered palm velocity, instead of the general ones
+		};
+
 		struct InputSettings
 		{
 			bool sendOscInput = true;
@@ -111,6 +144,8 @@ namespace HOL
 			DebugSettings debug;
 			VisualizerSettings visualizer;
 			InputSettings input;
+			TransmitSettings transmit;
+			FilterSettings filter;
 		};
 	}
 } // namespace HOL::settings
\ No newline at end of file
@@ -1,26 +1,265 @@
 #include "nativetransport.h"
+#include "src/packet/frame_bundle.h"
+#include "src/packet/metrics_packet.h"
+#include "src/util/time_utils.h"
+#include "src/util/trace.h"
+#include <iostream>
+
+static_assert(HOL::FRAME_BUNDLE_MAX_SIZE <= HOL::RECEIVE_SLOT_SIZE,
+			  "Frame bundles must fit in a single receive slot");
+static_assert(sizeof(HOL::MetricsPacket) <= HOL::RECEIVE_SLOT_SIZE,
+			  "Metrics must fit in a single receive slot");
 
 void HOL::NativeTransport::init(int listenPort)
 {
+	this->mPool.init(RECEIVE_POOL_SIZE, RECEIVE_SLOT_SIZE);
 	this->mTransport.init(listenPort);
 }
 
 void HOL::NativeTransport::send(int port, char* buffer, size_t size)
 {
-	this->mTransport.send(port, buffer, size);
+	HOL_TRACE_SCOPE("NativeTransport::send");
+	std::lock_guard<std::mutex> lock(this->mSendMutex);
+
+	// Ring only fills up if the driver stopped reading, UDP won't fare any better.
+	bool sent = this->mSharedMemorySend && port == this->mSharedMemoryPort
+					? this->mSharedMemory.send(buffer, size)
+					: this->mTransport.send(port, buffer, size);
+
+	if (sent)
+	{
+		this->mPacketsSent->add();
+		this->mBytesSent->add(size);
+	}
+	else
+	{
+		this->mSendFailures->add();
+	}
+}
+
+// Same as send(), but fills in the header first
+void HOL::NativeTransport::sendPacket(int port, HOL::NativePacket* packet, size_t size)
+{
+	this->stamp(packet);
+	this->send(port, (char*)packet, size);
 }
 
-// Pointer valid until next receive() call
-HOL::NativePacket* HOL::NativeTransport::receive()
+// Next sequence number for its type, and the time it went out.
+// Anything sent as part of a bundle gets stamped here too, not just the bundle.
+void HOL::NativeTransport::stamp(HOL::NativePacket* packet, int64_t captureTime)
 {
-	size_t length = this->mTransport.receive();
-	if (length > sizeof(HOL::NativePacket))
+	std::lock_guard<std::mutex> lock(this->mSendMutex);
+	this->stampLocked(packet, captureTime);
+}
+
+void HOL::NativeTransport::stampLocked(HOL::NativePacket* packet, int64_t captureTime)
+{
+	// Never 0, that means unstamped
+	uint32_t& sequence = this->mSequences[HOL::getSequenceType(packet->packetType)];
+	sequence = sequence + 1 == 0 ? 1 : sequence + 1;
+
+	packet->sequence = sequence;
+	if (captureTime != 0)
 	{
-		// Do proper checks at some point
-		return (HOL::NativePacket*)(this->mTransport.getReceiveBuffer());
+		packet->captureTime = captureTime;
 	}
-	else
+	packet->sendTime = HOL::steadyNanoseconds();
+}
+
+void HOL::NativeTransport::updateSharedMemory(bool enabled, int sharedMemoryPort)
+{
+	std::lock_guard<std::mutex> lock(this->mSendMutex);
+
+	if (enabled && !this->mSharedMemory.isOpen())
+	{
+		if (!this->mSharedMemory.init(true))
+		{
+			std::cerr << "Failed to open shared memory, falling back to UDP" << std::endl;
+		}
+	}
+	else if (!enabled && this->mSharedMemory.isOpen())
 	{
-		return nullptr;
+		this->mSharedMemory.close();
 	}
+
+	this->mSharedMemorySend = this->mSharedMemory.isOpen();
+	this->mSharedMemoryPort = sharedMemoryPort;
+
+	if (this->mSharedMemorySend)
+	{
+		// Otherwise the driver gives up on us when there's nothing to send
+		this->mSharedMemory.heartbeat();
+	}
+}
+
+// Returns false if shared memory isn't in use, in which case send the packet as normal.
+// Only stamped if it was published, so it doesn't use up a sequence number otherwise.
+bool HOL::NativeTransport::publishPose(HOL::HandTransformPacket* packet, int64_t captureTime)
+{
+	HOL_TRACE_SCOPE("NativeTransport::publishPose");
+	std::lock_guard<std::mutex> lock(this->mSendMutex);
+
+	if (!this->mSharedMemorySend)
+	{
+		return false;
+	}
+
+	this->stampLocked(packet, captureTime);
+	this->mSharedMemory.publishPose(packet);
+	this->mPacketsSent->add();
+	this->mBytesSent->add(sizeof(HOL::HandTransformPacket));
+	return true;
+}
+
+bool HOL::NativeTransport::initSharedMemoryReceive()
+{
+	this->mSharedMemoryReceive = this->mSharedMemory.init(false);
+	return this->mSharedMemoryReceive;
+}
+
+// Drains everything that is queued up in one go instead of one packet per wakeup.
+// Packets stay valid until the next receiveBatch() call, take a PacketView to keep one longer.
+std::span<HOL::ReceivedPacket> HOL::NativeTransport::receiveBatch()
+{
+	this->releaseBatch();
+
+	// Whatever isn't free now is being held on to by views from earlier batches
+	this->mReceiveSlotsFree->set((int64_t)this->mPool.getAvailableCount());
+
+	if (this->mCancelled)
+	{
+		return std::span<HOL::ReceivedPacket>();
+	}
+
+	size_t count = 0;
+	bool waitForUdp = true;
+
+	if (this->mSharedMemoryReceive && this->mSharedMemory.isProducerConnected())
+	{
+		// Wakes up for UDP too, which still carries anything from peers that aren't on
+		// shared memory
+		this->mSharedMemory.wait(SHARED_MEMORY_WAIT_MS, this->mTransport.getReadHandle());
+
+		// Only ever the latest pose, anything older has already been overwritten
+		for (int i = 0; i < HOL::HandSide_MAX; i++)
+		{
+			char* slot = this->acquireSlot();
+			if (slot == nullptr)
+			{
+				break;
+			}
+
+			if (this->mSharedMemory.receivePose((HOL::HandSide)i, (HOL::HandTransformPacket*)slot))
+			{
+				this->mPackets[count].packet = (HOL::NativePacket*)slot;
+				this->mPackets[count].length = sizeof(HOL::HandTransformPacket);
+				this->mPackets[count].pool = &this->mPool;
+				count++;
+			}
+		}
+
+		for (int i = 0; i < RECEIVE_BATCH_SIZE; i++)
+		{
+			char* slot = this->acquireSlot();
+			if (slot == nullptr)
+			{
+				break;
+			}
+
+			size_t length = this->mSharedMemory.receive(slot, RECEIVE_SLOT_SIZE);
+			if (length == 0)
+			{
+				break;
+			}
+
+			if (length > sizeof(HOL::NativePacket))
+			{
+				this->mPackets[count].packet = (HOL::NativePacket*)slot;
+				this->mPackets[count].length = length;
+				this->mPackets[count].pool = &this->mPool;
+				count++;
+			}
+		}
+
+		// Still pick up anything sent over UDP, but don't block on it
+		waitForUdp = false;
+	}
+
+	size_t slotCount = 0;
+	while (slotCount < RECEIVE_BATCH_SIZE)
+	{
+		char* slot = this->acquireSlot();
+		if (slot == nullptr)
+		{
+			// Only if views are being leaked, the pool is sized well past what we hold on to
+			break;
+		}
+
+		this->mUdpSlots[slotCount++] = slot;
+	}
+
+	size_t received
+		= this->mTransport.receiveBatch(this->mUdpSlots, slotCount, this->mUdpLengths, waitForUdp);
+
+	for (size_t i = 0; i < received; i++)
+	{
+		// Anything smaller can't even be a header. Views check the rest.
+		size_t length = this->mUdpLengths[i];
+		if (length > sizeof(HOL::NativePacket))
+		{
+			this->mPackets[count].packet = (HOL::NativePacket*)this->mUdpSlots[i];
+			this->mPackets[count].length = length;
+			this->mPackets[count].pool = &this->mPool;
+			count++;
+		}
+	}
+
+	this->mReceiveBatchSize->set((int64_t)count);
+	return std::span<HOL::ReceivedPacket>(this->mPackets, count);
+}
+
+// Slot is released along with the rest of the batch, whether or not anything went in it
+char* HOL::NativeTransport::acquireSlot()
+{
+	char* slot = this->mPool.acquire();
+	if (slot != nullptr)
+	{
+		this->mBatchSlots[this->mBatchSlotCount++] = slot;
+	}
+
+	return slot;
+}
+
+void HOL::NativeTransport::releaseBatch()
+{
+	for (size_t i = 0; i < this->mBatchSlotCount; i++)
+	{
+		this->mPool.release(this->mBatchSlots[i]);
+	}
+
+	this->mBatchSlotCount = 0;
+}
+
+// Makes a blocked receiveBatch() return early, with whatever it has
+void HOL::NativeTransport::wake()
+{
+	if (this->mSharedMemoryReceive)
+	{
+		this->mSharedMemory.wake();
+	}
+
+	this->mTransport.wake();
+}
+
+// Wakes up a blocked receiveBatch(), and makes every call after it return nothing.
+void HOL::NativeTransport::cancel()
+{
+	this->mCancelled = true;
+
+	if (this->mSharedMemoryReceive)
+	{
+		this->mSharedMemory.wake();
+	}
+
+	this->mTransport.cancel();
 }
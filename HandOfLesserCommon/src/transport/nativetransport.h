@@ -1,19 +1,80 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
 #include "transport.h"
+#include "sharedmemorytransport.h"
+#include "packet_slot_pool.h"
 #include "src/packet/nativepacket.h"
+#include "src/packet/packet_view.h"
+#include "src/util/metrics.h"
 
 namespace HOL
 {
+// Longest the consumer sleeps on shared memory before checking the producer is still there
+static const int SHARED_MEMORY_WAIT_MS = 100;
+
+// Most a single batch can take from UDP and shared memory combined
+static const int RECEIVE_BATCH_MAX_PACKETS = RECEIVE_BATCH_SIZE * 2 + HOL::HandSide_MAX;
+
+// Enough for a full batch plus plenty of views that are still being held on to
+static const int RECEIVE_POOL_SIZE = RECEIVE_BATCH_MAX_PACKETS * 2;
+
 class NativeTransport
 {
 public:
 	void init(int listenPort);
 	void send(int port, char* buffer, size_t size);
-	HOL::NativePacket* receive();
+	void sendPacket(int port, HOL::NativePacket* packet, size_t size);
+	void stamp(HOL::NativePacket* packet, int64_t captureTime = 0);
+	std::span<HOL::ReceivedPacket> receiveBatch();
+	void wake();
+	void cancel();
+
+	// Sending side. Call every frame, sends to sharedMemoryPort go through shared memory
+	// while enabled, and the consumer keeps listening to it for as long as we keep calling this.
+	void updateSharedMemory(bool enabled, int sharedMemoryPort);
+	bool publishPose(HOL::HandTransformPacket* packet, int64_t captureTime = 0);
+
+	// Receiving side. Shared memory is used whenever a producer is connected, UDP otherwise.
+	bool initSharedMemoryReceive();
 
 private:
+	void stampLocked(HOL::NativePacket* packet, int64_t captureTime);
+	void releaseBatch();
+	char* acquireSlot();
+
 	Transport mTransport;
+	std::atomic<bool> mCancelled = false;
+
+	// The UI thread sends settings while the main thread sends everything else,
+	// and neither the address cache nor the shared memory ring can take that.
+	std::mutex mSendMutex;
+	std::unordered_map<HOL::NativePacketType, uint32_t> mSequences;
+
+	// Every packet lives in a pool slot. We hold a reference on the slots of the current
+	// batch until the next one, PacketViews hold their own for as long as they need.
+	HOL::PacketSlotPool mPool;
+	HOL::ReceivedPacket mPackets[RECEIVE_BATCH_MAX_PACKETS];
+	char* mBatchSlots[RECEIVE_BATCH_MAX_PACKETS];
+	size_t mBatchSlotCount = 0;
+	char* mUdpSlots[RECEIVE_BATCH_SIZE];
+	size_t mUdpLengths[RECEIVE_BATCH_SIZE];
+
+	SharedMemoryTransport mSharedMemory;
+	bool mSharedMemorySend = false;
+	bool mSharedMemoryReceive = false;
+	int mSharedMemoryPort = -1;
+
+	// Shared by every transport in the process, see getMetrics()
+	HOL::MetricCounter* mPacketsSent = HOL::getMetrics().getCounter("packets_sent");
+	HOL::MetricCounter* mBytesSent = HOL::getMetrics().getCounter("bytes_sent");
+	HOL::MetricCounter* mSendFailures = HOL::getMetrics().getCounter("send_failures");
+	HOL::MetricGauge* mReceiveBatchSize = HOL::getMetrics().getGauge("receive_batch");
+	HOL::MetricGauge* mReceiveSlotsFree = HOL::getMetrics().getGauge("receive_slots_free");
 };
 
 } // namespace HOL
@@ -0,0 +1,77 @@
+#include "packet_slot_pool.h"
+
+using namespace HOL;
+
+void PacketSlotPool::init(size_t slotCount, size_t slotSize)
+{
+	this->mBuffer = std::make_unique<char[]>(slotCount * slotSize);
+	this->mReferences = std::make_unique<std::atomic<uint32_t>[]>(slotCount);
+	this->mSlotCount = slotCount;
+	this->mSlotSize = slotSize;
+	this->mNextSlot = 0;
+
+	for (size_t i = 0; i < slotCount; i++)
+	{
+		this->mReferences[i] = 0;
+	}
+}
+
+char* PacketSlotPool::acquire()
+{
+	// Start where we left off, the slots right behind us are the likeliest to still be held
+	for (size_t i = 0; i < this->mSlotCount; i++)
+	{
+		size_t index = (this->mNextSlot + i) % this->mSlotCount;
+
+		uint32_t expected = 0;
+		if (this->mReferences[index].compare_exchange_strong(
+				expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			this->mNextSlot = (index + 1) % this->mSlotCount;
+			return this->mBuffer.get() + (index * this->mSlotSize);
+		}
+	}
+
+	return nullptr;
+}
+
+void PacketSlotPool::retain(const void* pointer)
+{
+	this->mReferences[getSlotIndex(pointer)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void PacketSlotPool::release(const void* pointer)
+{
+	this->mReferences[getSlotIndex(pointer)].fetch_sub(1, std::memory_order_release);
+}
+
+bool PacketSlotPool::owns(const void* pointer)
+{
+	const char* start = this->mBuffer.get();
+	const char* position = (const char*)pointer;
+	return position >= start && position < start + (this->mSlotCount * this->mSlotSize);
+}
+
+size_t PacketSlotPool::getSlotSize()
+{
+	return this->mSlotSize;
+}
+
+size_t PacketSlotPool::getAvailableCount()
+{
+	size_t count = 0;
+	for (size_t i = 0; i < this->mSlotCount; i++)
+	{
+		if (this->mReferences[i].load(std::memory_order_relaxed) == 0)
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+size_t PacketSlotPool::getSlotIndex(const void* pointer)
+{
+	return ((const char*)pointer - this->mBuffer.get()) / this->mSlotSize;
+}
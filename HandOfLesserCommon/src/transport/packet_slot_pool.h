@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace HOL
+{
+// Fixed set of receive buffers, reference counted so whatever was received into a slot
+// stays put for as long as someone holds on to it. Slots are only ever acquired by the
+// receive thread, but can be released from anywhere.
+class PacketSlotPool
+{
+public:
+	void init(size_t slotCount, size_t slotSize);
+
+	// Returns nullptr if every slot is in use
+	char* acquire();
+
+	// Any pointer into a slot will do, not just the start of it
+	void retain(const void* pointer);
+	void release(const void* pointer);
+
+	bool owns(const void* pointer);
+	size_t getSlotSize();
+	size_t getAvailableCount();
+
+private:
+	size_t getSlotIndex(const void* pointer);
+
+	std::unique_ptr<char[]> mBuffer;
+	std::unique_ptr<std::atomic<uint32_t>[]> mReferences;
+	size_t mSlotCount = 0;
+	size_t mSlotSize = 0;
+	size_t mNextSlot = 0;
+};
+} // namespace HOL
@@ -0,0 +1,523 @@
+#include "sharedmemorytransport.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace HOL;
+
+static const uint32_t RING_WRAP_MARKER = 0xFFFFFFFF;
+static const size_t RING_ALIGNMENT = 8;
+
+#ifndef _WIN32
+static void signalWakeFifo(int fifo)
+{
+	// Only fails if it's full, which wakes the consumer up just the same
+	char wake = 1;
+	if (write(fifo, &wake, sizeof(wake)) < 0 && errno != EAGAIN)
+	{
+		std::cerr << "Wake failed: " << std::strerror(errno) << std::endl;
+	}
+}
+#endif
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free
+				  && std::atomic<uint64_t>::is_always_lock_free,
+			  "Atomics in shared memory must be lock free");
+
+static int64_t steadyMilliseconds()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+			   std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+
+static size_t alignRecordSize(size_t size)
+{
+	return (size + RING_ALIGNMENT - 1) & ~(RING_ALIGNMENT - 1);
+}
+
+SharedMemoryTransport::~SharedMemoryTransport()
+{
+	close();
+}
+
+bool SharedMemoryTransport::init(bool producer, const char* name)
+{
+	if (isOpen())
+	{
+		return true;
+	}
+
+	this->mProducer = producer;
+
+#ifdef _WIN32
+	// Both sides create, whoever comes first gets a zeroed mapping
+	this->mMapping = CreateFileMappingA(INVALID_HANDLE_VALUE,
+									   nullptr,
+									   PAGE_READWRITE,
+									   0,
+									   sizeof(SharedMemoryLayout),
+									   name);
+	if (this->mMapping == nullptr)
+	{
+		std::cerr << "CreateFileMapping failed: " << GetLastError() << std::endl;
+		return false;
+	}
+
+	this->mShared = (SharedMemoryLayout*)MapViewOfFile(
+		this->mMapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedMemoryLayout));
+	if (this->mShared == nullptr)
+	{
+		std::cerr << "MapViewOfFile failed: " << GetLastError() << std::endl;
+		close();
+		return false;
+	}
+
+	std::string eventName = std::string(name) + "Wake";
+	this->mWakeEvent = CreateEventA(nullptr, FALSE, FALSE, eventName.c_str());
+	if (this->mWakeEvent == nullptr)
+	{
+		std::cerr << "CreateEvent failed: " << GetLastError() << std::endl;
+		close();
+		return false;
+	}
+#else
+	this->mFd = shm_open(name, O_RDWR | O_CREAT, 0600);
+	if (this->mFd < 0)
+	{
+		std::cerr << "shm_open failed: " << std::strerror(errno) << std::endl;
+		return false;
+	}
+
+	// Newly created objects are zero-filled, existing ones are left alone
+	if (ftruncate(this->mFd, sizeof(SharedMemoryLayout)) != 0)
+	{
+		std::cerr << "ftruncate failed: " << std::strerror(errno) << std::endl;
+		close();
+		return false;
+	}
+
+	void* mapped = mmap(
+		nullptr, sizeof(SharedMemoryLayout), PROT_READ | PROT_WRITE, MAP_SHARED, this->mFd, 0);
+	if (mapped == MAP_FAILED)
+	{
+		std::cerr << "mmap failed: " << std::strerror(errno) << std::endl;
+		close();
+		return false;
+	}
+
+	this->mShared = (SharedMemoryLayout*)mapped;
+	this->mWakeFifoPath = std::string("/tmp") + name + "Wake";
+#endif
+
+	// Either fresh or left over from an incompatible build. If both sides hit this at the
+	// same time they write the same thing, and nobody uses it before the magic is set.
+	if (this->mShared->magic.load(std::memory_order_acquire) != SHARED_MEMORY_MAGIC
+		|| this->mShared->version != SHARED_MEMORY_VERSION)
+	{
+		std::memset((void*)this->mShared, 0, sizeof(SharedMemoryLayout));
+		this->mShared->version = SHARED_MEMORY_VERSION;
+		this->mShared->magic.store(SHARED_MEMORY_MAGIC, std::memory_order_release);
+	}
+
+	if (producer)
+	{
+		this->mShared->producerHeartbeat.store(steadyMilliseconds(), std::memory_order_relaxed);
+		this->mShared->producerActive.store(1, std::memory_order_release);
+	}
+	else
+	{
+		// Whatever is in there is from a previous session
+		this->mShared->readIndex.store(this->mShared->writeIndex.load(std::memory_order_acquire),
+									   std::memory_order_release);
+
+		for (int i = 0; i < HandSide_MAX; i++)
+		{
+			this->mLastPoseSequence[i]
+				= this->mShared->poses[i].sequence.load(std::memory_order_acquire);
+		}
+
+#ifndef _WIN32
+		if (!createWakeFifo())
+		{
+			close();
+			return false;
+		}
+#endif
+	}
+
+	return true;
+}
+
+void SharedMemoryTransport::close()
+{
+	if (this->mShared != nullptr)
+	{
+		if (this->mProducer)
+		{
+			this->mShared->producerActive.store(0, std::memory_order_release);
+		}
+
+		// Mapping itself sticks around for the other side.
+#ifdef _WIN32
+		UnmapViewOfFile(this->mShared);
+#else
+		munmap(this->mShared, sizeof(SharedMemoryLayout));
+#endif
+		this->mShared = nullptr;
+	}
+
+#ifdef _WIN32
+	if (this->mWakeEvent != nullptr)
+	{
+		CloseHandle(this->mWakeEvent);
+		this->mWakeEvent = nullptr;
+	}
+
+	if (this->mMapping != nullptr)
+	{
+		CloseHandle(this->mMapping);
+		this->mMapping = nullptr;
+	}
+#else
+	if (this->mWakeFifo >= 0)
+	{
+		// Consumer owns it, doesn't stay behind in /tmp once we're done
+		if (!this->mProducer)
+		{
+			unlink(this->mWakeFifoPath.c_str());
+		}
+
+		::close(this->mWakeFifo);
+		this->mWakeFifo = -1;
+	}
+
+	if (this->mFd >= 0)
+	{
+		::close(this->mFd);
+		this->mFd = -1;
+	}
+#endif
+}
+
+bool SharedMemoryTransport::isOpen()
+{
+	return this->mShared != nullptr;
+}
+
+bool SharedMemoryTransport::isProducerConnected()
+{
+	if (!isOpen() || this->mShared->producerActive.load(std::memory_order_acquire) == 0)
+	{
+		return false;
+	}
+
+	// Producer may have crashed without clearing the flag
+	int64_t sinceHeartbeat
+		= steadyMilliseconds() - this->mShared->producerHeartbeat.load(std::memory_order_relaxed);
+	return sinceHeartbeat < SHARED_MEMORY_PRODUCER_TIMEOUT_MS;
+}
+
+void SharedMemoryTransport::heartbeat()
+{
+	this->mShared->producerHeartbeat.store(steadyMilliseconds(), std::memory_order_relaxed);
+}
+
+void SharedMemoryTransport::publishPose(const HOL::HandTransformPacket* packet)
+{
+	if (packet->side >= HandSide_MAX)
+	{
+		return;
+	}
+
+	SharedMemoryPoseSlot& slot = this->mShared->poses[packet->side];
+
+	// Odd while writing, reader retries if it sees that or a change while copying.
+	uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+	slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	std::memcpy((void*)&slot.packet, packet, sizeof(HOL::HandTransformPacket));
+
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+
+	heartbeat();
+	signal();
+}
+
+// Returns false if the ring is full, which only happens if the consumer has stopped reading.
+bool SharedMemoryTransport::send(const char* buffer, size_t size)
+{
+	size_t recordSize = alignRecordSize(sizeof(uint32_t) + size);
+	if (recordSize > SHARED_MEMORY_RING_SIZE / 2)
+	{
+		return false;
+	}
+
+	uint64_t write = this->mShared->writeIndex.load(std::memory_order_relaxed);
+	uint64_t read = this->mShared->readIndex.load(std::memory_order_acquire);
+
+	size_t offset = write & (SHARED_MEMORY_RING_SIZE - 1);
+	size_t untilEnd = SHARED_MEMORY_RING_SIZE - offset;
+
+	// Records never wrap, skip to the start if it doesn't fit
+	size_t required = recordSize > untilEnd ? untilEnd + recordSize : recordSize;
+	if (write + required - read > SHARED_MEMORY_RING_SIZE)
+	{
+		heartbeat();
+		return false;
+	}
+
+	if (recordSize > untilEnd)
+	{
+		std::memcpy(this->mShared->ring + offset, &RING_WRAP_MARKER, sizeof(uint32_t));
+		write += untilEnd;
+		offset = 0;
+	}
+
+	uint32_t length = (uint32_t)size;
+	std::memcpy(this->mShared->ring + offset, &length, sizeof(uint32_t));
+	std::memcpy(this->mShared->ring + offset + sizeof(uint32_t), buffer, size);
+
+	this->mShared->writeIndex.store(write + recordSize, std::memory_order_release);
+
+	heartbeat();
+	signal();
+
+	return true;
+}
+
+// Returns true if there is something to read here or on alsoWaitFor, false on timeout
+bool SharedMemoryTransport::wait(int timeoutMS, WaitHandle alsoWaitFor)
+{
+	if (hasPendingData())
+	{
+		return true;
+	}
+
+	this->mShared->consumerWaiting.store(1, std::memory_order_relaxed);
+
+	// Pairs with the fence in signal(), either it sees us waiting or we see what it published
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	bool otherReady = false;
+	if (!hasPendingData())
+	{
+		otherReady = waitForSignal(timeoutMS, alsoWaitFor);
+	}
+
+	this->mShared->consumerWaiting.store(0, std::memory_order_relaxed);
+
+	return hasPendingData() || otherReady;
+}
+
+// Kicks the consumer out of wait() whether or not there is data, for shutdown.
+void SharedMemoryTransport::wake()
+{
+	if (!isOpen())
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	SetEvent(this->mWakeEvent);
+#else
+	signalWakeFifo(this->mWakeFifo);
+#endif
+}
+
+// Returns true if there is a pose we haven't seen before
+bool SharedMemoryTransport::receivePose(HOL::HandSide side, HOL::HandTransformPacket* packetOut)
+{
+	SharedMemoryPoseSlot& slot = this->mShared->poses[side];
+
+	// Producer only holds the slot for a memcpy, so this shouldn't spin for long
+	for (int attempt = 0; attempt < 16; attempt++)
+	{
+		uint32_t before = slot.sequence.load(std::memory_order_acquire);
+		if (before == this->mLastPoseSequence[side])
+		{
+			return false;
+		}
+
+		if (before & 1)
+		{
+			continue;
+		}
+
+		std::memcpy((void*)packetOut, (void*)&slot.packet, sizeof(HOL::HandTransformPacket));
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (slot.sequence.load(std::memory_order_relaxed) == before)
+		{
+			this->mLastPoseSequence[side] = before;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Copies the next packet in the ring to buffer, returns its length or 0 if there is none.
+size_t SharedMemoryTransport::receive(char* buffer, size_t maxLength)
+{
+	uint64_t read = this->mShared->readIndex.load(std::memory_order_relaxed);
+	uint64_t write = this->mShared->writeIndex.load(std::memory_order_acquire);
+
+	while (read != write)
+	{
+		size_t offset = read & (SHARED_MEMORY_RING_SIZE - 1);
+
+		uint32_t length;
+		std::memcpy(&length, this->mShared->ring + offset, sizeof(uint32_t));
+
+		if (length == RING_WRAP_MARKER)
+		{
+			read += SHARED_MEMORY_RING_SIZE - offset;
+			continue;
+		}
+
+		size_t recordSize = alignRecordSize(sizeof(uint32_t) + length);
+		if (recordSize > write - read)
+		{
+			// Garbage, nothing after this can be trusted either
+			this->mShared->readIndex.store(write, std::memory_order_release);
+			return 0;
+		}
+
+		bool fits = length <= maxLength;
+		if (fits)
+		{
+			std::memcpy(buffer, this->mShared->ring + offset + sizeof(uint32_t), length);
+		}
+
+		read += recordSize;
+		this->mShared->readIndex.store(read, std::memory_order_release);
+
+		if (fits)
+		{
+			return length;
+		}
+	}
+
+	this->mShared->readIndex.store(read, std::memory_order_release);
+	return 0;
+}
+
+bool SharedMemoryTransport::hasPendingData()
+{
+	if (this->mShared->readIndex.load(std::memory_order_relaxed)
+		!= this->mShared->writeIndex.load(std::memory_order_acquire))
+	{
+		return true;
+	}
+
+	for (int i = 0; i < HandSide_MAX; i++)
+	{
+		uint32_t sequence = this->mShared->poses[i].sequence.load(std::memory_order_acquire);
+		if (sequence != this->mLastPoseSequence[i])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void SharedMemoryTransport::signal()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// Skip the syscall if nobody is sleeping
+	if (this->mShared->consumerWaiting.load(std::memory_order_relaxed) == 0)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	SetEvent(this->mWakeEvent);
+#else
+	// Consumer has made a new one since we last opened it, or we never have
+	uint32_t generation = this->mShared->wakeFifoGeneration.load(std::memory_order_acquire);
+	if (generation != this->mWakeFifoGeneration)
+	{
+		if (this->mWakeFifo >= 0)
+		{
+			::close(this->mWakeFifo);
+		}
+
+		// Reading too, so we can't get a SIGPIPE when the consumer goes away
+		this->mWakeFifo = open(this->mWakeFifoPath.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+		if (this->mWakeFifo >= 0)
+		{
+			this->mWakeFifoGeneration = generation;
+		}
+	}
+
+	if (this->mWakeFifo >= 0)
+	{
+		signalWakeFifo(this->mWakeFifo);
+	}
+#endif
+}
+
+#ifndef _WIN32
+// Anything left at the path is from a consumer that didn't get to close(), and the producer
+// may still have it open, so it's replaced rather than reused.
+bool SharedMemoryTransport::createWakeFifo()
+{
+	unlink(this->mWakeFifoPath.c_str());
+	if (mkfifo(this->mWakeFifoPath.c_str(), 0600) != 0)
+	{
+		std::cerr << "mkfifo failed: " << std::strerror(errno) << std::endl;
+		return false;
+	}
+
+	// Reading and writing, so opening it never blocks and wake() can use it too
+	this->mWakeFifo = open(this->mWakeFifoPath.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+	if (this->mWakeFifo < 0)
+	{
+		std::cerr << "Opening wake FIFO failed: " << std::strerror(errno) << std::endl;
+		return false;
+	}
+
+	this->mShared->wakeFifoGeneration.fetch_add(1, std::memory_order_release);
+	return true;
+}
+#endif
+
+// Returns true if it was alsoWaitFor that woke us up
+bool SharedMemoryTransport::waitForSignal(int timeoutMS, WaitHandle alsoWaitFor)
+{
+#ifdef _WIN32
+	HANDLE handles[2] = {this->mWakeEvent, alsoWaitFor};
+	DWORD handleCount = alsoWaitFor != INVALID_WAIT_HANDLE ? 2 : 1;
+	return WaitForMultipleObjects(handleCount, handles, FALSE, timeoutMS) == WAIT_OBJECT_0 + 1;
+#else
+	// poll() skips negative descriptors, so no need to leave it out
+	pollfd descriptors[2] = {{this->mWakeFifo, POLLIN, 0}, {alsoWaitFor, POLLIN, 0}};
+	int count = poll(descriptors, 2, timeoutMS);
+
+	// Empty it out so the next wait sleeps again. Anything published in the meantime
+	// is picked up by the hasPendingData() after this.
+	char drain[64];
+	while (read(this->mWakeFifo, drain, sizeof(drain)) > 0)
+	{
+	}
+
+	return count > 0 && (descriptors[1].revents & POLLIN) != 0;
+#endif
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "transportutil.h"
+#include "src/packet/nativepacket.h"
+
+namespace HOL
+{
+static const uint32_t SHARED_MEMORY_MAGIC = 0x484f4c53; // HOLS
+static const uint32_t SHARED_MEMORY_VERSION = 3;
+
+#ifdef _WIN32
+static const char* const SHARED_MEMORY_DEFAULT_NAME = "Local\\HandOfLesser";
+#else
+static const char* const SHARED_MEMORY_DEFAULT_NAME = "/HandOfLesser";
+#endif
+
+// Must be a power of two
+static const size_t SHARED_MEMORY_RING_SIZE = 64 * 1024;
+
+// Producer counts as gone if it hasn't touched the mapping in this long
+static const int64_t SHARED_MEMORY_PRODUCER_TIMEOUT_MS = 500;
+
+// Latest pose for one hand, published with a seqlock.
+// Sequence is odd while the producer is writing.
+struct SharedMemoryPoseSlot
+{
+	std::atomic<uint32_t> sequence;
+	HOL::HandTransformPacket packet;
+};
+
+// Everything that lives in the mapping. Only ever one producer ( the app )
+// and one consumer ( the driver ).
+struct SharedMemoryLayout
+{
+	std::atomic<uint32_t> magic;
+	uint32_t version;
+
+	std::atomic<uint32_t> producerActive;
+	std::atomic<int64_t> producerHeartbeat; // steady_clock ms
+
+	// Producer only signals the consumer while this is set
+	std::atomic<uint32_t> consumerWaiting;
+
+	// Not on windows. Bumped whenever the consumer creates the wake FIFO anew,
+	// so the producer knows to reopen it.
+	std::atomic<uint32_t> wakeFifoGeneration;
+
+	SharedMemoryPoseSlot poses[HOL::HandSide_MAX];
+
+	// Keep the indices on their own cache lines so the two sides don't fight over them
+	alignas(64) std::atomic<uint64_t> writeIndex;
+	alignas(64) std::atomic<uint64_t> readIndex;
+
+	// Records of [uint32_t length][packet], padded to 8 bytes.
+	alignas(64) char ring[SHARED_MEMORY_RING_SIZE];
+};
+
+// Memory-mapped alternative to the UDP transport for when app and driver are on the same
+// machine, which they always are. Poses go in a latest-value slot per hand so the consumer
+// never works through a backlog of old ones, everything else goes through a SPSC ring.
+class SharedMemoryTransport
+{
+public:
+	~SharedMemoryTransport();
+
+	// Name only needs to change for tests, so they don't stomp on a running driver
+	bool init(bool producer, const char* name = SHARED_MEMORY_DEFAULT_NAME);
+	void close();
+	bool isOpen();
+	bool isProducerConnected();
+
+	// Producer
+	void publishPose(const HOL::HandTransformPacket* packet);
+	bool send(const char* buffer, size_t size);
+	void heartbeat();
+
+	// Consumer. Wait also returns as soon as alsoWaitFor is signalled, so whatever else
+	// the consumer listens to doesn't have to sit out the timeout.
+	bool wait(int timeoutMS, WaitHandle alsoWaitFor = INVALID_WAIT_HANDLE);
+	void wake();
+	bool receivePose(HOL::HandSide side, HOL::HandTransformPacket* packetOut);
+	size_t receive(char* buffer, size_t maxLength);
+
+private:
+	bool hasPendingData();
+	void signal();
+	bool waitForSignal(int timeoutMS, WaitHandle alsoWaitFor);
+
+	SharedMemoryLayout* mShared = nullptr;
+	bool mProducer = false;
+	uint32_t mLastPoseSequence[HOL::HandSide_MAX] = {0, 0};
+
+#ifdef _WIN32
+	void* mMapping = nullptr;
+	void* mWakeEvent = nullptr;
+#else
+	// Futexes can't be waited on along with a socket, a FIFO can.
+	// The consumer creates it in init() and unlinks it again in close(). Both ends open it
+	// for reading and writing, the producer only once the consumer has created it.
+	bool createWakeFifo();
+
+	int mFd = -1;
+	int mWakeFifo = -1;
+	uint32_t mWakeFifoGeneration = 0;
+	std::string mWakeFifoPath;
+#endif
+};
+} // namespace HOL
@@ -1,4 +1,5 @@
 #include "transport.h"
+#include "src/util/trace.h"
 
 #include <iostream>
 
@@ -9,18 +10,38 @@ void Transport::init(int listenPort)
 	this->mTransport.init(listenPort);
 }
 
-void Transport::send(int port, char* buffer, size_t size)
+bool Transport::send(int port, char* buffer, size_t size)
 {
-	sockaddr_in addr = UdpTransport::getAddress(port);
-	this->mTransport.sendPacket(&addr, buffer, size);
+	HOL_TRACE_SCOPE("Transport::send");
+	auto it = this->mAddresses.find(port);
+	if (it == this->mAddresses.end())
+	{
+		it = this->mAddresses.emplace(port, UdpTransport::getAddress(port)).first;
+	}
+
+	return this->mTransport.sendPacket(&it->second, buffer, size) == size;
+}
+
+// Receives into the given RECEIVE_SLOT_SIZE slots, see UdpTransport::receivePackets().
+// If wait is false, only returns what is already queued.
+size_t Transport::receiveBatch(char** slots, size_t slotCount, size_t* lengthsOut, bool wait)
+{
+	return this->mTransport.receivePackets(slots, RECEIVE_SLOT_SIZE, slotCount, lengthsOut, wait);
+}
+
+// Makes a blocked receive return early with nothing
+void Transport::wake()
+{
+	this->mTransport.wake();
 }
 
-size_t Transport::receive()
+// Same as wake(), but for good. For shutting down receive threads.
+void Transport::cancel()
 {
-	return this->mTransport.receivePacket(this->mReceiveBuffer, 8192);
+	this->mTransport.cancel();
 }
 
-char* Transport::getReceiveBuffer()
+WaitHandle Transport::getReadHandle()
 {
-	return this->mReceiveBuffer;
+	return this->mTransport.getReadHandle();
 }
@@ -1,20 +1,29 @@
 #pragma once
 
 #include "udptransport.h"
+#include <unordered_map>
 
 namespace HOL
 {
+// Size of each receive slot, and how many of them we drain per call.
+static const int RECEIVE_SLOT_SIZE = 4096;
+static const int RECEIVE_BATCH_SIZE = UDP_MAX_BATCH_SIZE;
+
 class Transport
 {
 public:
 	void init(int listenPort);
-	void send(int port, char* buffer, size_t size);
-	size_t receive();
-	char* getReceiveBuffer();
+	bool send(int port, char* buffer, size_t size);
+	size_t receiveBatch(char** slots, size_t slotCount, size_t* lengthsOut, bool wait = true);
+	void wake();
+	void cancel();
+	WaitHandle getReadHandle();
 
 private:
 	UdpTransport mTransport;
-	char mReceiveBuffer[8192];
+
+	// Destination addresses by port, so we're not rebuilding them for every send
+	std::unordered_map<int, sockaddr_in> mAddresses;
 };
 
 } // namespace HOL
@@ -2,7 +2,13 @@
 
 #include "transportutil.h"
 #include <iostream>
+
+#ifdef _WIN32
 #include <winsock2.h>
+#else
+#include <cerrno>
+#include <cstring>
+#endif
 
 namespace HOL
 {
@@ -10,8 +16,12 @@ static bool WsaStartup = false;
 
 void printWSAError(const char* message)
 {
+#ifdef _WIN32
 	int error = WSAGetLastError();
 	std::cerr << message << ", WSA error code: " << error << std::endl;
+#else
+	std::cerr << message << ", error: " << std::strerror(errno) << std::endl;
+#endif
 }
 
 bool ensureWSAStartup()
@@ -26,12 +36,14 @@ bool initSocketWSA()
 		return true;
 	}
 
+#ifdef _WIN32
 	WSADATA wsaData;
 	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
 	{
 		printWSAError("WSAStartup failed");
 		return false;
 	}
+#endif
 
 	WsaStartup = true;
 
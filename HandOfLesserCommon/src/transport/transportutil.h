@@ -3,6 +3,15 @@
 namespace HOL
 {
 
+// Something a receive can sleep on. An event on windows, a file descriptor everywhere else.
+#ifdef _WIN32
+typedef void* WaitHandle;
+static void* const INVALID_WAIT_HANDLE = nullptr;
+#else
+typedef int WaitHandle;
+static const int INVALID_WAIT_HANDLE = -1;
+#endif
+
 bool ensureWSAStartup();
 void printWSAError(const char* message);
 bool initSocketWSA();
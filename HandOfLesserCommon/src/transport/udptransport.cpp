@@ -1,11 +1,51 @@
 //============ Copyright (c) Valve Corporation, All rights reserved. ============
 #include "udptransport.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <iostream>
 #include "transportutil.h"
 
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
 using namespace HOL;
 
+UdpTransport::~UdpTransport()
+{
+#ifdef _WIN32
+	if (this->mSocket != INVALID_SOCKET)
+	{
+		closesocket(this->mSocket);
+	}
+	if (this->mReadEvent != WSA_INVALID_EVENT)
+	{
+		WSACloseEvent(this->mReadEvent);
+	}
+	if (this->mWakeEvent != WSA_INVALID_EVENT)
+	{
+		WSACloseEvent(this->mWakeEvent);
+	}
+#else
+	if (this->mSocket != INVALID_SOCKET)
+	{
+		close(this->mSocket);
+	}
+	if (this->mEpoll >= 0)
+	{
+		close(this->mEpoll);
+	}
+	if (this->mWakeFd >= 0)
+	{
+		close(this->mWakeFd);
+	}
+#endif
+}
+
 bool UdpTransport::init(int port)
 {
 	if (!HOL::ensureWSAStartup())
@@ -28,21 +68,61 @@ bool UdpTransport::init(int port)
 		return false;
 	}
 
-	// Stuff so we can use select() with a timeout
-	this->mTimeout.tv_sec = 1;	 // Timeout in seconds
-	this->mTimeout.tv_usec = 0; // Microseconds
+	// Receive thread sleeps until there's either data on the socket or someone calls wake().
+	// Set up once here instead of rebuilding an fd_set for every select() call.
+#ifdef _WIN32
+	this->mReadEvent = WSACreateEvent();
+	this->mWakeEvent = WSACreateEvent();
+	if (this->mReadEvent == WSA_INVALID_EVENT || this->mWakeEvent == WSA_INVALID_EVENT)
+	{
+		printWSAError("WSACreateEvent failed");
+		return false;
+	}
+
+	// Also makes the socket non-blocking
+	if (WSAEventSelect(this->mSocket, this->mReadEvent, FD_READ) != 0)
+	{
+		printWSAError("WSAEventSelect failed");
+		return false;
+	}
+#else
+	this->mEpoll = epoll_create1(EPOLL_CLOEXEC);
+	this->mWakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (this->mEpoll < 0 || this->mWakeFd < 0)
+	{
+		printWSAError("epoll/eventfd creation failed");
+		return false;
+	}
+
+	epoll_event socketEvent = {};
+	socketEvent.events = EPOLLIN;
+	socketEvent.data.fd = this->mSocket;
+
+	epoll_event wakeEvent = {};
+	wakeEvent.events = EPOLLIN;
+	wakeEvent.data.fd = this->mWakeFd;
+
+	if (epoll_ctl(this->mEpoll, EPOLL_CTL_ADD, this->mSocket, &socketEvent) != 0
+		|| epoll_ctl(this->mEpoll, EPOLL_CTL_ADD, this->mWakeFd, &wakeEvent) != 0)
+	{
+		printWSAError("epoll_ctl failed");
+		return false;
+	}
+#endif
 
 	return true;
 }
 
 size_t UdpTransport::sendPacket(sockaddr_in* to, char* buffer, size_t length)
 {
-	size_t sent = sendto(this->mSocket, buffer, length, 0, (sockaddr*)to, sizeof(sockaddr_in));
+	int sent = sendto(this->mSocket, buffer, length, 0, (sockaddr*)to, sizeof(sockaddr_in));
 	if (sent == SOCKET_ERROR)
 	{
 		printWSAError("Socket send failed");
 		return 0;
 	}
+
+	return sent;
 }
 
 sockaddr_in UdpTransport::getAddress(int port)
@@ -55,27 +135,208 @@ sockaddr_in UdpTransport::getAddress(int port)
 	return addr;
 }
 
+void UdpTransport::wake()
+{
+#ifdef _WIN32
+	WSASetEvent(this->mWakeEvent);
+#else
+	uint64_t one = 1;
+	if (write(this->mWakeFd, &one, sizeof(one)) < 0)
+	{
+		printWSAError("Wake failed");
+	}
+#endif
+}
+
+void UdpTransport::cancel()
+{
+	this->mCancelled = true;
+	wake();
+}
+
+WaitHandle UdpTransport::getReadHandle()
+{
+#ifdef _WIN32
+	// Manual reset, stays signalled until waitForData() resets it before reading
+	return this->mReadEvent;
+#else
+	return this->mSocket;
+#endif
+}
+
+// Returns true if the socket has data. False if woken up, cancelled,
+// or if there's nothing there and we were told not to wait.
+bool UdpTransport::waitForData(bool wait)
+{
+	if (this->mCancelled)
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	WSAEVENT events[2] = {this->mReadEvent, this->mWakeEvent};
+	DWORD res = WSAWaitForMultipleEvents(2, events, FALSE, wait ? WSA_INFINITE : 0, FALSE);
+
+	if (res == WSA_WAIT_EVENT_0)
+	{
+		// recv() re-signals it if there's anything left once we're done
+		WSAResetEvent(this->mReadEvent);
+		return true;
+	}
+
+	if (res == WSA_WAIT_EVENT_0 + 1)
+	{
+		WSAResetEvent(this->mWakeEvent);
+		return false;
+	}
+
+	if (res == WSA_WAIT_FAILED)
+	{
+		printWSAError("Socket wait failed");
+	}
+
+	return false;
+#else
+	epoll_event events[2];
+	int count = epoll_wait(this->mEpoll, events, 2, wait ? -1 : 0);
+
+	if (count < 0)
+	{
+		// Interrupted by a signal, just let the caller loop around
+		if (errno != EINTR)
+		{
+			printWSAError("Socket wait failed");
+		}
+		return false;
+	}
+
+	bool readable = false;
+	for (int i = 0; i < count; i++)
+	{
+		if (events[i].data.fd == this->mWakeFd)
+		{
+			// Reset the counter so the next wait blocks again
+			uint64_t value;
+			if (read(this->mWakeFd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+			{
+				printWSAError("Wake reset failed");
+			}
+		}
+		else
+		{
+			readable = true;
+		}
+	}
+
+	// Wakeups win so shutdown isn't held up by a busy socket
+	return readable && !this->mCancelled;
+#endif
+}
+
 size_t UdpTransport::receivePacket(char* buffer, size_t maxlength)
 {
-	// Must be done before every call to select()
-	// If you only do this once, you'll observe a network-wide lag spike
-	// every 5 seconds or so, with a timeout of 1s. Increasing it reduces the symptoms.
-	FD_ZERO(&this->mFdSet);
-	FD_SET(this->mSocket, &mFdSet);
+	if (!waitForData())
+	{
+		return 0;
+	}
 
-	size_t res = select(0, &this->mFdSet, nullptr, nullptr, &this->mTimeout);
+	// Non-blocking on windows, but we only get here when there's something to read
+	int received = recv(this->mSocket, buffer, maxlength, 0);
+	return received == SOCKET_ERROR ? 0 : received;
+}
+
+// Waits for data the same way receivePacket() does, then drains every datagram that is
+// already queued into the given slots of slotSize bytes, in the order they arrived.
+// Returns the number of slots filled, with the length of each written to lengthsOut.
+// Slots that got filled are always moved to the front of the array.
+size_t UdpTransport::receivePackets(char** slots,
+									size_t slotSize,
+									size_t slotCount,
+									size_t* lengthsOut,
+									bool wait)
+{
+	slotCount = std::min(slotCount, (size_t)UDP_MAX_BATCH_SIZE);
 
-	if (res == SOCKET_ERROR)
+	if (slotCount == 0 || !waitForData(wait))
 	{
-		printWSAError("Socket read failed");
 		return 0;
 	}
-	else if (res == 0)
+
+#ifdef _WIN32
+	// No recvmmsg on windows, but we can still avoid a select() per packet by
+	// asking how much is left in the queue after each recv.
+	size_t count = 0;
+	while (count < slotCount)
+	{
+		int received = recv(this->mSocket, slots[count], slotSize, 0);
+		if (received == SOCKET_ERROR)
+		{
+			// WSAEMSGSIZE means the datagram was truncated, just drop it.
+			int error = WSAGetLastError();
+			if (error == WSAEWOULDBLOCK)
+			{
+				break;
+			}
+			else if (error != WSAEMSGSIZE)
+			{
+				printWSAError("Socket read failed");
+				break;
+			}
+		}
+		else
+		{
+			lengthsOut[count] = received;
+			count++;
+		}
+
+		u_long pending = 0;
+		if (ioctlsocket(this->mSocket, FIONREAD, &pending) != 0 || pending == 0)
+		{
+			break;
+		}
+	}
+
+	return count;
+#else
+	for (size_t i = 0; i < slotCount; i++)
+	{
+		this->mIovecs[i].iov_base = slots[i];
+		this->mIovecs[i].iov_len = slotSize;
+		this->mMessages[i] = {};
+		this->mMessages[i].msg_hdr.msg_iov = &this->mIovecs[i];
+		this->mMessages[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	// Everything select() told us about is already queued, so never block here.
+	int received = recvmmsg(this->mSocket, this->mMessages, slotCount, MSG_DONTWAIT, nullptr);
+	if (received == SOCKET_ERROR && errno == EAGAIN)
 	{
 		return 0;
 	}
-	else
+	else if (received == SOCKET_ERROR)
 	{
-		return recv(this->mSocket, buffer, maxlength, 0);
+		printWSAError("Socket read failed");
+		return 0;
 	}
+
+	size_t count = 0;
+	for (int i = 0; i < received; i++)
+	{
+		// Truncated datagrams are useless to us, compact the rest.
+		if (this->mMessages[i].msg_hdr.msg_flags & MSG_TRUNC)
+		{
+			continue;
+		}
+
+		if (count != (size_t)i)
+		{
+			std::swap(slots[count], slots[i]);
+		}
+
+		lengthsOut[count] = this->mMessages[i].msg_len;
+		count++;
+	}
+
+	return count;
+#endif
 }
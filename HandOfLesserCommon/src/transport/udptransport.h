@@ -1,20 +1,64 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include "transportutil.h"
+
+#ifdef _WIN32
 #include <winsock2.h>
+#else
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+// Keep the winsock names so the rest of the transport code doesn't care
+typedef int SOCKET;
+#define INVALID_SOCKET (-1)
+#define SOCKET_ERROR (-1)
+#endif
 
 namespace HOL
 {
+// Upper bound on how many datagrams a single receivePackets() call will drain.
+static const int UDP_MAX_BATCH_SIZE = 32;
+
 class UdpTransport
 {
 public:
+	~UdpTransport();
 	bool init(int port);
 	size_t receivePacket(char* buffer, size_t maxlength);
+	size_t receivePackets(
+		char** slots, size_t slotSize, size_t slotCount, size_t* lengthsOut, bool wait = true);
 	size_t sendPacket(sockaddr_in* to, char* buffer, size_t length);
 	static sockaddr_in getAddress(int port);
 
+	// Signalled while there's something to receive. Only for waiting on alongside
+	// something else, receiving is what resets it.
+	WaitHandle getReadHandle();
+
+	// Wakes up a blocked receive, which then returns nothing.
+	// Cancel does the same, but every receive after it also returns immediately.
+	void wake();
+	void cancel();
+
 private:
-	SOCKET mSocket;
-	fd_set mFdSet;
-	timeval mTimeout;
+	bool waitForData(bool wait = true);
+
+	SOCKET mSocket = INVALID_SOCKET;
+	std::atomic<bool> mCancelled = false;
+
+#ifdef _WIN32
+	WSAEVENT mReadEvent = WSA_INVALID_EVENT;
+	WSAEVENT mWakeEvent = WSA_INVALID_EVENT;
+#else
+	int mEpoll = -1;
+	int mWakeFd = -1;
+#endif
+
+#ifndef _WIN32
+	// Message headers for recvmmsg(), only the buffers change between calls
+	mmsghdr mMessages[UDP_MAX_BATCH_SIZE];
+	iovec mIovecs[UDP_MAX_BATCH_SIZE];
+#endif
 };
 } // namespace HOL
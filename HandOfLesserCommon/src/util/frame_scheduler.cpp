@@ -0,0 +1,204 @@
+#include "frame_scheduler.h"
+#include "time_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX // std::max
+#endif
+#include <windows.h>
+// Windows 10 1803 and up, older SDKs don't know about it
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <time.h>
+#endif
+
+namespace HOL
+{
+	FrameScheduler::FrameScheduler()
+	{
+#ifdef _WIN32
+		// Regular sleeps are at the mercy of the system timer resolution, up to 15.6ms.
+		// Falls back to those if this isn't supported, with a much longer spin.
+		this->mTimer = CreateWaitableTimerExW(
+			nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+	}
+
+	FrameScheduler::~FrameScheduler()
+	{
+#ifdef _WIN32
+		if (this->mTimer != nullptr)
+		{
+			CloseHandle(this->mTimer);
+		}
+#endif
+	}
+
+	void FrameScheduler::setPeriod(int64_t periodNs)
+	{
+		this->mPeriod = std::max<int64_t>(periodNs, 1);
+	}
+
+	void FrameScheduler::setSpinMargin(int64_t marginNs)
+	{
+		this->mSpinMargin = std::max<int64_t>(marginNs, 0);
+	}
+
+	void FrameScheduler::setPhase(int64_t referenceNs, int64_t phaseNs)
+	{
+		this->mReference = referenceNs;
+		this->mPhase = phaseNs;
+	}
+
+	int64_t FrameScheduler::gridPointAfter(int64_t time)
+	{
+		return nextTimeOnGrid(this->mReference + this->mPhase, this->mPeriod, time);
+	}
+
+	int64_t FrameScheduler::scheduleNext(int64_t now)
+	{
+		if (this->mLastDeadline == 0)
+		{
+			this->mLastDeadline = this->gridPointAfter(now);
+			this->mSkipped = true;
+			return this->mLastDeadline;
+		}
+
+		// On the grid even if the period or phase changed since the last deadline
+		int64_t next = this->gridPointAfter(this->mLastDeadline);
+
+		if (now >= next)
+		{
+			this->mOverruns++;
+
+			// Less than a period late, do it now and we're back on track next frame.
+			// Any further and there's no point, skip to the next one that's still ahead.
+			if (now - next >= this->mPeriod)
+			{
+				int64_t resume = this->gridPointAfter(now);
+				this->mMissedDeadlines += (resume - next) / this->mPeriod;
+				this->mSkipped = true;
+				next = resume;
+			}
+		}
+
+		this->mLastDeadline = next;
+		return next;
+	}
+
+	void FrameScheduler::sleepUntil(int64_t deadline)
+	{
+		int64_t sleepTarget = deadline - this->mSpinMargin;
+		int64_t now = steadyNanoseconds();
+
+		if (sleepTarget > now)
+		{
+#ifdef _WIN32
+			if (this->mTimer != nullptr)
+			{
+				// Negative is relative, in 100ns units
+				LARGE_INTEGER dueTime;
+				dueTime.QuadPart = -(sleepTarget - now) / 100;
+				SetWaitableTimer(this->mTimer, &dueTime, 0, nullptr, nullptr, FALSE);
+				WaitForSingleObject(this->mTimer, INFINITE);
+			}
+			else
+			{
+				std::this_thread::sleep_for(std::chrono::nanoseconds(sleepTarget - now));
+			}
+#else
+			// steady_clock is CLOCK_MONOTONIC
+			timespec target;
+			target.tv_sec = sleepTarget / 1000000000;
+			target.tv_nsec = sleepTarget % 1000000000;
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr);
+#endif
+		}
+
+		// Whatever the sleep left over
+		while (steadyNanoseconds() < deadline)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	int64_t FrameScheduler::waitForNextFrame()
+	{
+		int64_t deadline = this->scheduleNext(steadyNanoseconds());
+		this->sleepUntil(deadline);
+		this->record(deadline, steadyNanoseconds());
+		return deadline;
+	}
+
+	void FrameScheduler::record(int64_t deadline, int64_t woke)
+	{
+		this->mFrames++;
+
+		int64_t lateness = std::max<int64_t>(woke - deadline, 0);
+		this->mLatenessSum += (double)lateness;
+		this->mLatenessMax = std::max(this->mLatenessMax, lateness);
+
+		if (!this->mSkipped && this->mLastWake != 0)
+		{
+			// Error from the target rather than the raw period, keeps the squares small
+			int64_t error = (woke - this->mLastWake) - this->mPeriod;
+			this->mPeriodCount++;
+			this->mPeriodErrorSum += (double)error;
+			this->mPeriodErrorSumSquared += (double)error * (double)error;
+			this->mPeriodMaxError = std::max(this->mPeriodMaxError, std::abs(error));
+		}
+
+		this->mLastWake = woke;
+		this->mSkipped = false;
+	}
+
+	FrameSchedulerStatistics FrameScheduler::getStatistics()
+	{
+		FrameSchedulerStatistics statistics;
+		statistics.frames = this->mFrames;
+		statistics.overruns = this->mOverruns;
+		statistics.missedDeadlines = this->mMissedDeadlines;
+		statistics.periodMaxErrorUS = this->mPeriodMaxError / 1000.f;
+		statistics.latenessMaxUS = this->mLatenessMax / 1000.f;
+
+		if (this->mFrames > 0)
+		{
+			statistics.latenessMeanUS = (float)(this->mLatenessSum / this->mFrames / 1000.0);
+		}
+
+		if (this->mPeriodCount > 0)
+		{
+			double meanError = this->mPeriodErrorSum / this->mPeriodCount;
+			double variance
+				= this->mPeriodErrorSumSquared / this->mPeriodCount - meanError * meanError;
+
+			statistics.periodMeanUS = (float)((this->mPeriod + meanError) / 1000.0);
+			statistics.periodJitterUS = (float)(std::sqrt(std::max(variance, 0.0)) / 1000.0);
+		}
+
+		return statistics;
+	}
+
+	void FrameScheduler::resetStatistics()
+	{
+		this->mFrames = 0;
+		this->mOverruns = 0;
+		this->mMissedDeadlines = 0;
+		this->mPeriodCount = 0;
+		this->mPeriodErrorSum = 0;
+		this->mPeriodErrorSumSquared = 0;
+		this->mPeriodMaxError = 0;
+		this->mLatenessSum = 0;
+		this->mLatenessMax = 0;
+
+		// The gap since the last frame shouldn't count either
+		this->mSkipped = true;
+	}
+
+} // namespace HOL
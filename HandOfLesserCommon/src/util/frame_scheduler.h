@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+namespace HOL
+{
+	struct FrameSchedulerStatistics
+	{
+		uint64_t frames = 0;
+		uint64_t overruns = 0;		  // Frame started late because the last one ran long
+		uint64_t missedDeadlines = 0; // Frames skipped entirely, we don't try to catch up
+		float periodMeanUS = 0;
+		float periodJitterUS = 0;	// Standard deviation of the period
+		float periodMaxErrorUS = 0; // Furthest a single period was from the target
+		float latenessMeanUS = 0;	// How long after the deadline we actually got going
+		float latenessMaxUS = 0;
+	};
+
+	// Runs a loop on absolute deadlines instead of sleeping for an interval after the work,
+	// so the period doesn't stretch by however long the work took or the OS overslept.
+	// Sleeps until shortly before the deadline and spins the rest of the way.
+	class FrameScheduler
+	{
+	public:
+		FrameScheduler();
+		~FrameScheduler();
+
+		void setPeriod(int64_t periodNs);
+		void setSpinMargin(int64_t marginNs);
+
+		// Deadlines land on reference + phase + n * period, so the loop can be lined up with
+		// something else that runs at the same rate, like the display. Reference is in
+		// steadyNanoseconds(), phase is usually negative to run ahead of it.
+		void setPhase(int64_t referenceNs, int64_t phaseNs);
+
+		// Sleeps until the next deadline and returns it
+		int64_t waitForNextFrame();
+
+		// Picks the deadline after the last one, given the current time.
+		// Doesn't sleep or record anything, waitForNextFrame() does that.
+		int64_t scheduleNext(int64_t now);
+
+		FrameSchedulerStatistics getStatistics();
+		void resetStatistics();
+
+	private:
+		int64_t gridPointAfter(int64_t time);
+		void sleepUntil(int64_t deadline);
+		void record(int64_t deadline, int64_t woke);
+
+		int64_t mPeriod = 1000000;
+		int64_t mSpinMargin = 200000;
+		int64_t mReference = 0;
+		int64_t mPhase = 0;
+
+		int64_t mLastDeadline = 0;
+		int64_t mLastWake = 0;
+		bool mSkipped = false; // Don't count the gap after a skip as a period
+
+		uint64_t mFrames = 0;
+		uint64_t mOverruns = 0;
+		uint64_t mMissedDeadlines = 0;
+		uint64_t mPeriodCount = 0;
+		double mPeriodErrorSum = 0;
+		double mPeriodErrorSumSquared = 0;
+		int64_t mPeriodMaxError = 0;
+		double mLatenessSum = 0;
+		int64_t mLatenessMax = 0;
+
+#ifdef _WIN32
+		void* mTimer = nullptr;
+#endif
+	};
+} // namespace HOL
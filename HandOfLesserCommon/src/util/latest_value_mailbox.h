@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace HOL
+{
+	// Single producer, single consumer, latest value wins. Publishing never blocks or fails,
+	// anything the consumer didn't get to in time is simply overwritten.
+	//
+	// Sequence-numbered double buffer: the writer alternates between two slots and publishes
+	// the sequence of the one it just finished. The reader copies the published slot and
+	// then checks the writer hasn't started reusing it in the meantime, retrying if it has.
+	//
+	// T should be plain data, the same kind of thing we'd memcpy onto the wire.
+	template <typename T> class LatestValueMailbox
+	{
+	public:
+		void publish(const T& value)
+		{
+			uint64_t sequence = this->mPublished.load(std::memory_order_relaxed) + 1;
+
+			this->mWriting.store(sequence, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			this->mSlots[sequence & 1] = value;
+
+			this->mPublished.store(sequence, std::memory_order_release);
+		}
+
+		// Returns true and copies the value if something was published since the last call.
+		bool consume(T& out)
+		{
+			// Writer only holds a slot for one copy, so this can't spin for long
+			while (true)
+			{
+				uint64_t sequence = this->mPublished.load(std::memory_order_acquire);
+				if (sequence == this->mLastConsumed)
+				{
+					return false;
+				}
+
+				out = this->mSlots[sequence & 1];
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				// Slot is only rewritten by sequence + 2
+				if (this->mWriting.load(std::memory_order_relaxed) < sequence + 2)
+				{
+					this->mDropped += sequence - this->mLastConsumed - 1;
+					this->mLastConsumed = sequence;
+					return true;
+				}
+			}
+		}
+
+		// Values that were overwritten before the consumer saw them. Consumer thread only.
+		uint64_t droppedCount()
+		{
+			return this->mDropped;
+		}
+
+	private:
+		alignas(64) std::atomic<uint64_t> mPublished = 0;
+		std::atomic<uint64_t> mWriting = 0;
+		T mSlots[2] = {};
+
+		// Consumer side only
+		alignas(64) uint64_t mLastConsumed = 0;
+		uint64_t mDropped = 0;
+	};
+
+} // namespace HOL
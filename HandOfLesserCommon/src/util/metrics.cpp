@@ -0,0 +1,288 @@
+#include "metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace HOL
+{
+	// 5 significant bits, shifted at most 58 places to reach the top of an int64
+	static_assert(LATENCY_HISTOGRAM_BUCKETS == (58 + 2) * LATENCY_HISTOGRAM_SUB_BUCKETS,
+				  "Buckets must cover every positive int64");
+
+	int LatencyHistogram::getBucket(int64_t nanoseconds)
+	{
+		if (nanoseconds < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS)
+		{
+			return (int)std::max<int64_t>(nanoseconds, 0);
+		}
+
+		// Top 5 bits pick the bucket, the first of them is always set
+		int shift = std::bit_width((uint64_t)nanoseconds) - 5;
+		int sub = (int)(nanoseconds >> shift) - LATENCY_HISTOGRAM_SUB_BUCKETS;
+		return (shift + 1) * LATENCY_HISTOGRAM_SUB_BUCKETS + sub;
+	}
+
+	int64_t LatencyHistogram::getBucketUpperBound(int bucket)
+	{
+		if (bucket < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS)
+		{
+			return bucket;
+		}
+
+		int shift = bucket / LATENCY_HISTOGRAM_SUB_BUCKETS - 1;
+		uint64_t sub = bucket % LATENCY_HISTOGRAM_SUB_BUCKETS + LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+		// Last bucket wraps around to UINT64_MAX, which is fine once clamped
+		uint64_t upper = ((sub + 1) << shift) - 1;
+		return (int64_t)std::min<uint64_t>(upper, INT64_MAX);
+	}
+
+	void LatencyHistogram::record(int64_t nanoseconds)
+	{
+		nanoseconds = std::max<int64_t>(nanoseconds, 0);
+
+		this->mBuckets[getBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+		this->mCount.fetch_add(1, std::memory_order_relaxed);
+		this->mSum.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+		int64_t max = this->mMax.load(std::memory_order_relaxed);
+		while (nanoseconds > max
+			   && !this->mMax.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void LatencyHistogram::reset()
+	{
+		for (auto& bucket : this->mBuckets)
+		{
+			bucket.store(0, std::memory_order_relaxed);
+		}
+
+		this->mCount.store(0, std::memory_order_relaxed);
+		this->mSum.store(0, std::memory_order_relaxed);
+		this->mMax.store(0, std::memory_order_relaxed);
+	}
+
+	uint64_t LatencyHistogram::getCount()
+	{
+		return this->mCount.load(std::memory_order_relaxed);
+	}
+
+	int64_t LatencyHistogram::getPercentile(double percentile)
+	{
+		// Sum the buckets instead of trusting mCount, a record() might be halfway through
+		uint64_t total = 0;
+		for (auto& bucket : this->mBuckets)
+		{
+			total += bucket.load(std::memory_order_relaxed);
+		}
+
+		if (total == 0)
+		{
+			return 0;
+		}
+
+		uint64_t target = (uint64_t)std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * total);
+		target = std::max<uint64_t>(target, 1);
+
+		uint64_t seen = 0;
+		for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++)
+		{
+			seen += this->mBuckets[i].load(std::memory_order_relaxed);
+			if (seen >= target)
+			{
+				// Nothing was actually any slower than the max
+				return std::min(getBucketUpperBound(i), this->mMax.load(std::memory_order_relaxed));
+			}
+		}
+
+		return this->mMax.load(std::memory_order_relaxed);
+	}
+
+	LatencySummary LatencyHistogram::summarize()
+	{
+		LatencySummary summary;
+		summary.count = this->getCount();
+		if (summary.count == 0)
+		{
+			return summary;
+		}
+
+		summary.meanUS = (float)(this->mSum.load(std::memory_order_relaxed) / 1000.0 / summary.count);
+		summary.p50US = this->getPercentile(50) / 1000.f;
+		summary.p90US = this->getPercentile(90) / 1000.f;
+		summary.p99US = this->getPercentile(99) / 1000.f;
+		summary.p999US = this->getPercentile(99.9) / 1000.f;
+		summary.maxUS = this->mMax.load(std::memory_order_relaxed) / 1000.f;
+		return summary;
+	}
+
+	int MetricsRegistry::findOrAdd(char (*names)[METRICS_NAME_LENGTH],
+								   std::atomic<int>& count,
+								   int max,
+								   const char* name)
+	{
+		std::lock_guard<std::mutex> lock(this->mMutex);
+
+		int current = count.load(std::memory_order_relaxed);
+		for (int i = 0; i < current; i++)
+		{
+			if (strncmp(names[i], name, METRICS_NAME_LENGTH - 1) == 0)
+			{
+				return i;
+			}
+		}
+
+		if (current >= max)
+		{
+			std::cerr << "Out of room for metric " << name << ", it won't be shown" << std::endl;
+			return -1;
+		}
+
+		// Name first, snapshots only look at what the count says is there
+		snprintf(names[current], METRICS_NAME_LENGTH, "%s", name);
+		count.store(current + 1, std::memory_order_release);
+		return current;
+	}
+
+	LatencyHistogram* MetricsRegistry::getHistogram(const char* name)
+	{
+		int index = this->findOrAdd(
+			this->mHistogramNames, this->mHistogramCount, METRICS_MAX_HISTOGRAMS, name);
+		return index < 0 ? &this->mSpareHistogram : &this->mHistograms[index];
+	}
+
+	MetricCounter* MetricsRegistry::getCounter(const char* name)
+	{
+		int index
+			= this->findOrAdd(this->mCounterNames, this->mCounterCount, METRICS_MAX_COUNTERS, name);
+		return index < 0 ? &this->mSpareCounter : &this->mCounters[index];
+	}
+
+	MetricGauge* MetricsRegistry::getGauge(const char* name)
+	{
+		int index
+			= this->findOrAdd(this->mGaugeNames, this->mGaugeCount, METRICS_MAX_GAUGES, name);
+		return index < 0 ? &this->mSpareGauge : &this->mGauges[index];
+	}
+
+	void MetricsRegistry::snapshot(MetricsSnapshot& snapshot)
+	{
+		snapshot.histogramCount = this->mHistogramCount.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < snapshot.histogramCount; i++)
+		{
+			memcpy(snapshot.histograms[i].name, this->mHistogramNames[i], METRICS_NAME_LENGTH);
+			snapshot.histograms[i].summary = this->mHistograms[i].summarize();
+		}
+
+		snapshot.counterCount = this->mCounterCount.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < snapshot.counterCount; i++)
+		{
+			memcpy(snapshot.counters[i].name, this->mCounterNames[i], METRICS_NAME_LENGTH);
+			snapshot.counters[i].value = (int64_t)this->mCounters[i].get();
+		}
+
+		snapshot.gaugeCount = this->mGaugeCount.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < snapshot.gaugeCount; i++)
+		{
+			memcpy(snapshot.gauges[i].name, this->mGaugeNames[i], METRICS_NAME_LENGTH);
+			snapshot.gauges[i].value = this->mGauges[i].get();
+		}
+	}
+
+	void MetricsRegistry::reset()
+	{
+		int histograms = this->mHistogramCount.load(std::memory_order_acquire);
+		for (int i = 0; i < histograms; i++)
+		{
+			this->mHistograms[i].reset();
+		}
+
+		int counters = this->mCounterCount.load(std::memory_order_acquire);
+		for (int i = 0; i < counters; i++)
+		{
+			this->mCounters[i].reset();
+		}
+	}
+
+	MetricsRegistry& getMetrics()
+	{
+		static MetricsRegistry registry;
+		return registry;
+	}
+
+	void formatMetrics(const char* process, const MetricsSnapshot& snapshot, std::string& text)
+	{
+		char line[256];
+
+		snprintf(line, sizeof(line), "# %s\n", process);
+		text += line;
+
+		for (uint32_t i = 0; i < snapshot.histogramCount && i < METRICS_MAX_HISTOGRAMS; i++)
+		{
+			const MetricsHistogramSnapshot& histogram = snapshot.histograms[i];
+			const LatencySummary& summary = histogram.summary;
+
+			snprintf(line,
+					 sizeof(line),
+					 "histogram %.*s count=%llu mean_us=%.2f p50_us=%.2f p90_us=%.2f p99_us=%.2f "
+					 "p999_us=%.2f max_us=%.2f\n",
+					 METRICS_NAME_LENGTH,
+					 histogram.name,
+					 (unsigned long long)summary.count,
+					 summary.meanUS,
+					 summary.p50US,
+					 summary.p90US,
+					 summary.p99US,
+					 summary.p999US,
+					 summary.maxUS);
+			text += line;
+		}
+
+		for (uint32_t i = 0; i < snapshot.counterCount && i < METRICS_MAX_COUNTERS; i++)
+		{
+			snprintf(line,
+					 sizeof(line),
+					 "counter %.*s %lld\n",
+					 METRICS_NAME_LENGTH,
+					 snapshot.counters[i].name,
+					 (long long)snapshot.counters[i].value);
+			text += line;
+		}
+
+		for (uint32_t i = 0; i < snapshot.gaugeCount && i < METRICS_MAX_GAUGES; i++)
+		{
+			snprintf(line,
+					 sizeof(line),
+					 "gauge %.*s %lld\n",
+					 METRICS_NAME_LENGTH,
+					 snapshot.gauges[i].name,
+					 (long long)snapshot.gauges[i].value);
+			text += line;
+		}
+	}
+
+	bool writeMetrics(const std::string& path, const std::string& text)
+	{
+		FILE* file = fopen(path.c_str(), "wb");
+		if (file == nullptr)
+		{
+			std::cerr << "Failed to open " << path << " for writing" << std::endl;
+			return false;
+		}
+
+		bool good = fwrite(text.data(), 1, text.size(), file) == text.size();
+		if (fclose(file) != 0 || !good)
+		{
+			std::cerr << "Failed to write " << path << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+} // namespace HOL
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace HOL
+{
+	static const int METRICS_NAME_LENGTH = 32;
+	static const int METRICS_MAX_HISTOGRAMS = 16;
+	static const int METRICS_MAX_COUNTERS = 24;
+	static const int METRICS_MAX_GAUGES = 16;
+
+	// Exact below 32ns, then 16 buckets per power of two, so anything a histogram reports is
+	// within about 6% of the real value. Covers every positive int64 in under 8KB.
+	static const int LATENCY_HISTOGRAM_SUB_BUCKETS = 16;
+	static const int LATENCY_HISTOGRAM_BUCKETS = 960;
+
+	struct LatencySummary
+	{
+		uint64_t count = 0;
+		float meanUS = 0;
+		float p50US = 0;
+		float p90US = 0;
+		float p99US = 0;
+		float p999US = 0;
+		float maxUS = 0; // Exact, not bucketed
+	};
+
+	// Nanosecond latencies, HDR histogram style. Recording is a couple of relaxed atomics,
+	// so any number of threads can record while another one reads.
+	class LatencyHistogram
+	{
+	public:
+		void record(int64_t nanoseconds);
+		void reset();
+
+		uint64_t getCount();
+
+		// Upper end of the bucket the percentile lands in, 0 if nothing was recorded
+		int64_t getPercentile(double percentile);
+		LatencySummary summarize();
+
+		static int getBucket(int64_t nanoseconds);
+		static int64_t getBucketUpperBound(int bucket);
+
+	private:
+		std::atomic<uint64_t> mBuckets[LATENCY_HISTOGRAM_BUCKETS] = {};
+		std::atomic<uint64_t> mCount = 0;
+		std::atomic<int64_t> mSum = 0;
+		std::atomic<int64_t> mMax = 0;
+	};
+
+	class MetricCounter
+	{
+	public:
+		void add(uint64_t amount = 1)
+		{
+			this->mValue.fetch_add(amount, std::memory_order_relaxed);
+		}
+
+		uint64_t get()
+		{
+			return this->mValue.load(std::memory_order_relaxed);
+		}
+
+		void reset()
+		{
+			this->mValue.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<uint64_t> mValue = 0;
+	};
+
+	// Last value set, for things like queue depths
+	class MetricGauge
+	{
+	public:
+		void set(int64_t value)
+		{
+			this->mValue.store(value, std::memory_order_relaxed);
+		}
+
+		int64_t get()
+		{
+			return this->mValue.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<int64_t> mValue = 0;
+	};
+
+	// Plain copy of a whole registry, small enough to go out as a single packet
+	struct MetricsHistogramSnapshot
+	{
+		char name[METRICS_NAME_LENGTH] = {};
+		LatencySummary summary;
+	};
+
+	struct MetricsValueSnapshot
+	{
+		char name[METRICS_NAME_LENGTH] = {};
+		int64_t value = 0;
+	};
+
+	struct MetricsSnapshot
+	{
+		uint32_t histogramCount = 0;
+		uint32_t counterCount = 0;
+		uint32_t gaugeCount = 0;
+		uint32_t padding = 0;
+		MetricsHistogramSnapshot histograms[METRICS_MAX_HISTOGRAMS];
+		MetricsValueSnapshot counters[METRICS_MAX_COUNTERS];
+		MetricsValueSnapshot gauges[METRICS_MAX_GAUGES];
+	};
+
+	// Fixed set of named metrics. Look one up once, keep the pointer, and updating it never
+	// locks or allocates. Asking for a name that is already there returns the same metric.
+	// Once full, everything else shares a spare that never shows up in snapshots.
+	class MetricsRegistry
+	{
+	public:
+		LatencyHistogram* getHistogram(const char* name);
+		MetricCounter* getCounter(const char* name);
+		MetricGauge* getGauge(const char* name);
+
+		void snapshot(MetricsSnapshot& snapshot);
+
+		// Histograms and counters, gauges are set fresh anyway
+		void reset();
+
+	private:
+		int findOrAdd(char (*names)[METRICS_NAME_LENGTH],
+					  std::atomic<int>& count,
+					  int max,
+					  const char* name);
+
+		std::mutex mMutex; // Only for adding metrics
+
+		char mHistogramNames[METRICS_MAX_HISTOGRAMS][METRICS_NAME_LENGTH] = {};
+		LatencyHistogram mHistograms[METRICS_MAX_HISTOGRAMS];
+		std::atomic<int> mHistogramCount = 0;
+
+		char mCounterNames[METRICS_MAX_COUNTERS][METRICS_NAME_LENGTH] = {};
+		MetricCounter mCounters[METRICS_MAX_COUNTERS];
+		std::atomic<int> mCounterCount = 0;
+
+		char mGaugeNames[METRICS_MAX_GAUGES][METRICS_NAME_LENGTH] = {};
+		MetricGauge mGauges[METRICS_MAX_GAUGES];
+		std::atomic<int> mGaugeCount = 0;
+
+		LatencyHistogram mSpareHistogram;
+		MetricCounter mSpareCounter;
+		MetricGauge mSpareGauge;
+	};
+
+	// The one everything in this process reports to
+	MetricsRegistry& getMetrics();
+
+	// One line per metric, histograms in microseconds. Appends so several processes can
+	// go in the same dump.
+	void formatMetrics(const char* process, const MetricsSnapshot& snapshot, std::string& text);
+	bool writeMetrics(const std::string& path, const std::string& text);
+} // namespace HOL
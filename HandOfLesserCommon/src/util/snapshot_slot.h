@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace HOL
+{
+	// Single producer, any number of consumers, latest value wins.
+	// Like LatestValueMailbox, but every reader keeps its own place, so the same value can
+	// be handed to several threads that each run at their own rate. Publishing never
+	// blocks, readers never block the writer.
+	//
+	// Writer goes round a ring of slots, a reader copies the newest one and retries if the
+	// writer came back round to it while it was copying. With a few slots a reader has
+	// several publishes worth of time to finish its copy.
+	//
+	// T should be plain data, the same kind of thing we'd memcpy onto the wire.
+	template <typename T, int SlotCount = 4> class SnapshotSlot
+	{
+		static_assert(SlotCount >= 2);
+
+	public:
+		void publish(const T& value)
+		{
+			uint64_t sequence = this->mPublished.load(std::memory_order_relaxed) + 1;
+
+			this->mWriting.store(sequence, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			this->mSlots[sequence % SlotCount] = value;
+
+			this->mPublished.store(sequence, std::memory_order_release);
+		}
+
+		// Copies the latest value if it's newer than lastSequence, and updates lastSequence.
+		// Start readers at 0. Anything between the old and new lastSequence was skipped.
+		bool read(T& out, uint64_t& lastSequence)
+		{
+			while (true)
+			{
+				uint64_t sequence = this->mPublished.load(std::memory_order_acquire);
+				if (sequence == lastSequence)
+				{
+					return false;
+				}
+
+				out = this->mSlots[sequence % SlotCount];
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				// Slot is only rewritten by sequence + SlotCount
+				if (this->mWriting.load(std::memory_order_relaxed) < sequence + SlotCount)
+				{
+					lastSequence = sequence;
+					return true;
+				}
+			}
+		}
+
+		uint64_t getSequence()
+		{
+			return this->mPublished.load(std::memory_order_acquire);
+		}
+
+	private:
+		alignas(64) std::atomic<uint64_t> mPublished = 0;
+		std::atomic<uint64_t> mWriting = 0;
+		T mSlots[SlotCount] = {};
+	};
+
+} // namespace HOL
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace HOL
+{
+	// steady_clock is system-wide on both platforms we care about,
+	// so this can be compared between the app and the driver.
+	inline int64_t steadyNanoseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				   std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+	}
+
+	// First time strictly after time that is base plus a whole number of periods.
+	// Works on either side of base.
+	inline int64_t nextTimeOnGrid(int64_t base, int64_t period, int64_t time)
+	{
+		int64_t offset = time - base;
+
+		// Round towards negative infinity
+		int64_t periods = offset / period;
+		if (offset % period < 0)
+		{
+			periods--;
+		}
+
+		return base + (periods + 1) * period;
+	}
+} // namespace HOL
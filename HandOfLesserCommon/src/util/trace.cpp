@@ -0,0 +1,269 @@
+#include "trace.h"
+#include "src/packet/nativepacket.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+namespace HOL
+{
+	namespace
+	{
+		struct TraceBuffer
+		{
+			TraceEvent events[TRACE_BUFFER_EVENTS];
+			std::atomic<uint64_t> written = 0; // Only ever goes up, index is modulo the size
+			uint64_t collected = 0;				// Collector's side
+			uint32_t thread = 0;
+			char name[TRACE_THREAD_NAME_LENGTH] = {};
+		};
+
+		// Buffers outlive their threads, whatever they recorded can still be collected
+		struct TraceRegistry
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<TraceBuffer>> buffers;
+		};
+
+		TraceRegistry& getRegistry()
+		{
+			static TraceRegistry registry;
+			return registry;
+		}
+
+		thread_local TraceBuffer* tBuffer = nullptr;
+
+		TraceBuffer* getThreadBuffer()
+		{
+			if (tBuffer == nullptr)
+			{
+				TraceRegistry& registry = getRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+
+				auto buffer = std::make_unique<TraceBuffer>();
+				buffer->thread = (uint32_t)registry.buffers.size() + 1;
+				snprintf(buffer->name, sizeof(buffer->name), "Thread %u", buffer->thread);
+
+				tBuffer = buffer.get();
+				registry.buffers.push_back(std::move(buffer));
+			}
+
+			return tBuffer;
+		}
+
+		// Names are ours, but don't let a stray quote break the whole file
+		void writeJsonString(FILE* file, const char* text)
+		{
+			fputc('"', file);
+			for (const char* c = text; *c != '\0'; c++)
+			{
+				if (*c == '"' || *c == '\\')
+				{
+					fputc('\\', file);
+				}
+
+				if ((unsigned char)*c >= 0x20)
+				{
+					fputc(*c, file);
+				}
+			}
+			fputc('"', file);
+		}
+
+		// Microseconds with the nanoseconds after the point, doubles would round them off
+		void writeMicroseconds(FILE* file, int64_t nanoseconds)
+		{
+			fprintf(file,
+					"%lld.%03lld",
+					(long long)(nanoseconds / 1000),
+					(long long)(nanoseconds % 1000));
+		}
+	} // namespace
+
+	void Tracer::setEnabled(bool enabled)
+	{
+		sEnabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	void Tracer::setThreadName(const char* name)
+	{
+		TraceBuffer* buffer = getThreadBuffer();
+
+		std::lock_guard<std::mutex> lock(getRegistry().mutex);
+		snprintf(buffer->name, sizeof(buffer->name), "%s", name);
+	}
+
+	void Tracer::record(const char* name, int64_t start, int64_t end)
+	{
+		TraceBuffer* buffer = getThreadBuffer();
+		uint64_t index = buffer->written.load(std::memory_order_relaxed);
+
+		TraceEvent& event = buffer->events[index % TRACE_BUFFER_EVENTS];
+		event.name = name;
+		event.start = start;
+		event.duration = end - start;
+		event.thread = buffer->thread;
+
+		buffer->written.store(index + 1, std::memory_order_release);
+	}
+
+	std::vector<TraceEvent> Tracer::collect()
+	{
+		std::vector<TraceEvent> events;
+
+		TraceRegistry& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		for (auto& buffer : registry.buffers)
+		{
+			uint64_t written = buffer->written.load(std::memory_order_acquire);
+			uint64_t first = written > TRACE_BUFFER_EVENTS ? written - TRACE_BUFFER_EVENTS : 0;
+			first = std::max(first, buffer->collected);
+
+			size_t begin = events.size();
+			for (uint64_t i = first; i < written; i++)
+			{
+				events.push_back(buffer->events[i % TRACE_BUFFER_EVENTS]);
+			}
+
+			// Anything the thread wrapped around onto while we were copying is garbage
+			uint64_t after = buffer->written.load(std::memory_order_acquire);
+			if (after > first + TRACE_BUFFER_EVENTS)
+			{
+				size_t overwritten = (size_t)std::min(after - TRACE_BUFFER_EVENTS - first,
+													  written - first);
+				events.erase(events.begin() + begin, events.begin() + begin + overwritten);
+			}
+
+			buffer->collected = written;
+		}
+
+		std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+			return a.start < b.start;
+		});
+
+		return events;
+	}
+
+	std::vector<TraceThread> Tracer::getThreads()
+	{
+		std::vector<TraceThread> threads;
+
+		TraceRegistry& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		for (auto& buffer : registry.buffers)
+		{
+			threads.push_back({buffer->thread, buffer->name});
+		}
+
+		return threads;
+	}
+
+	bool writeChromeTrace(const std::string& path,
+						  uint32_t processId,
+						  const char* processName,
+						  const std::vector<TraceEvent>& events,
+						  const std::vector<TraceThread>& threads,
+						  const std::vector<std::string>& mergeFiles)
+	{
+		FILE* file = fopen(path.c_str(), "wb");
+		if (file == nullptr)
+		{
+			std::cerr << "Failed to open " << path << " for writing" << std::endl;
+			return false;
+		}
+
+		// One event per line, so merging only has to pick out the lines that are events
+		fprintf(file, "{\"traceEvents\":[\n");
+		fprintf(file,
+				"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":",
+				processId);
+		writeJsonString(file, processName);
+		fprintf(file, "}}");
+
+		for (const TraceThread& thread : threads)
+		{
+			fprintf(file,
+					",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":",
+					processId,
+					thread.id);
+			writeJsonString(file, thread.name.c_str());
+			fprintf(file, "}}");
+		}
+
+		for (const TraceEvent& event : events)
+		{
+			fprintf(file, ",\n{\"name\":");
+			writeJsonString(file, event.name);
+			fprintf(file, ",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":", processId, event.thread);
+			writeMicroseconds(file, event.start);
+			fprintf(file, ",\"dur\":");
+			writeMicroseconds(file, event.duration);
+			fprintf(file, "}");
+		}
+
+		for (const std::string& mergePath : mergeFiles)
+		{
+			std::ifstream merge(mergePath);
+			if (!merge)
+			{
+				std::cerr << "Failed to open " << mergePath << " to merge, skipping it"
+						  << std::endl;
+				continue;
+			}
+
+			std::string line;
+			while (std::getline(merge, line))
+			{
+				if (line.rfind("{\"name\":", 0) != 0)
+				{
+					continue;
+				}
+
+				if (!line.empty() && line.back() == ',')
+				{
+					line.pop_back();
+				}
+
+				fprintf(file, ",\n%s", line.c_str());
+			}
+		}
+
+		fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+		bool good = ferror(file) == 0;
+		if (fclose(file) != 0 || !good)
+		{
+			std::cerr << "Failed to write " << path << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	std::string getTraceDirectory()
+	{
+		std::error_code error;
+		std::filesystem::path temp = std::filesystem::temp_directory_path(error);
+		return (temp / "HandOfLesser" / "traces").string();
+	}
+
+	bool isValidTraceFileName(const std::string& fileName)
+	{
+		if (fileName.empty() || fileName.size() >= TRACE_FILE_NAME_LENGTH || fileName[0] == '.'
+			|| fileName.find("..") != std::string::npos)
+		{
+			return false;
+		}
+
+		return std::all_of(fileName.begin(), fileName.end(), [](char c) {
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+				   || c == '_' || c == '-' || c == '.';
+		});
+	}
+} // namespace HOL
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "time_utils.h"
+
+// Scoped zones for seeing where a frame's time goes. Compiled out entirely unless HOL_TRACING
+// is defined (HOL_ENABLE_TRACING in cmake), and until tracing is switched on at runtime a zone
+// is a single relaxed load.
+#ifdef HOL_TRACING
+#define HOL_TRACE_CONCAT_INNER(a, b) a##b
+#define HOL_TRACE_CONCAT(a, b) HOL_TRACE_CONCAT_INNER(a, b)
+#define HOL_TRACE_SCOPE(name) HOL::TraceScope HOL_TRACE_CONCAT(holTraceScope, __LINE__)(name)
+#define HOL_TRACE_THREAD(name) HOL::Tracer::setThreadName(name)
+#else
+#define HOL_TRACE_SCOPE(name) ((void)0)
+#define HOL_TRACE_THREAD(name) ((void)0)
+#endif
+
+namespace HOL
+{
+	// Per thread, oldest events are overwritten. A few seconds of a busy thread.
+	static const uint32_t TRACE_BUFFER_EVENTS = 16384;
+	static const size_t TRACE_THREAD_NAME_LENGTH = 32;
+
+	// Used in the exported trace to keep the app and driver apart
+	static const uint32_t TRACE_PROCESS_APP = 1;
+	static const uint32_t TRACE_PROCESS_DRIVER = 2;
+
+	// Name is never copied, must be a string literal or otherwise outlive the trace
+	struct TraceEvent
+	{
+		const char* name = nullptr;
+		int64_t start = 0; // steadyNanoseconds(), same clock in the app and the driver
+		int64_t duration = 0;
+		uint32_t thread = 0;
+	};
+
+	struct TraceThread
+	{
+		uint32_t id = 0;
+		std::string name;
+	};
+
+	// Every thread records into a ring buffer of its own, nothing is shared or locked
+	// while recording. Buffers are only allocated once a thread records something.
+	class Tracer
+	{
+	public:
+		static void setEnabled(bool enabled);
+		static bool isEnabled()
+		{
+			return sEnabled.load(std::memory_order_relaxed);
+		}
+
+		static void setThreadName(const char* name);
+		static void record(const char* name, int64_t start, int64_t end);
+
+		// Takes everything recorded so far out of the buffers, sorted by start time.
+		// Disable first, events recorded while this runs may be dropped.
+		static std::vector<TraceEvent> collect();
+		static std::vector<TraceThread> getThreads();
+
+	private:
+		static inline std::atomic<bool> sEnabled = false;
+	};
+
+	class TraceScope
+	{
+	public:
+		TraceScope(const char* name)
+			: mName(name), mStart(Tracer::isEnabled() ? steadyNanoseconds() : 0)
+		{
+		}
+
+		~TraceScope()
+		{
+			if (this->mStart != 0)
+			{
+				Tracer::record(this->mName, this->mStart, steadyNanoseconds());
+			}
+		}
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+
+	private:
+		const char* mName;
+		int64_t mStart;
+	};
+
+	// Chrome trace JSON, opens in chrome://tracing or ui.perfetto.dev.
+	// Events from mergeFiles, written by this in another process, are copied in as they are,
+	// which is how the app and driver end up on the same timeline.
+	bool writeChromeTrace(const std::string& path,
+						  uint32_t processId,
+						  const char* processName,
+						  const std::vector<TraceEvent>& events,
+						  const std::vector<TraceThread>& threads,
+						  const std::vector<std::string>& mergeFiles = {});
+
+	// Where the driver writes its half of a trace. Fixed, so whoever asks for one can't
+	// have it written anywhere else.
+	std::string getTraceDirectory();
+
+	// Plain file name that stays inside getTraceDirectory(). No separators, no "..",
+	// nothing hidden, and short enough for a TraceControlPacket.
+	bool isValidTraceFileName(const std::string& fileName);
+} // namespace HOL
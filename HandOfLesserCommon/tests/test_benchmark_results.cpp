@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "src/benchmark/benchmark_results.h"
+
+using namespace HOL;
+
+static std::string benchmarkResultsPath(const char* name)
+{
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(BenchmarkResultsTest, RoundTrip)
+{
+	std::string path = benchmarkResultsPath("hol_benchmark_roundtrip.txt");
+	std::vector<BenchmarkResult> written = {
+		{"BM_ComputeCurl", 12.5, 56000000},
+		{"BM_UpdateGestures/real_time", 1834.25, 380000},
+	};
+
+	ASSERT_TRUE(writeBenchmarkResults(path, written));
+
+	std::vector<BenchmarkResult> read;
+	ASSERT_TRUE(readBenchmarkResults(path, read));
+	ASSERT_EQ(read.size(), 2u);
+	EXPECT_EQ(read[0].name, "BM_ComputeCurl");
+	EXPECT_DOUBLE_EQ(read[0].nanoseconds, 12.5);
+	EXPECT_EQ(read[0].iterations, 56000000u);
+	EXPECT_EQ(read[1].name, "BM_UpdateGestures/real_time");
+	EXPECT_DOUBLE_EQ(read[1].nanoseconds, 1834.25);
+
+	std::remove(path.c_str());
+}
+
+TEST(BenchmarkResultsTest, RejectsOtherFiles)
+{
+	std::string path = benchmarkResultsPath("hol_benchmark_garbage.txt");
+	std::vector<BenchmarkResult> read;
+
+	{
+		std::ofstream file(path);
+		file << "name,time\nBM_Thing,12\n";
+	}
+	EXPECT_FALSE(readBenchmarkResults(path, read));
+
+	{
+		std::ofstream file(path);
+		file << "# HandOfLesser benchmark results 1\nBM_Thing\tfast\t10\n";
+	}
+	EXPECT_FALSE(readBenchmarkResults(path, read));
+
+	std::remove(path.c_str());
+}
+
+TEST(BenchmarkResultsTest, ComparesAgainstThreshold)
+{
+	std::vector<BenchmarkResult> baseline = {
+		{"BM_Same", 100, 1},
+		{"BM_Slower", 100, 1},
+		{"BM_Faster", 100, 1},
+		{"BM_Removed", 100, 1},
+	};
+	std::vector<BenchmarkResult> current = {
+		{"BM_New", 100, 1},
+		{"BM_Same", 105, 1},
+		{"BM_Slower", 125, 1},
+		{"BM_Faster", 50, 1},
+	};
+
+	std::vector<BenchmarkComparison> comparisons
+		= compareBenchmarkResults(baseline, current, 10.f);
+
+	// New and removed ones have nothing to compare to
+	ASSERT_EQ(comparisons.size(), 3u);
+	EXPECT_EQ(comparisons[0].name, "BM_Same");
+	EXPECT_FALSE(comparisons[0].regressed);
+	EXPECT_NEAR(comparisons[0].change, 5.f, 0.001f);
+	EXPECT_EQ(comparisons[1].name, "BM_Slower");
+	EXPECT_TRUE(comparisons[1].regressed);
+	EXPECT_NEAR(comparisons[1].change, 25.f, 0.001f);
+	EXPECT_FALSE(comparisons[2].regressed);
+	EXPECT_NEAR(comparisons[2].change, -50.f, 0.001f);
+}
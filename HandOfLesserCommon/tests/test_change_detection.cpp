@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "src/packet/change_detection.h"
+
+using namespace HOL;
+
+static const int64_t MS = 1000000;
+
+static HandTransformPacket makePose(float x)
+{
+	HandTransformPacket packet;
+	packet.active = true;
+	packet.valid = true;
+	packet.side = HandSide::LeftHand;
+	packet.location.position = Eigen::Vector3f(x, 1, 0);
+	packet.location.orientation = Eigen::Quaternionf::Identity();
+	packet.velocity.linearVelocity = Eigen::Vector3f::Zero();
+	packet.velocity.angularVelocity = Eigen::Vector3f::Zero();
+	return packet;
+}
+
+TEST(ChangeDetectionTest, ChannelDeadbandAndKeepAlive)
+{
+	DeadbandChannel channel;
+
+	// Never sent, always goes
+	EXPECT_TRUE(channel.changed(0.5f, 0.01f, 100 * MS, 0));
+	channel.sent(0.5f, 0);
+
+	EXPECT_FALSE(channel.changed(0.505f, 0.01f, 100 * MS, 10 * MS));
+	EXPECT_TRUE(channel.changed(0.52f, 0.01f, 100 * MS, 10 * MS));
+
+	// Nothing moved but it's been a while
+	EXPECT_TRUE(channel.changed(0.5f, 0.01f, 100 * MS, 100 * MS));
+
+	// No keep-alive means always
+	EXPECT_TRUE(channel.changed(0.5f, 0.01f, 0, 10 * MS));
+}
+
+TEST(ChangeDetectionTest, RestingPoseIsNotResent)
+{
+	PoseChangeDetector detector;
+	const float position = 0.001f;
+	const float angle = 0.005f;
+
+	EXPECT_TRUE(detector.shouldSend(makePose(0), position, angle, 500 * MS, 0));
+
+	// Jitter well inside the dead-band
+	int sent = 0;
+	for (int i = 1; i < 400; i++)
+	{
+		float jitter = (i % 2 ? 1 : -1) * 0.0002f;
+		sent += detector.shouldSend(makePose(jitter), position, angle, 500 * MS, i * MS);
+	}
+	EXPECT_EQ(sent, 0);
+
+	// Moves, goes right away
+	EXPECT_TRUE(detector.shouldSend(makePose(0.01f), position, angle, 500 * MS, 400 * MS));
+
+	// Keep-alive
+	EXPECT_FALSE(detector.shouldSend(makePose(0.01f), position, angle, 500 * MS, 800 * MS));
+	EXPECT_TRUE(detector.shouldSend(makePose(0.01f), position, angle, 500 * MS, 900 * MS));
+}
+
+TEST(ChangeDetectionTest, PoseFlagsAndVelocityAlwaysCount)
+{
+	PoseChangeDetector detector;
+	HandTransformPacket packet = makePose(0);
+
+	EXPECT_TRUE(detector.shouldSend(packet, 0.001f, 0.005f, 500 * MS, 0));
+
+	packet.valid = false;
+	EXPECT_TRUE(detector.shouldSend(packet, 0.001f, 0.005f, 500 * MS, 1 * MS));
+
+	// Hand stopped, driver needs to hear the velocity went away
+	packet.velocity.linearVelocity = Eigen::Vector3f(0.5f, 0, 0);
+	EXPECT_TRUE(detector.shouldSend(packet, 0.001f, 0.005f, 500 * MS, 2 * MS));
+	packet.velocity.linearVelocity = Eigen::Vector3f::Zero();
+	EXPECT_TRUE(detector.shouldSend(packet, 0.001f, 0.005f, 500 * MS, 3 * MS));
+}
+
+TEST(ChangeDetectionTest, SkeletonFingerMovement)
+{
+	SkeletonChangeDetector detector;
+	HandSkeletonPacket packet;
+	for (int i = 0; i < HAND_SKELETON_JOINT_COUNT; i++)
+	{
+		setSkeletonJoint(
+			packet, i, Eigen::Vector3f(0, 0, -0.01f * i), Eigen::Quaternionf::Identity());
+	}
+
+	EXPECT_TRUE(detector.shouldSend(packet, 0.001f, 500 * MS, 0));
+
+	packet.positionZ[10] += 0.0005f;
+	EXPECT_FALSE(detector.shouldSend(packet, 0.001f, 500 * MS, 1 * MS));
+
+	// Only the fingertip moved, still counts
+	packet.positionX[25] += 0.002f;
+	EXPECT_TRUE(detector.shouldSend(packet, 0.001f, 500 * MS, 2 * MS));
+
+	// Losing a joint counts
+	packet.validJoints &= ~(1u << 3);
+	EXPECT_TRUE(detector.shouldSend(packet, 0.001f, 500 * MS, 3 * MS));
+}
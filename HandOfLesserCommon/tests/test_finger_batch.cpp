@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <random>
+#include "src/math/finger_batch.h"
+#include "src/math/fingers.h"
+
+using namespace HOL;
+
+static const float FINGER_BATCH_TOLERANCE = 5e-6f;
+
+static Eigen::Quaternionf randomRotation(std::mt19937& random, float range)
+{
+	std::uniform_real_distribution<float> angle(-range, range);
+	return Eigen::Quaternionf(Eigen::AngleAxisf(angle(random), Eigen::Vector3f::UnitX())
+							  * Eigen::AngleAxisf(angle(random), Eigen::Vector3f::UnitY())
+							  * Eigen::AngleAxisf(angle(random), Eigen::Vector3f::UnitZ()));
+}
+
+// Angles either side of +-pi are the same thing
+static float angleDifference(float a, float b)
+{
+	float difference = std::abs(a - b);
+	return std::min(difference, 2 * std::numbers::pi_v<float> - difference);
+}
+
+static void expectMatchesScalar(const Eigen::Quaternionf* previous,
+								const Eigen::Quaternionf* next,
+								int count)
+{
+	auto batch = std::make_unique<FingerBatch>();
+	for (int i = 0; i < count; i++)
+	{
+		ASSERT_EQ(batch->add(previous[i], next[i]), i);
+	}
+
+	computeCurlSplayBatch(*batch);
+
+	for (int i = 0; i < count; i++)
+	{
+		EXPECT_LE(angleDifference(batch->curl[i], computeCurl(previous[i], next[i])),
+				  FINGER_BATCH_TOLERANCE)
+			<< i;
+		EXPECT_LE(angleDifference(batch->splay[i], computeSplay(previous[i], next[i])),
+				  FINGER_BATCH_TOLERANCE)
+			<< i;
+	}
+}
+
+TEST(FingerBatchTest, MatchesScalarOnFingerRanges)
+{
+	// Roughly what real fingers get up to, a few batches worth
+	std::mt19937 random(1234);
+	for (int round = 0; round < 100; round++)
+	{
+		Eigen::Quaternionf previous[FINGER_BATCH_PAIRS];
+		Eigen::Quaternionf next[FINGER_BATCH_PAIRS];
+		for (int i = 0; i < FINGER_BATCH_PAIRS; i++)
+		{
+			previous[i] = randomRotation(random, std::numbers::pi_v<float>);
+			next[i] = previous[i] * randomRotation(random, 1.5f);
+		}
+
+		expectMatchesScalar(previous, next, FINGER_BATCH_PAIRS);
+	}
+}
+
+TEST(FingerBatchTest, MatchesScalarOnAnyRotation)
+{
+	std::mt19937 random(5678);
+	for (int round = 0; round < 100; round++)
+	{
+		Eigen::Quaternionf previous[FINGER_BATCH_PAIRS];
+		Eigen::Quaternionf next[FINGER_BATCH_PAIRS];
+		for (int i = 0; i < FINGER_BATCH_PAIRS; i++)
+		{
+			previous[i] = Eigen::Quaternionf::UnitRandom();
+			next[i] = Eigen::Quaternionf::UnitRandom();
+		}
+
+		expectMatchesScalar(previous, next, FINGER_BATCH_PAIRS);
+	}
+}
+
+TEST(FingerBatchTest, HandlesSpecialRotations)
+{
+	const float pi = std::numbers::pi_v<float>;
+	Eigen::Quaternionf identity = Eigen::Quaternionf::Identity();
+
+	Eigen::Quaternionf next[] = {
+		identity,
+		Eigen::Quaternionf(Eigen::AngleAxisf(pi / 2, Eigen::Vector3f::UnitX())),
+		Eigen::Quaternionf(Eigen::AngleAxisf(-pi / 2, Eigen::Vector3f::UnitX())),
+		Eigen::Quaternionf(Eigen::AngleAxisf(pi / 4, Eigen::Vector3f::UnitY())),
+		Eigen::Quaternionf(Eigen::AngleAxisf(-pi / 3, Eigen::Vector3f::UnitY())),
+		Eigen::Quaternionf(Eigen::AngleAxisf(pi / 2 - 0.01f, Eigen::Vector3f::UnitY())),
+		Eigen::Quaternionf(Eigen::AngleAxisf(1.f, Eigen::Vector3f::UnitZ())),
+		Eigen::Quaternionf(Eigen::AngleAxisf(0.75f, Eigen::Vector3f(1, 1, 0).normalized())),
+		// Same rotation, other hemisphere
+		Eigen::Quaternionf(-0.5f, -0.5f, -0.5f, -0.5f),
+		Eigen::Quaternionf(0.5f, 0.5f, 0.5f, 0.5f),
+	};
+
+	const int count = sizeof(next) / sizeof(next[0]);
+	Eigen::Quaternionf previous[count];
+	std::fill(std::begin(previous), std::end(previous), identity);
+
+	expectMatchesScalar(previous, next, count);
+
+	// Known values, not just whatever the scalar version says
+	auto batch = std::make_unique<FingerBatch>();
+	batch->add(identity, next[1]);
+	batch->add(identity, next[3]);
+	computeCurlSplayBatch(*batch);
+	EXPECT_NEAR(batch->curl[0], pi / 2, FINGER_BATCH_TOLERANCE);
+	EXPECT_NEAR(batch->splay[0], 0, FINGER_BATCH_TOLERANCE);
+	EXPECT_NEAR(batch->curl[1], 0, FINGER_BATCH_TOLERANCE);
+	EXPECT_NEAR(batch->splay[1], pi / 4, FINGER_BATCH_TOLERANCE);
+}
+
+TEST(FingerBatchTest, StopsWhenFull)
+{
+	auto batch = std::make_unique<FingerBatch>();
+	Eigen::Quaternionf identity = Eigen::Quaternionf::Identity();
+
+	for (int i = 0; i < FINGER_BATCH_PAIRS; i++)
+	{
+		EXPECT_EQ(batch->add(identity, identity), i);
+	}
+
+	EXPECT_EQ(batch->add(identity, identity), -1);
+	EXPECT_EQ(batch->count, FINGER_BATCH_PAIRS);
+}
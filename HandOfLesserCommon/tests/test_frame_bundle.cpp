@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "src/packet/frame_bundle.h"
+
+using namespace HOL;
+
+TEST(FrameBundleTest, RoundTripsPacketsInOrder)
+{
+	FrameBundleWriter writer;
+	writer.reset();
+
+	HandTransformPacket transform;
+	transform.side = HandSide::RightHand;
+	transform.valid = true;
+
+	FloatInputPacket floatInput;
+	std::strncpy(floatInput.inputName, "/input/trigger/value", 64);
+	floatInput.value = 0.5f;
+
+	BoolInputPacket boolInput;
+	std::strncpy(boolInput.inputName, "/input/a/click", 64);
+	boolInput.value = true;
+
+	EXPECT_TRUE(writer.add(transform));
+	EXPECT_TRUE(writer.add(floatInput));
+	EXPECT_TRUE(writer.add(boolInput));
+
+	FrameBundleReader reader(writer.getBuffer(), writer.size());
+
+	NativePacket* packet = reader.next();
+	ASSERT_NE(packet, nullptr);
+	ASSERT_EQ(packet->packetType, NativePacketType::HandTransform);
+	EXPECT_EQ(((HandTransformPacket*)packet)->side, HandSide::RightHand);
+
+	packet = reader.next();
+	ASSERT_NE(packet, nullptr);
+	ASSERT_EQ(packet->packetType, NativePacketType::FloatInput);
+	EXPECT_FLOAT_EQ(((FloatInputPacket*)packet)->value, 0.5f);
+	EXPECT_STREQ(((FloatInputPacket*)packet)->inputName, "/input/trigger/value");
+
+	packet = reader.next();
+	ASSERT_NE(packet, nullptr);
+	ASSERT_EQ(packet->packetType, NativePacketType::BoolInput);
+	EXPECT_TRUE(((BoolInputPacket*)packet)->value);
+
+	EXPECT_EQ(reader.next(), nullptr);
+}
+
+TEST(FrameBundleTest, RefusesPacketsThatDoNotFit)
+{
+	FrameBundleWriter writer;
+	writer.reset();
+
+	FloatInputPacket floatInput;
+	int added = 0;
+	while (writer.add(floatInput))
+	{
+		added++;
+	}
+
+	EXPECT_GT(added, 0);
+	EXPECT_LE(writer.size(), FRAME_BUNDLE_MAX_SIZE);
+}
+
+TEST(FrameBundleTest, StopsAtTruncatedBundle)
+{
+	FrameBundleWriter writer;
+	writer.reset();
+
+	HandTransformPacket transform;
+	writer.add(transform);
+	writer.add(transform);
+
+	// Chop off part of the last entry
+	FrameBundleReader reader(writer.getBuffer(), writer.size() - 4);
+	EXPECT_EQ(reader.next(), nullptr);
+
+	FrameBundleHeader* header = (FrameBundleHeader*)writer.getBuffer();
+	header->totalSize = (uint32_t)writer.size() - 4;
+	FrameBundleReader shortReader(writer.getBuffer(), writer.size());
+	EXPECT_NE(shortReader.next(), nullptr);
+	EXPECT_EQ(shortReader.next(), nullptr);
+}
+
+TEST(FrameBundleTest, KeepsEntriesAligned)
+{
+	FrameBundleWriter writer;
+	writer.reset();
+
+	// Odd sized packet first so the pose after it would land off alignment without padding
+	BoolInputPacket boolInput;
+	HandTransformPacket transform;
+	writer.add(boolInput);
+	writer.add(transform);
+
+	FrameBundleReader reader(writer.getBuffer(), writer.size());
+	for (NativePacket* packet = reader.next(); packet != nullptr; packet = reader.next())
+	{
+		EXPECT_EQ((uintptr_t)packet % alignof(HandTransformPacket), 0u);
+	}
+}
+
+TEST(FrameBundleTest, StopsAtEntrySmallerThanItsPacket)
+{
+	FrameBundleWriter writer;
+	writer.reset();
+
+	// Claims to be a pose, but is only big enough for the common header
+	HandTransformPacket transform;
+	writer.add(&transform, sizeof(NativePacket));
+
+	FrameBundleReader reader(writer.getBuffer(), writer.size());
+	EXPECT_EQ(reader.next(), nullptr);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "src/util/frame_scheduler.h"
+#include "src/util/time_utils.h"
+
+using namespace HOL;
+
+static const int64_t MS = 1000000;
+
+TEST(FrameSchedulerTest, DeadlinesFollowPhase)
+{
+	FrameScheduler scheduler;
+	scheduler.setPeriod(10 * MS);
+	scheduler.setPhase(1003 * MS, -2 * MS);
+
+	// Grid is ..., 1001, 1011, 1021, ...
+	EXPECT_EQ(scheduler.scheduleNext(1005 * MS), 1011 * MS);
+	EXPECT_EQ(scheduler.scheduleNext(1012 * MS), 1021 * MS);
+
+	// Times before the reference work too
+	FrameScheduler early;
+	early.setPeriod(10 * MS);
+	early.setPhase(1003 * MS, -2 * MS);
+	EXPECT_EQ(early.scheduleNext(955 * MS), 961 * MS);
+}
+
+TEST(FrameSchedulerTest, OverrunRunsLateThenSkips)
+{
+	FrameScheduler scheduler;
+	scheduler.setPeriod(10 * MS);
+
+	EXPECT_EQ(scheduler.scheduleNext(5 * MS), 10 * MS);
+
+	// Ran a little over, next frame starts right away but stays on the grid
+	EXPECT_EQ(scheduler.scheduleNext(23 * MS), 20 * MS);
+	EXPECT_EQ(scheduler.scheduleNext(24 * MS), 30 * MS);
+
+	// Ran way over, 40 and 50 are gone
+	EXPECT_EQ(scheduler.scheduleNext(55 * MS), 60 * MS);
+
+	FrameSchedulerStatistics statistics = scheduler.getStatistics();
+	EXPECT_EQ(statistics.overruns, 2u);
+	EXPECT_EQ(statistics.missedDeadlines, 2u);
+}
+
+TEST(FrameSchedulerTest, PeriodChangeKeepsGoing)
+{
+	FrameScheduler scheduler;
+	scheduler.setPeriod(10 * MS);
+
+	EXPECT_EQ(scheduler.scheduleNext(5 * MS), 10 * MS);
+
+	scheduler.setPeriod(4 * MS);
+	EXPECT_EQ(scheduler.scheduleNext(11 * MS), 12 * MS);
+	EXPECT_EQ(scheduler.scheduleNext(13 * MS), 16 * MS);
+}
+
+TEST(FrameSchedulerTest, WakesOnDeadline)
+{
+	FrameScheduler scheduler;
+	scheduler.setPeriod(2 * MS);
+
+	int64_t lastDeadline = 0;
+	for (int i = 0; i < 20; i++)
+	{
+		int64_t deadline = scheduler.waitForNextFrame();
+		EXPECT_GE(steadyNanoseconds(), deadline);
+
+		if (lastDeadline != 0)
+		{
+			EXPECT_EQ((deadline - lastDeadline) % (2 * MS), 0);
+		}
+		lastDeadline = deadline;
+	}
+
+	FrameSchedulerStatistics statistics = scheduler.getStatistics();
+	EXPECT_EQ(statistics.frames, 20u);
+
+	// Loose, this is a shared machine. Only checks we're not off by a whole frame.
+	if (statistics.missedDeadlines == 0)
+	{
+		EXPECT_NEAR(statistics.periodMeanUS, 2000.f, 500.f);
+	}
+}
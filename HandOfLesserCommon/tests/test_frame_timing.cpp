@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "src/packet/frame_timing.h"
+
+using namespace HOL;
+
+static const int64_t PERIOD_90HZ = 11111111;
+
+TEST(FrameTimingTest, NotLockedUntilEnoughFrames)
+{
+	FrameCadenceEstimator estimator;
+
+	for (int i = 0; i < FRAME_CADENCE_MIN_SAMPLES - 1; i++)
+	{
+		estimator.addFrame(1000000000 + i * PERIOD_90HZ);
+	}
+
+	EXPECT_FALSE(estimator.isLocked());
+	EXPECT_EQ(estimator.nextFrameAfter(5), 5);
+
+	estimator.addFrame(1000000000 + (FRAME_CADENCE_MIN_SAMPLES - 1) * PERIOD_90HZ);
+	EXPECT_TRUE(estimator.isLocked());
+}
+
+TEST(FrameTimingTest, LocksOntoJitteryCadenceWithDroppedFrames)
+{
+	std::mt19937 random(42);
+	std::normal_distribution<double> jitter(0, 300000); // 0.3ms
+
+	FrameCadenceEstimator estimator;
+	const int64_t start = 5000000000;
+
+	for (int i = 0; i < 200; i++)
+	{
+		// Every so often SteamVR doesn't call us for a frame
+		if (i % 17 == 5)
+		{
+			continue;
+		}
+
+		estimator.addFrame(start + i * PERIOD_90HZ + (int64_t)jitter(random));
+	}
+
+	ASSERT_TRUE(estimator.isLocked());
+	EXPECT_NEAR((double)estimator.getPeriod(), (double)PERIOD_90HZ, 50000.0);
+
+	// Next frame lands on the real grid, give or take the jitter
+	int64_t next = estimator.nextFrameAfter(start + 200 * PERIOD_90HZ + 1000000);
+	EXPECT_NEAR((double)next, (double)(start + 201 * PERIOD_90HZ), 500000.0);
+}
+
+TEST(FrameTimingTest, StallResets)
+{
+	FrameCadenceEstimator estimator;
+
+	for (int i = 0; i < 32; i++)
+	{
+		estimator.addFrame(1000000000 + i * PERIOD_90HZ);
+	}
+	ASSERT_TRUE(estimator.isLocked());
+
+	estimator.addFrame(1000000000 + 32 * PERIOD_90HZ + FRAME_CADENCE_RESET_GAP_NS + 1);
+	EXPECT_FALSE(estimator.isLocked());
+}
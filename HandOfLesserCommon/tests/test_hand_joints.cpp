@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include "src/hand/hand_joints.h"
+
+using namespace HOL;
+
+TEST(HandJointsTest, JointRoundTrip)
+{
+	HandJoints joints;
+
+	Eigen::Vector3f position(0.1f, -0.2f, 0.3f);
+	Eigen::Quaternionf orientation = Eigen::Quaternionf(0.9f, 0.1f, -0.3f, 0.2f).normalized();
+	joints.setJoint(7, position, orientation, 0.01f, true, false);
+
+	EXPECT_TRUE(joints.position(7).isApprox(position));
+	EXPECT_TRUE(joints.orientation(7).isApprox(orientation));
+	EXPECT_FLOAT_EQ(joints.radius(7), 0.01f);
+	EXPECT_TRUE(joints.isValid(7));
+	EXPECT_FALSE(joints.isValid(6));
+	EXPECT_EQ(joints.validJoints, 1u << 7);
+	EXPECT_EQ(joints.trackedJoints, 0u);
+
+	// Neighbours are untouched
+	EXPECT_TRUE(joints.position(6).isZero());
+	EXPECT_TRUE(joints.position(8).isZero());
+
+	// Just the pose, flags and radius stay
+	joints.setJointPose(7, Eigen::Vector3f(1, 2, 3), Eigen::Quaternionf::Identity());
+	EXPECT_TRUE(joints.position(7).isApprox(Eigen::Vector3f(1, 2, 3)));
+	EXPECT_TRUE(joints.orientation(7).isApprox(Eigen::Quaternionf::Identity()));
+	EXPECT_FLOAT_EQ(joints.radius(7), 0.01f);
+	EXPECT_TRUE(joints.isValid(7));
+
+	joints.setJoint(7, position, orientation, 0.01f, false, false);
+	EXPECT_FALSE(joints.isValid(7));
+	EXPECT_EQ(joints.validJoints, 0u);
+}
+
+TEST(HandJointsTest, ReadsInPlace)
+{
+	HandJoints joints;
+	for (int i = 0; i < HAND_JOINT_COUNT; i++)
+	{
+		Eigen::Quaternionf orientation(Eigen::AngleAxisf(0.1f * i, Eigen::Vector3f::UnitZ()));
+		joints.setJoint(i, Eigen::Vector3f(i, 2.f * i, 3.f * i), orientation, 0.f, true, true);
+	}
+
+	for (int i = 0; i < HAND_JOINT_COUNT; i++)
+	{
+		// Maps straight onto the arrays, every joint on a 16 byte boundary
+		EXPECT_EQ(joints.position(i).data(), &joints.positions[i * 4]);
+		EXPECT_EQ(joints.orientation(i).coeffs().data(), &joints.orientations[i * 4]);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(joints.position(i).data()) % 16, 0u);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(joints.orientation(i).coeffs().data()) % 16, 0u);
+
+		EXPECT_EQ(joints.position(i).y(), 2.f * i);
+		EXPECT_NEAR(joints.orientation(i).w(), std::cos(0.05f * i), 1e-6f);
+	}
+
+	EXPECT_EQ(joints.validJoints, (1u << HAND_JOINT_COUNT) - 1);
+	EXPECT_EQ(joints.trackedJoints, (1u << HAND_JOINT_COUNT) - 1);
+}
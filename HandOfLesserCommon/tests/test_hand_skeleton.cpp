@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "src/packet/hand_skeleton.h"
+#include "src/packet/packet_table.h"
+#include "src/transport/transport.h"
+
+using namespace HOL;
+
+TEST(HandSkeletonTest, JointRoundTrip)
+{
+	HandSkeletonPacket packet;
+
+	Eigen::Quaternionf orientation = Eigen::Quaternionf(0.9f, 0.1f, -0.3f, 0.2f).normalized();
+	setSkeletonJoint(packet, 7, Eigen::Vector3f(0.1f, -0.2f, 0.3f), orientation);
+
+	EXPECT_EQ(packet.validJoints, 1u << 7);
+	EXPECT_TRUE(getSkeletonJointPosition(packet, 7).isApprox(Eigen::Vector3f(0.1f, -0.2f, 0.3f)));
+	EXPECT_TRUE(getSkeletonJointOrientation(packet, 7).isApprox(orientation));
+	EXPECT_FALSE(isSkeletonComplete(packet));
+
+	for (int i = 0; i < HAND_SKELETON_JOINT_COUNT; i++)
+	{
+		setSkeletonJoint(packet, i, Eigen::Vector3f::Zero(), Eigen::Quaternionf::Identity());
+	}
+
+	EXPECT_TRUE(isSkeletonComplete(packet));
+}
+
+TEST(HandSkeletonTest, PalmRelative)
+{
+	HandSkeletonPacket packet;
+
+	Eigen::Vector3f palmPosition(1.f, 1.5f, -0.5f);
+	Eigen::Quaternionf palmOrientation(Eigen::AngleAxisf(0.7f, Eigen::Vector3f::UnitY()));
+
+	Eigen::Vector3f localPosition(0.f, 0.02f, -0.08f);
+	Eigen::Quaternionf localOrientation(Eigen::AngleAxisf(0.4f, Eigen::Vector3f::UnitX()));
+
+	setSkeletonJoint(packet, 0, palmPosition, palmOrientation);
+	setSkeletonJoint(packet,
+					 10,
+					 palmPosition + palmOrientation * localPosition,
+					 palmOrientation * localOrientation);
+
+	makeSkeletonPalmRelative(packet, palmPosition, palmOrientation);
+
+	EXPECT_TRUE(getSkeletonJointPosition(packet, 0).isZero(1e-6f));
+	EXPECT_TRUE(getSkeletonJointOrientation(packet, 0).isApprox(Eigen::Quaternionf::Identity()));
+	EXPECT_TRUE(getSkeletonJointPosition(packet, 10).isApprox(localPosition, 1e-5f));
+	EXPECT_TRUE(getSkeletonJointOrientation(packet, 10).isApprox(localOrientation, 1e-5f));
+
+	// Untouched joints stay invalid
+	EXPECT_EQ(packet.validJoints, (1u << 0) | (1u << 10));
+}
+
+TEST(HandSkeletonTest, FitsAndDispatches)
+{
+	static_assert(sizeof(HandSkeletonPacket) < RECEIVE_SLOT_SIZE);
+
+	HandSkeletonPacket packet;
+	packet.side = HandSide::RightHand;
+
+	ReceivedPacket received{&packet, sizeof(HandSkeletonPacket), nullptr};
+
+	bool dispatched = false;
+	NativePacketTable::dispatch(received, [&](auto view) {
+		if constexpr (std::is_same_v<decltype(view), PacketView<HandSkeletonPacket>>)
+		{
+			dispatched = view->side == HandSide::RightHand;
+		}
+	});
+
+	EXPECT_TRUE(dispatched);
+
+	// Cut off at the end doesn't validate
+	received.length = sizeof(HandSkeletonPacket) - 4;
+	EXPECT_FALSE(NativePacketTable::dispatch(received, [](auto) {}));
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "src/input/input_id_table.h"
+
+using namespace HOL;
+
+TEST(InputIdTableTest, InternReturnsStableIds)
+{
+	InputIdTable table;
+	table.clear(1);
+
+	uint16_t trigger = table.intern("/input/trigger/value");
+	uint16_t a = table.intern("/input/a/click");
+
+	EXPECT_NE(trigger, a);
+	EXPECT_EQ(table.intern("/input/trigger/value"), trigger);
+	EXPECT_EQ(table.find("/input/a/click"), a);
+	EXPECT_EQ(table.find("/input/b/click"), INVALID_INPUT_ID);
+}
+
+TEST(InputIdTableTest, PagesRoundTripToOtherSide)
+{
+	InputIdTable driver;
+	driver.clear(1234);
+
+	// More than one page worth
+	for (int i = 0; i < INPUT_ID_TABLE_PAGE_SIZE + 5; i++)
+	{
+		driver.intern("/input/thing" + std::to_string(i) + "/value");
+	}
+
+	InputIdTable app;
+	InputIdTablePacket packet;
+	uint16_t firstId = 0;
+	do
+	{
+		firstId += driver.writePage(firstId, &packet);
+		app.readPage(&packet);
+	} while (firstId < packet.totalCount);
+
+	EXPECT_EQ(app.getGeneration(), 1234u);
+	EXPECT_EQ(app.size(), driver.size());
+	for (int i = 0; i < INPUT_ID_TABLE_PAGE_SIZE + 5; i++)
+	{
+		std::string name = "/input/thing" + std::to_string(i) + "/value";
+		EXPECT_EQ(app.find(name), driver.find(name));
+	}
+
+	// Driver restarted
+	InputIdTable restarted;
+	restarted.clear(5678);
+	restarted.intern("/input/other/click");
+	restarted.writePage(0, &packet);
+	app.readPage(&packet);
+
+	EXPECT_EQ(app.getGeneration(), 5678u);
+	EXPECT_EQ(app.size(), 1);
+	EXPECT_EQ(app.find("/input/thing0/value"), INVALID_INPUT_ID);
+}
+
+TEST(InputIdTableTest, RejectsNamesThatDoNotFitOnTheWire)
+{
+	InputIdTable table;
+	EXPECT_EQ(table.intern(std::string(INPUT_NAME_LENGTH, 'x')), INVALID_INPUT_ID);
+}
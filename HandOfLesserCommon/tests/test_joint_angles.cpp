@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include "src/math/joint_angles.h"
+
+using namespace HOL;
+
+static const float PI = std::numbers::pi_v<float>;
+
+// The euler versions these replaced, to compare against
+static float eulerCurl(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next)
+{
+	Eigen::Quaternionf localRot = previous.inverse() * next;
+	return localRot.toRotationMatrix().canonicalEulerAngles(0, 1, 2).x();
+}
+
+static float eulerSplay(const Eigen::Quaternionf& previous, const Eigen::Quaternionf& next)
+{
+	Eigen::Quaternionf localRot = previous.inverse() * next;
+	return localRot.toRotationMatrix().canonicalEulerAngles(2, 1, 0).y();
+}
+
+static float projectedHumanoidSplay(const Eigen::Quaternionf& palmOrientation,
+									const Eigen::Vector3f& knucklePosition,
+									const Eigen::Vector3f& tipPosition)
+{
+	Eigen::Vector3f tipLocal = palmOrientation.inverse() * (tipPosition - knucklePosition);
+	Eigen::Vector3f forwardProjected = tipLocal - Eigen::Vector3f::UnitX() * tipLocal.x();
+	forwardProjected.normalize();
+
+	float splay = acos(forwardProjected.dot(tipLocal) / tipLocal.norm());
+	return tipLocal.x() > 0 ? -splay : splay;
+}
+
+static Eigen::Quaternionf rotation(float x, float y, float z)
+{
+	return Eigen::Quaternionf(Eigen::AngleAxisf(x, Eigen::Vector3f::UnitX())
+							  * Eigen::AngleAxisf(y, Eigen::Vector3f::UnitY())
+							  * Eigen::AngleAxisf(z, Eigen::Vector3f::UnitZ()));
+}
+
+// Same angles, applied the other way around, which is what splay's ZYX expects
+static Eigen::Quaternionf rotationZYX(float x, float y, float z)
+{
+	return Eigen::Quaternionf(Eigen::AngleAxisf(z, Eigen::Vector3f::UnitZ())
+							  * Eigen::AngleAxisf(y, Eigen::Vector3f::UnitY())
+							  * Eigen::AngleAxisf(x, Eigen::Vector3f::UnitX()));
+}
+
+TEST(JointAnglesTest, RecoversPureRotations)
+{
+	for (int i = -99; i <= 99; i++)
+	{
+		float angle = PI * i / 100.f;
+		Eigen::Quaternionf previous = Eigen::Quaternionf::UnitRandom();
+
+		EXPECT_NEAR(computeJointCurl(previous, previous * rotation(angle, 0, 0)), angle, 1e-5f);
+		EXPECT_NEAR(computeJointCurl(previous, previous * rotation(0, angle, 0)), 0, 1e-5f);
+
+		// Splay only goes to +-90, past that it's a splay the other way and a half turn
+		if (std::abs(angle) < PI / 2)
+		{
+			Eigen::Quaternionf next = previous * rotation(0, angle, 0);
+			EXPECT_NEAR(computeJointSplay(previous, next), angle, 1e-5f);
+		}
+		EXPECT_NEAR(computeJointSplay(previous, previous * rotation(angle, 0, 0)), 0, 1e-5f);
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			Eigen::Vector3f angles = Eigen::Vector3f::Zero();
+			angles[axis] = angle;
+			EXPECT_NEAR(computeTwistAngle(rotation(angles.x(), angles.y(), angles.z()), axis),
+						angle,
+						1e-5f);
+		}
+	}
+}
+
+TEST(JointAnglesTest, MatchesEulerWhenBendingAboutTwoAxes)
+{
+	std::mt19937 random(5678);
+	std::uniform_real_distribution<float> curl(-PI + 0.01f, PI - 0.01f);
+	std::uniform_real_distribution<float> other(-PI / 2 + 0.01f, PI / 2 - 0.01f);
+
+	for (int i = 0; i < 10000; i++)
+	{
+		Eigen::Quaternionf previous = Eigen::Quaternionf::UnitRandom();
+		float x = curl(random);
+		float y = other(random);
+		float z = other(random);
+
+		Eigen::Quaternionf curlSplay = previous * rotation(x, y, 0);
+		Eigen::Quaternionf curlRoll = previous * rotation(x, 0, z);
+		EXPECT_NEAR(computeJointCurl(previous, curlSplay), eulerCurl(previous, curlSplay), 1e-4f);
+		EXPECT_NEAR(computeJointCurl(previous, curlRoll), eulerCurl(previous, curlRoll), 1e-4f);
+	}
+}
+
+TEST(JointAnglesTest, CloseToEulerOverFingerRange)
+{
+	// Further back than any finger curls, and then some for splay and roll
+	std::mt19937 random(9012);
+	std::uniform_real_distribution<float> curl(-1.8f, 0.6f);
+	std::uniform_real_distribution<float> splay(-0.3f, 0.3f);
+	std::uniform_real_distribution<float> roll(-0.3f, 0.3f);
+
+	float worstCurl = 0;
+	for (int i = 0; i < 10000; i++)
+	{
+		Eigen::Quaternionf previous = Eigen::Quaternionf::UnitRandom();
+		float x = curl(random);
+		float y = splay(random);
+		float z = roll(random);
+
+		Eigen::Quaternionf next = previous * rotation(x, y, z);
+		float difference = computeJointCurl(previous, next) - eulerCurl(previous, next);
+		worstCurl = std::max(worstCurl, std::abs(difference));
+
+		next = previous * rotationZYX(x, y, z);
+		EXPECT_NEAR(computeJointSplay(previous, next), eulerSplay(previous, next), 1e-5f);
+		EXPECT_NEAR(computeJointSplay(previous, next), y, 1e-5f);
+	}
+
+	// Second order in splay and roll, so about 0.3 * 0.3 / 2
+	EXPECT_LT(worstCurl, 0.05f);
+}
+
+TEST(JointAnglesTest, SplayMatchesEulerEverywhere)
+{
+	for (int i = 0; i < 10000; i++)
+	{
+		Eigen::Quaternionf previous = Eigen::Quaternionf::UnitRandom();
+		Eigen::Quaternionf next = Eigen::Quaternionf::UnitRandom();
+		EXPECT_NEAR(computeJointSplay(previous, next), eulerSplay(previous, next), 1e-5f);
+	}
+}
+
+TEST(JointAnglesTest, CurlSurvivesGimbalLock)
+{
+	// Euler X is meaningless once Y hits 90, twist doesn't care
+	Eigen::Quaternionf previous = Eigen::Quaternionf::Identity();
+	for (float curl : {-1.5f, -0.5f, 0.f, 0.7f, 2.f})
+	{
+		EXPECT_NEAR(computeJointCurl(previous, rotation(curl, PI / 2, 0)), curl, 1e-5f);
+		EXPECT_NEAR(computeJointCurl(previous, rotation(curl, -PI / 2, 0)), curl, 1e-5f);
+		EXPECT_NEAR(computeJointSplay(previous, rotationZYX(curl, PI / 2, 0)), PI / 2, 1e-3f);
+	}
+}
+
+TEST(JointAnglesTest, IgnoresSignAndScale)
+{
+	std::mt19937 random(3456);
+	std::uniform_real_distribution<float> scale(0.5f, 2.f);
+
+	for (int i = 0; i < 1000; i++)
+	{
+		Eigen::Quaternionf previous = Eigen::Quaternionf::UnitRandom();
+		Eigen::Quaternionf next = Eigen::Quaternionf::UnitRandom();
+		float curl = computeJointCurl(previous, next);
+		float splay = computeJointSplay(previous, next);
+
+		// Same rotations, other hemisphere and not normalized
+		Eigen::Quaternionf otherPrevious(-previous.coeffs() * scale(random));
+		Eigen::Quaternionf otherNext(next.coeffs() * scale(random));
+
+		// Half turns can come out as +-pi either way
+		float curlDifference = std::abs(computeJointCurl(otherPrevious, otherNext) - curl);
+		EXPECT_LT(std::min(curlDifference, 2 * PI - curlDifference), 1e-4f);
+		EXPECT_NEAR(computeJointSplay(otherPrevious, otherNext), splay, 1e-5f);
+	}
+}
+
+TEST(JointAnglesTest, HumanoidSplayMatchesProjection)
+{
+	std::mt19937 random(7890);
+	std::uniform_real_distribution<float> offset(-0.1f, 0.1f);
+
+	for (int i = 0; i < 10000; i++)
+	{
+		Eigen::Quaternionf palm = Eigen::Quaternionf::UnitRandom();
+		Eigen::Vector3f knuckle(offset(random), offset(random), offset(random));
+		Eigen::Vector3f tip(offset(random), offset(random), offset(random));
+
+		// acos loses a lot near 0, hence the loose tolerance. Just past 1 it even gives NaN.
+		float splay = computeJointHumanoidSplay(palm, knuckle, tip);
+		float projected = projectedHumanoidSplay(palm, knuckle, tip);
+		ASSERT_TRUE(std::isfinite(splay));
+		if (!std::isnan(projected))
+		{
+			EXPECT_NEAR(splay, projected, 1e-3f);
+		}
+	}
+
+	Eigen::Quaternionf identity = Eigen::Quaternionf::Identity();
+	Eigen::Vector3f knuckle = Eigen::Vector3f::Zero();
+	EXPECT_NEAR(computeJointHumanoidSplay(identity, knuckle, Eigen::Vector3f(1, 0, 1)),
+				-PI / 4,
+				1e-6f);
+	EXPECT_NEAR(computeJointHumanoidSplay(identity, knuckle, Eigen::Vector3f(-1, 1, 0)),
+				PI / 4,
+				1e-6f);
+	EXPECT_NEAR(
+		computeJointHumanoidSplay(identity, knuckle, Eigen::Vector3f(1e-4f, 0, 1)), -1e-4f, 1e-8f);
+}
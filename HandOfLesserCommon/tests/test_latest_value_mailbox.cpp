@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "src/util/latest_value_mailbox.h"
+
+using namespace HOL;
+
+struct MailboxTestValue
+{
+	uint64_t a = 0;
+	uint64_t padding[14];
+	uint64_t b = 0;
+};
+
+TEST(LatestValueMailboxTest, OnlyLatestValueIsConsumed)
+{
+	LatestValueMailbox<int> mailbox;
+	int value = -1;
+
+	EXPECT_FALSE(mailbox.consume(value));
+
+	mailbox.publish(1);
+	mailbox.publish(2);
+	mailbox.publish(3);
+
+	EXPECT_TRUE(mailbox.consume(value));
+	EXPECT_EQ(value, 3);
+	EXPECT_EQ(mailbox.droppedCount(), 2u);
+
+	EXPECT_FALSE(mailbox.consume(value));
+
+	mailbox.publish(4);
+	EXPECT_TRUE(mailbox.consume(value));
+	EXPECT_EQ(value, 4);
+}
+
+TEST(LatestValueMailboxTest, ConsumerNeverSeesTornValues)
+{
+	LatestValueMailbox<MailboxTestValue> mailbox;
+	const uint64_t count = 200000;
+
+	std::thread producer([&]() {
+		MailboxTestValue value;
+		for (uint64_t i = 1; i <= count; i++)
+		{
+			value.a = i;
+			value.b = i;
+			mailbox.publish(value);
+		}
+	});
+
+	MailboxTestValue value;
+	uint64_t last = 0;
+	while (last < count)
+	{
+		if (mailbox.consume(value))
+		{
+			ASSERT_EQ(value.a, value.b);
+			ASSERT_GT(value.a, last);
+			last = value.a;
+		}
+	}
+
+	producer.join();
+}
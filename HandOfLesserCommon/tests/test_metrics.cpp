@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "src/util/metrics.h"
+
+using namespace HOL;
+
+TEST(MetricsTest, BucketsCoverEveryValue)
+{
+	std::vector<int64_t> values = {0, 1, 15, 31, 32, 33, 1000, 999999, INT64_MAX};
+	for (int bit = 5; bit < 63; bit++)
+	{
+		values.push_back((1LL << bit) - 1);
+		values.push_back(1LL << bit);
+		values.push_back((1LL << bit) + 1);
+	}
+
+	for (int64_t value : values)
+	{
+		int bucket = LatencyHistogram::getBucket(value);
+		ASSERT_GE(bucket, 0);
+		ASSERT_LT(bucket, LATENCY_HISTOGRAM_BUCKETS);
+
+		// Within a sixteenth of the value, and never below it
+		int64_t upper = LatencyHistogram::getBucketUpperBound(bucket);
+		EXPECT_GE(upper, value);
+		EXPECT_LE((double)(upper - value), value / 16.0 + 1) << value;
+
+		if (bucket > 0)
+		{
+			EXPECT_LT(LatencyHistogram::getBucketUpperBound(bucket - 1), value) << value;
+		}
+	}
+
+	EXPECT_EQ(LatencyHistogram::getBucket(INT64_MAX), LATENCY_HISTOGRAM_BUCKETS - 1);
+	EXPECT_EQ(LatencyHistogram::getBucket(-5), 0);
+}
+
+TEST(MetricsTest, HistogramPercentiles)
+{
+	auto histogram = std::make_unique<LatencyHistogram>();
+	EXPECT_EQ(histogram->getPercentile(99), 0);
+
+	// 1 to 1000us
+	for (int64_t i = 1; i <= 1000; i++)
+	{
+		histogram->record(i * 1000);
+	}
+
+	LatencySummary summary = histogram->summarize();
+	EXPECT_EQ(summary.count, 1000u);
+	EXPECT_NEAR(summary.meanUS, 500.5f, 0.01f);
+	EXPECT_NEAR(summary.p50US, 500.f, 500.f / 16);
+	EXPECT_NEAR(summary.p90US, 900.f, 900.f / 16);
+	EXPECT_NEAR(summary.p99US, 990.f, 990.f / 16);
+	EXPECT_GE(summary.p99US, 990.f);
+	EXPECT_FLOAT_EQ(summary.maxUS, 1000.f);
+
+	// Never past the largest value actually recorded
+	EXPECT_LE(summary.p999US, summary.maxUS);
+	EXPECT_EQ(histogram->getPercentile(100), 1000000);
+
+	histogram->reset();
+	EXPECT_EQ(histogram->getCount(), 0u);
+	EXPECT_EQ(histogram->summarize().p99US, 0.f);
+}
+
+TEST(MetricsTest, ConcurrentRecording)
+{
+	auto histogram = std::make_unique<LatencyHistogram>();
+	MetricCounter counter;
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++)
+	{
+		threads.emplace_back([&, t] {
+			for (int i = 0; i < 10000; i++)
+			{
+				histogram->record(1000 * (t + 1));
+				counter.add();
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ(histogram->getCount(), 40000u);
+	EXPECT_EQ(counter.get(), 40000u);
+	EXPECT_FLOAT_EQ(histogram->summarize().maxUS, 4.f);
+}
+
+TEST(MetricsTest, RegistryLooksUpByName)
+{
+	auto registry = std::make_unique<MetricsRegistry>();
+
+	LatencyHistogram* frame = registry->getHistogram("frame_time");
+	EXPECT_EQ(registry->getHistogram("frame_time"), frame);
+	EXPECT_NE(registry->getHistogram("send_time"), frame);
+
+	// Separate namespaces per kind
+	MetricCounter* sent = registry->getCounter("frame_time");
+	MetricGauge* depth = registry->getGauge("queue_depth");
+
+	frame->record(2000);
+	sent->add(3);
+	depth->set(7);
+
+	auto snapshot = std::make_unique<MetricsSnapshot>();
+	registry->snapshot(*snapshot);
+	ASSERT_EQ(snapshot->histogramCount, 2u);
+	EXPECT_STREQ(snapshot->histograms[0].name, "frame_time");
+	EXPECT_EQ(snapshot->histograms[0].summary.count, 1u);
+	ASSERT_EQ(snapshot->counterCount, 1u);
+	EXPECT_EQ(snapshot->counters[0].value, 3);
+	ASSERT_EQ(snapshot->gaugeCount, 1u);
+	EXPECT_EQ(snapshot->gauges[0].value, 7);
+
+	// Gauges are left alone
+	registry->reset();
+	registry->snapshot(*snapshot);
+	EXPECT_EQ(snapshot->histograms[0].summary.count, 0u);
+	EXPECT_EQ(snapshot->counters[0].value, 0);
+	EXPECT_EQ(snapshot->gauges[0].value, 7);
+}
+
+TEST(MetricsTest, FullRegistryHandsOutSpare)
+{
+	auto registry = std::make_unique<MetricsRegistry>();
+
+	for (int i = 0; i < METRICS_MAX_COUNTERS; i++)
+	{
+		registry->getCounter(("counter_" + std::to_string(i)).c_str());
+	}
+
+	MetricCounter* spare = registry->getCounter("one_too_many");
+	ASSERT_NE(spare, nullptr);
+	spare->add();
+	EXPECT_EQ(registry->getCounter("another"), spare);
+
+	auto snapshot = std::make_unique<MetricsSnapshot>();
+	registry->snapshot(*snapshot);
+	EXPECT_EQ(snapshot->counterCount, (uint32_t)METRICS_MAX_COUNTERS);
+}
+
+TEST(MetricsTest, FormatsOneLinePerMetric)
+{
+	auto registry = std::make_unique<MetricsRegistry>();
+	registry->getHistogram("frame_time")->record(1500);
+	registry->getCounter("packets_sent")->add(12);
+	registry->getGauge("receive_batch")->set(-1);
+
+	auto snapshot = std::make_unique<MetricsSnapshot>();
+	registry->snapshot(*snapshot);
+
+	std::string text;
+	formatMetrics("app", *snapshot, text);
+	formatMetrics("driver", *snapshot, text);
+
+	EXPECT_EQ(text.rfind("# app\nhistogram frame_time count=1 mean_us=1.50", 0), 0u);
+	EXPECT_NE(text.find("max_us=1.50\ncounter packets_sent 12\ngauge receive_batch -1\n# driver\n"),
+			  std::string::npos);
+}
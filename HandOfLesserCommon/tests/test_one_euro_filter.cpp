@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include "src/math/one_euro_filter.h"
+
+using namespace HOL;
+
+// Roughly what hand tracking updates at
+static const float FILTER_DELTA_TIME = 1.f / 90.f;
+
+static float filterRamp(float beta)
+{
+	OneEuroParameters parameters;
+	parameters.minCutoffHz = 1.f;
+	parameters.beta = beta;
+
+	float filtered = 0;
+	float speed = 0;
+	float value = 0;
+
+	// 1 m/s for a second, then see how far behind we are
+	for (int i = 1; i <= 90; i++)
+	{
+		value = i * FILTER_DELTA_TIME;
+		float output = value;
+		filterOneEuro(&output, &filtered, &speed, 1, FILTER_DELTA_TIME, parameters);
+	}
+
+	return value - filtered;
+}
+
+TEST(OneEuroFilterTest, AlphaIsFirstOrderLowPass)
+{
+	// Small steps, alpha ~= 2pi * cutoff * dt
+	EXPECT_NEAR(computeOneEuroAlpha(1.f, 1e-4f), 2 * std::numbers::pi_v<float> * 1e-4f, 1e-6f);
+	EXPECT_NEAR(computeOneEuroAlpha(1e6f, FILTER_DELTA_TIME), 1.f, 1e-4f);
+	EXPECT_EQ(computeOneEuroAlpha(0.f, FILTER_DELTA_TIME), 0.f);
+}
+
+TEST(OneEuroFilterTest, SmoothsNoiseWhenStill)
+{
+	OneEuroParameters parameters;
+	parameters.minCutoffHz = 1.f;
+	parameters.beta = 1.f;
+
+	std::mt19937 random(1234);
+	std::normal_distribution<float> noise(0.f, 0.001f); // A millimetre
+
+	float filtered[4] = {};
+	float speeds[4] = {};
+	double inputSquares = 0;
+	double outputSquares = 0;
+
+	for (int i = 0; i < 900; i++)
+	{
+		float values[4] = {noise(random), noise(random), noise(random), noise(random)};
+		inputSquares += values[0] * values[0];
+
+		filterOneEuro(values, filtered, speeds, 4, FILTER_DELTA_TIME, parameters);
+		outputSquares += values[0] * values[0];
+		EXPECT_EQ(values[3], filtered[3]);
+	}
+
+	EXPECT_LT(outputSquares, inputSquares * 0.1);
+}
+
+TEST(OneEuroFilterTest, BetaCutsLagWhenMoving)
+{
+	float lag = filterRamp(0.f);
+	float adaptiveLag = filterRamp(20.f);
+
+	// A plain 1Hz low-pass trails a ramp by about 1 / (2pi) seconds
+	EXPECT_NEAR(lag, 1.f / (2 * std::numbers::pi_v<float>), 0.02f);
+	EXPECT_LT(adaptiveLag, lag * 0.2f);
+	EXPECT_GT(adaptiveLag, 0.f);
+}
+
+TEST(OneEuroFilterTest, HandJointsSeedThenSmooth)
+{
+	OneEuroParameters parameters;
+	parameters.minCutoffHz = 1.f;
+
+	HandJoints joints;
+	Eigen::Quaternionf orientation(Eigen::AngleAxisf(0.5f, Eigen::Vector3f::UnitY()));
+	for (int i = 0; i < HAND_JOINT_COUNT; i++)
+	{
+		joints.setJoint(i, Eigen::Vector3f(0, 0, 0), orientation, 0.01f, true, true);
+	}
+
+	HandJointFilter filter;
+	filter.filter(joints, FILTER_DELTA_TIME, parameters, parameters);
+	EXPECT_TRUE(joints.position(3).isZero());
+
+	// Jump 10cm and get a fraction of the way there
+	HandJoints moved = joints;
+	moved.setJoint(3, Eigen::Vector3f(0.1f, 0, 0), orientation, 0.01f, true, true);
+	filter.filter(moved, FILTER_DELTA_TIME, parameters, parameters);
+	EXPECT_GT(moved.position(3).x(), 0.f);
+	EXPECT_LT(moved.position(3).x(), 0.1f);
+	EXPECT_TRUE(moved.position(4).isZero());
+
+	// Nothing new this frame, same output again
+	HandJoints repeated = joints;
+	filter.repeat(repeated);
+	EXPECT_EQ(repeated.position(3).x(), moved.position(3).x());
+}
+
+TEST(OneEuroFilterTest, HandJointOrientationsStayUnitAcrossHemispheres)
+{
+	OneEuroParameters parameters;
+	parameters.minCutoffHz = 1.f;
+	parameters.beta = 1.f;
+
+	std::mt19937 random(5678);
+	std::uniform_real_distribution<float> angle(-0.05f, 0.05f);
+	Eigen::Quaternionf base(Eigen::AngleAxisf(1.f, Eigen::Vector3f(1, 1, 0).normalized()));
+
+	HandJointFilter filter;
+	for (int frame = 0; frame < 200; frame++)
+	{
+		HandJoints joints;
+		for (int i = 0; i < HAND_JOINT_COUNT; i++)
+		{
+			Eigen::Quaternionf sample
+				= base * Eigen::AngleAxisf(angle(random), Eigen::Vector3f::UnitZ());
+
+			// Runtimes are free to hand out either sign
+			if ((frame + i) % 2)
+			{
+				sample.coeffs() = -sample.coeffs();
+			}
+			joints.setJoint(i, Eigen::Vector3f::Zero(), sample, 0.01f, true, true);
+		}
+
+		filter.filter(joints, FILTER_DELTA_TIME, parameters, parameters);
+
+		for (int i = 0; i < HAND_JOINT_COUNT; i++)
+		{
+			EXPECT_NEAR(joints.orientation(i).norm(), 1.f, 1e-5f);
+			EXPECT_LT(joints.orientation(i).angularDistance(base), 0.06f);
+		}
+	}
+}
+
+TEST(OneEuroFilterTest, InvalidJointsHoldStill)
+{
+	OneEuroParameters parameters;
+	parameters.minCutoffHz = 5.f;
+
+	HandJoints joints;
+	Eigen::Quaternionf orientation = Eigen::Quaternionf::Identity();
+	joints.setJoint(5, Eigen::Vector3f(0.1f, 0.2f, 0.3f), orientation, 0.01f, true, true);
+
+	HandJointFilter filter;
+	filter.filter(joints, FILTER_DELTA_TIME, parameters, parameters);
+
+	// What runtimes tend to leave behind when they lose a joint
+	joints.setJoint(5, Eigen::Vector3f::Zero(), Eigen::Quaternionf(0, 0, 0, 0), 0, false, false);
+	filter.filter(joints, FILTER_DELTA_TIME, parameters, parameters);
+
+	EXPECT_TRUE(joints.position(5).isApprox(Eigen::Vector3f(0.1f, 0.2f, 0.3f)));
+	EXPECT_TRUE(joints.orientation(5).isApprox(orientation));
+}
+
+TEST(OneEuroFilterTest, PoseVelocityFollowsSteadyMotion)
+{
+	OneEuroParameters position;
+	position.minCutoffHz = 1.f;
+	position.beta = 10.f;
+	OneEuroParameters rotation;
+	rotation.minCutoffHz = 1.f;
+	rotation.beta = 1.f;
+
+	Eigen::Vector3f linearVelocity(0.5f, -0.2f, 0.1f);
+	Eigen::Vector3f angularVelocity(0.f, 2.f, 0.5f);
+
+	PoseFilter filter;
+	PoseLocation filtered;
+	PoseLocation pose;
+	for (int i = 0; i < 180; i++)
+	{
+		float time = i * FILTER_DELTA_TIME;
+		pose.position = linearVelocity * time;
+		pose.orientation = Eigen::AngleAxisf(angularVelocity.norm() * time,
+											 angularVelocity.normalized());
+
+		filtered = filter.filter(pose, FILTER_DELTA_TIME, position, rotation);
+	}
+
+	EXPECT_TRUE(filter.getVelocity().linearVelocity.isApprox(linearVelocity, 0.01f));
+	EXPECT_TRUE(filter.getVelocity().angularVelocity.isApprox(angularVelocity, 0.01f));
+
+	// Trails by speed / (2pi * cutoff), the same as any first order low-pass at that cutoff
+	const float pi = std::numbers::pi_v<float>;
+	float speed = linearVelocity.norm();
+	float angularSpeed = angularVelocity.norm();
+	EXPECT_NEAR((filtered.position - pose.position).norm(),
+				speed / (2 * pi * (position.minCutoffHz + position.beta * speed)),
+				1e-4f);
+	EXPECT_NEAR(filtered.orientation.angularDistance(pose.orientation),
+				angularSpeed / (2 * pi * (rotation.minCutoffHz + rotation.beta * angularSpeed)),
+				1e-3f);
+	EXPECT_NEAR(filtered.orientation.norm(), 1.f, 1e-5f);
+}
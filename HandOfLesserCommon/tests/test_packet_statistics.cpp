@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "src/packet/packet_statistics.h"
+#include "src/packet/pose_codec.h"
+
+using namespace HOL;
+
+static bool recordPose(PacketStatistics& statistics, uint32_t sequence, int64_t latencyUs = 0)
+{
+	HandTransformPacket packet;
+	packet.sequence = sequence;
+	packet.sendTime = 1000000;
+	return statistics.record(&packet, packet.sendTime + latencyUs * 1000);
+}
+
+TEST(PacketStatisticsTest, CountsGapsAsLoss)
+{
+	auto statistics = std::make_unique<PacketStatistics>();
+
+	EXPECT_TRUE(recordPose(*statistics, 1));
+	EXPECT_TRUE(recordPose(*statistics, 2));
+	EXPECT_TRUE(recordPose(*statistics, 5));
+
+	PacketTypeStatistics stats[PACKET_STATISTICS_MAX_TYPES];
+	ASSERT_EQ(statistics->snapshot(stats, PACKET_STATISTICS_MAX_TYPES), 1u);
+	EXPECT_EQ(stats[0].packetType, NativePacketType::HandTransform);
+	EXPECT_EQ(stats[0].received, 3u);
+	EXPECT_EQ(stats[0].lost, 2u);
+	EXPECT_EQ(stats[0].reordered, 0u);
+	EXPECT_FLOAT_EQ(stats[0].lossRate, 0.4f);
+}
+
+TEST(PacketStatisticsTest, LatePacketIsReorderedNotLost)
+{
+	auto statistics = std::make_unique<PacketStatistics>();
+
+	recordPose(*statistics, 1);
+	recordPose(*statistics, 3);
+	EXPECT_FALSE(recordPose(*statistics, 2));
+
+	PacketTypeStatistics stats[PACKET_STATISTICS_MAX_TYPES];
+	statistics->snapshot(stats, PACKET_STATISTICS_MAX_TYPES);
+	EXPECT_EQ(stats[0].received, 3u);
+	EXPECT_EQ(stats[0].lost, 0u);
+	EXPECT_EQ(stats[0].reordered, 1u);
+}
+
+TEST(PacketStatisticsTest, MixedPoseEncodingsShareASequence)
+{
+	auto statistics = std::make_unique<PacketStatistics>();
+
+	recordPose(*statistics, 1);
+
+	CompactHandTransformPacket compact;
+	compact.sequence = 2;
+	EXPECT_TRUE(statistics->record(&compact, 0));
+
+	recordPose(*statistics, 3);
+
+	PacketTypeStatistics stats[PACKET_STATISTICS_MAX_TYPES];
+	ASSERT_EQ(statistics->snapshot(stats, PACKET_STATISTICS_MAX_TYPES), 1u);
+	EXPECT_EQ(stats[0].packetType, NativePacketType::HandTransform);
+	EXPECT_EQ(stats[0].received, 3u);
+	EXPECT_EQ(stats[0].lost, 0u);
+}
+
+TEST(PacketStatisticsTest, SequenceWrapsAndSenderRestarts)
+{
+	EXPECT_TRUE(isNewerSequence(0, 0xFFFFFFFF));
+	EXPECT_TRUE(isNewerSequence(3, 0xFFFFFFFE));
+	EXPECT_FALSE(isNewerSequence(0xFFFFFFFE, 3));
+	EXPECT_FALSE(isNewerSequence(5, 5));
+	EXPECT_FALSE(isNewerSequence(4, 5));
+
+	// Way behind, sender must have started over
+	EXPECT_TRUE(isNewerSequence(1, 50000));
+}
+
+TEST(PacketStatisticsTest, LatencyPercentiles)
+{
+	auto statistics = std::make_unique<PacketStatistics>();
+
+	for (uint32_t i = 1; i <= 100; i++)
+	{
+		recordPose(*statistics, i, i);
+	}
+
+	PacketTypeStatistics stats[PACKET_STATISTICS_MAX_TYPES];
+	statistics->snapshot(stats, PACKET_STATISTICS_MAX_TYPES);
+	EXPECT_NEAR(stats[0].latencyP50, 51.f, 1.f);
+	EXPECT_NEAR(stats[0].latencyP99, 100.f, 1.f);
+
+	statistics->reset();
+	statistics->snapshot(stats, PACKET_STATISTICS_MAX_TYPES);
+	EXPECT_EQ(stats[0].lost, 0u);
+	EXPECT_EQ(stats[0].latencyP50, 0.f);
+
+	// Picks up where it left off instead of treating the next one as reordered
+	EXPECT_TRUE(recordPose(*statistics, 101));
+}
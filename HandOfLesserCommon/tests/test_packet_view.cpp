@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include "src/packet/packet_table.h"
+
+using namespace HOL;
+
+static ReceivedPacket receiveInto(PacketSlotPool& pool, const void* data, size_t length)
+{
+	char* slot = pool.acquire();
+	std::memcpy(slot, data, length);
+	return ReceivedPacket{(NativePacket*)slot, length, &pool};
+}
+
+TEST(PacketViewTest, RejectsWrongTypeTruncatedAndWrongVersion)
+{
+	PacketSlotPool pool;
+	pool.init(4, 4096);
+
+	HandTransformPacket pose;
+	ReceivedPacket received = receiveInto(pool, &pose, sizeof(pose));
+
+	EXPECT_TRUE(PacketView<HandTransformPacket>(received));
+	EXPECT_FALSE(PacketView<SettingsPacket>(received));
+
+	received.length = sizeof(HandTransformPacket) - 1;
+	EXPECT_FALSE(PacketView<HandTransformPacket>(received));
+
+	received.length = sizeof(HandTransformPacket);
+	received.packet->version = NATIVE_PACKET_VERSION + 1;
+	EXPECT_FALSE(PacketView<HandTransformPacket>(received));
+
+	pool.release(received.packet);
+	EXPECT_EQ(pool.getAvailableCount(), 4u);
+}
+
+TEST(PacketViewTest, ViewKeepsSlotUntilReleased)
+{
+	PacketSlotPool pool;
+	pool.init(2, 4096);
+
+	HandTransformPacket pose;
+	pose.side = HandSide::RightHand;
+	ReceivedPacket received = receiveInto(pool, &pose, sizeof(pose));
+
+	PacketView<HandTransformPacket> view(received);
+	PacketView<HandTransformPacket> copy = view;
+
+	// Receiver is done with the batch, views still hold it
+	pool.release(received.packet);
+	EXPECT_EQ(pool.getAvailableCount(), 1u);
+	EXPECT_EQ(copy->side, HandSide::RightHand);
+
+	view.release();
+	EXPECT_EQ(pool.getAvailableCount(), 1u);
+
+	PacketView<HandTransformPacket> moved = std::move(copy);
+	EXPECT_FALSE(copy);
+	moved = PacketView<HandTransformPacket>();
+	EXPECT_EQ(pool.getAvailableCount(), 2u);
+}
+
+TEST(PacketViewTest, TableDispatchesByType)
+{
+	PacketSlotPool pool;
+	pool.init(4, 4096);
+
+	BoolInputIdPacket input;
+	input.inputId = 12;
+	ReceivedPacket received = receiveInto(pool, &input, sizeof(input));
+
+	int inputId = -1;
+	bool handled = NativePacketTable::dispatch(received, [&](auto packet) {
+		if constexpr (std::is_same_v<decltype(packet), PacketView<BoolInputIdPacket>>)
+		{
+			inputId = packet->inputId;
+		}
+	});
+
+	EXPECT_TRUE(handled);
+	EXPECT_EQ(inputId, 12);
+
+	// Garbage type
+	received.packet->packetType = (NativePacketType)12345;
+	EXPECT_FALSE(NativePacketTable::dispatch(received, [](auto) {}));
+
+	pool.release(received.packet);
+	EXPECT_EQ(pool.getAvailableCount(), 4u);
+}
+
+TEST(PacketViewTest, BundleEntriesShareBundleSlot)
+{
+	PacketSlotPool pool;
+	pool.init(2, 4096);
+
+	FrameBundleWriter writer;
+	writer.reset();
+	HandTransformPacket pose;
+	writer.add(pose);
+
+	ReceivedPacket received = receiveInto(pool, writer.getBuffer(), writer.size());
+	PacketView<FrameBundleHeader> bundle(received);
+	ASSERT_TRUE(bundle);
+	pool.release(received.packet);
+
+	FrameBundleReader reader(bundle.getReceived());
+	ReceivedPacket entry;
+	ASSERT_TRUE(reader.next(entry));
+	EXPECT_EQ(entry.length, sizeof(HandTransformPacket));
+
+	PacketView<HandTransformPacket> poseView(entry);
+	ASSERT_TRUE(poseView);
+	bundle.release();
+
+	// Slot outlives the bundle view because the pose still points into it
+	EXPECT_EQ(pool.getAvailableCount(), 1u);
+	poseView.release();
+	EXPECT_EQ(pool.getAvailableCount(), 2u);
+	EXPECT_FALSE(reader.next(entry));
+}
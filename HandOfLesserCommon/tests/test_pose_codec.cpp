@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "src/packet/pose_codec.h"
+
+using namespace HOL;
+
+static HandTransformPacket makePose(HandSide side, Eigen::Vector3f position)
+{
+	HandTransformPacket pose;
+	pose.active = true;
+	pose.valid = true;
+	pose.side = side;
+	pose.location.position = position;
+	pose.location.orientation = Eigen::Quaternionf(0.9f, 0.1f, -0.3f, 0.2f).normalized();
+	pose.velocity.linearVelocity = Eigen::Vector3f(0.5f, -1.25f, 0.f);
+	pose.velocity.angularVelocity = Eigen::Vector3f(3.f, 0.f, -2.f);
+	return pose;
+}
+
+TEST(PoseCodecTest, OrientationRoundTrip)
+{
+	std::mt19937 random(1234);
+	std::normal_distribution<float> normal;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		Eigen::Quaternionf orientation(normal(random), normal(random), normal(random), normal(random));
+		orientation.normalize();
+
+		int16_t encoded[3];
+		uint8_t largestIndex = 0;
+		encodeOrientation(orientation, encoded, largestIndex);
+		Eigen::Quaternionf decoded = decodeOrientation(encoded, largestIndex);
+
+		// Well under a tenth of a degree
+		EXPECT_LT(orientation.angularDistance(decoded), 0.0015f);
+	}
+}
+
+TEST(PoseCodecTest, KeyframeThenDeltaAfterAck)
+{
+	PoseEncoder encoder;
+	PoseDecoder decoder;
+	CompactHandTransformPacket packet;
+	HandTransformPacket decoded;
+
+	HandTransformPacket pose = makePose(HandSide::RightHand, Eigen::Vector3f(1.2345f, 1.5f, -0.75f));
+
+	packet.sequence = 1;
+	ASSERT_TRUE(encoder.encode(pose, packet));
+	EXPECT_FALSE(packet.flags & CompactPoseDelta);
+	ASSERT_TRUE(decoder.decode(packet, decoded));
+
+	EXPECT_EQ(decoded.side, HandSide::RightHand);
+	EXPECT_TRUE(decoded.active);
+	EXPECT_TRUE(decoded.valid);
+	EXPECT_FALSE(decoded.stale);
+	EXPECT_LT((decoded.location.position - pose.location.position).norm(), 0.0005f);
+	EXPECT_LT((decoded.velocity.linearVelocity - pose.velocity.linearVelocity).norm(), 0.002f);
+	EXPECT_LT((decoded.velocity.angularVelocity - pose.velocity.angularVelocity).norm(), 0.002f);
+
+	encoder.acknowledge(HandSide::RightHand, 1);
+
+	pose.location.position += Eigen::Vector3f(0.01f, 0.f, 0.001f);
+	packet.sequence = 2;
+	ASSERT_TRUE(encoder.encode(pose, packet));
+	EXPECT_TRUE(packet.flags & CompactPoseDelta);
+	EXPECT_EQ(packet.baseOffset, 1);
+	ASSERT_TRUE(decoder.decode(packet, decoded));
+
+	// Deltas are finer than keyframes, but are relative to the quantized keyframe
+	EXPECT_LT((decoded.location.position - pose.location.position).norm(), 0.0005f);
+}
+
+TEST(PoseCodecTest, DeltaAgainstUnknownFrameFails)
+{
+	PoseEncoder encoder;
+	PoseDecoder decoder;
+	CompactHandTransformPacket packet;
+	HandTransformPacket decoded;
+
+	HandTransformPacket pose = makePose(HandSide::LeftHand, Eigen::Vector3f(0.f, 1.f, 0.f));
+
+	packet.sequence = 10;
+	encoder.encode(pose, packet);
+	encoder.acknowledge(HandSide::LeftHand, 10);
+
+	packet.sequence = 11;
+	encoder.encode(pose, packet);
+	ASSERT_TRUE(packet.flags & CompactPoseDelta);
+
+	// Never saw frame 10
+	EXPECT_FALSE(decoder.decode(packet, decoded));
+
+	// Driver asks for a keyframe
+	encoder.acknowledge(HandSide::LeftHand, 0);
+	packet.sequence = 12;
+	encoder.encode(pose, packet);
+	EXPECT_FALSE(packet.flags & CompactPoseDelta);
+	EXPECT_TRUE(decoder.decode(packet, decoded));
+}
+
+TEST(PoseCodecTest, FallsBackWhenOutOfRange)
+{
+	PoseEncoder encoder;
+	CompactHandTransformPacket packet;
+
+	// Too old to delta against
+	HandTransformPacket pose = makePose(HandSide::LeftHand, Eigen::Vector3f(0.f, 1.f, 0.f));
+	packet.sequence = 1;
+	encoder.encode(pose, packet);
+	encoder.acknowledge(HandSide::LeftHand, 1);
+	packet.sequence = 1 + POSE_HISTORY_SIZE;
+	ASSERT_TRUE(encoder.encode(pose, packet));
+	EXPECT_FALSE(packet.flags & CompactPoseDelta);
+
+	// Too far from the origin for a keyframe, send the full packet instead
+	HandTransformPacket far = makePose(HandSide::LeftHand, Eigen::Vector3f(20.f, 0.f, 0.f));
+	packet.sequence++;
+	EXPECT_FALSE(encoder.encode(far, packet));
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "src/recording/recording_file.h"
+
+using namespace HOL;
+
+struct RecordingTestRecord
+{
+	uint32_t index;
+	float value;
+	uint8_t odd[5]; // Not a multiple of 8, stride has to pad it
+};
+
+static std::string recordingTestPath(const char* name)
+{
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static void writeTestRecording(const std::string& path, uint32_t count, uint32_t perChunk)
+{
+	RecordingWriter writer;
+	ASSERT_TRUE(writer.open(path, 42, sizeof(RecordingTestRecord), perChunk));
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		RecordingTestRecord record = {i, i * 0.5f, {1, 2, 3, 4, (uint8_t)i}};
+		writer.append(&record, 1000 + i * 10);
+	}
+
+	EXPECT_EQ(writer.getRecordCount(), count);
+	writer.close();
+	EXPECT_FALSE(writer.isOpen());
+}
+
+TEST(RecordingFileTest, RoundTrip)
+{
+	std::string path = recordingTestPath("hol_recording_roundtrip.holr");
+	writeTestRecording(path, 1000, 64);
+
+	RecordingReader reader;
+	ASSERT_TRUE(reader.open(path));
+	EXPECT_FALSE(reader.wasRecovered());
+	EXPECT_EQ(reader.getHeader().recordType, 42u);
+	EXPECT_EQ(reader.getHeader().recordSize, sizeof(RecordingTestRecord));
+	EXPECT_EQ(reader.getHeader().recordStride % 8, 0u);
+	ASSERT_EQ(reader.getRecordCount(), 1000u);
+
+	for (uint32_t i = 0; i < 1000; i++)
+	{
+		RecordingTestRecord record;
+		memcpy(&record, reader.getRecord(i), sizeof(RecordingTestRecord));
+		EXPECT_EQ(record.index, i);
+		EXPECT_EQ(record.value, i * 0.5f);
+		EXPECT_EQ(record.odd[4], (uint8_t)i);
+		EXPECT_EQ(reader.getTimestamp(i), 1000 + i * 10);
+	}
+
+	reader.close();
+	std::remove(path.c_str());
+}
+
+TEST(RecordingFileTest, FindRecord)
+{
+	std::string path = recordingTestPath("hol_recording_find.holr");
+	writeTestRecording(path, 300, 32);
+
+	RecordingReader reader;
+	ASSERT_TRUE(reader.open(path));
+
+	EXPECT_EQ(reader.findRecord(0), 0u);
+	EXPECT_EQ(reader.findRecord(1000), 0u);
+	EXPECT_EQ(reader.findRecord(1009), 0u);
+	EXPECT_EQ(reader.findRecord(1010), 1u);
+
+	// Either side of a chunk boundary
+	EXPECT_EQ(reader.findRecord(1000 + 31 * 10 + 5), 31u);
+	EXPECT_EQ(reader.findRecord(1000 + 32 * 10), 32u);
+
+	EXPECT_EQ(reader.findRecord(1000 + 299 * 10), 299u);
+	EXPECT_EQ(reader.findRecord(1000000), 299u);
+
+	reader.close();
+	std::remove(path.c_str());
+}
+
+TEST(RecordingFileTest, RecoversWithoutIndex)
+{
+	std::string path = recordingTestPath("hol_recording_recover.holr");
+	writeTestRecording(path, 100, 16);
+
+	// Lose the index and footer, and half of the last whole chunk, like a crash would
+	uint64_t size = std::filesystem::file_size(path);
+	uint64_t index = 7 * sizeof(RecordingIndexEntry) + sizeof(RecordingFooter);
+	std::filesystem::resize_file(path, size - index - 40);
+
+	RecordingReader reader;
+	ASSERT_TRUE(reader.open(path));
+	EXPECT_TRUE(reader.wasRecovered());
+
+	// 6 full chunks of 16, the last 4 records were in the chunk we cut
+	ASSERT_EQ(reader.getRecordCount(), 96u);
+
+	RecordingTestRecord record;
+	memcpy(&record, reader.getRecord(95), sizeof(RecordingTestRecord));
+	EXPECT_EQ(record.index, 95u);
+	EXPECT_EQ(reader.findRecord(1000000), 95u);
+
+	reader.close();
+	std::remove(path.c_str());
+}
+
+TEST(RecordingFileTest, RejectsOtherFiles)
+{
+	std::string path = recordingTestPath("hol_recording_garbage.holr");
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << std::string(512, 'x');
+	}
+
+	RecordingReader reader;
+	EXPECT_FALSE(reader.open(path));
+	EXPECT_FALSE(reader.isOpen());
+	EXPECT_FALSE(reader.open(recordingTestPath("hol_recording_missing.holr")));
+
+	std::remove(path.c_str());
+}
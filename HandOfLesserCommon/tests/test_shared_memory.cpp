@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include "src/transport/sharedmemorytransport.h"
+#include "src/transport/transport.h"
+
+using namespace HOL;
+
+#ifdef _WIN32
+static const char* TEST_SHARED_MEMORY_NAME = "Local\\HandOfLesserTest";
+#else
+static const char* TEST_SHARED_MEMORY_NAME = "/HandOfLesserTest";
+#endif
+
+// Well away from the 9000-9006 range the real thing uses, and from test_transport's
+static const int TEST_UDP_PORT = 19130;
+
+TEST(SharedMemoryTransportTest, ConsumerOnlySeesLatestPose)
+{
+	SharedMemoryTransport consumer;
+	SharedMemoryTransport producer;
+	ASSERT_TRUE(consumer.init(false, TEST_SHARED_MEMORY_NAME));
+	ASSERT_TRUE(producer.init(true, TEST_SHARED_MEMORY_NAME));
+
+	EXPECT_TRUE(consumer.isProducerConnected());
+
+	HandTransformPacket pose;
+	EXPECT_FALSE(consumer.receivePose(HandSide::LeftHand, &pose));
+
+	HandTransformPacket sent;
+	sent.side = HandSide::LeftHand;
+	for (int i = 0; i < 10; i++)
+	{
+		sent.location.position = Eigen::Vector3f((float)i, 0, 0);
+		producer.publishPose(&sent);
+	}
+
+	EXPECT_TRUE(consumer.wait(0));
+	ASSERT_TRUE(consumer.receivePose(HandSide::LeftHand, &pose));
+	EXPECT_FLOAT_EQ(pose.location.position.x(), 9.0f);
+
+	// Consumed, nothing new until the next publish
+	EXPECT_FALSE(consumer.receivePose(HandSide::LeftHand, &pose));
+	EXPECT_FALSE(consumer.receivePose(HandSide::RightHand, &pose));
+
+	producer.close();
+	EXPECT_FALSE(consumer.isProducerConnected());
+}
+
+TEST(SharedMemoryTransportTest, RingPreservesOrderAcrossWrap)
+{
+	SharedMemoryTransport consumer;
+	SharedMemoryTransport producer;
+	ASSERT_TRUE(consumer.init(false, TEST_SHARED_MEMORY_NAME));
+	ASSERT_TRUE(producer.init(true, TEST_SHARED_MEMORY_NAME));
+
+	// Odd size so records don't line up with the end of the ring
+	char record[1000];
+	char received[2048];
+
+	for (int i = 0; i < 500; i++)
+	{
+		std::memset(record, i & 0xFF, sizeof(record));
+		ASSERT_TRUE(producer.send(record, sizeof(record) - (i % 7)));
+
+		ASSERT_EQ(consumer.receive(received, sizeof(received)), sizeof(record) - (i % 7));
+		EXPECT_EQ((unsigned char)received[0], (unsigned char)(i & 0xFF));
+	}
+
+	EXPECT_EQ(consumer.receive(received, sizeof(received)), 0u);
+}
+
+TEST(SharedMemoryTransportTest, SendFailsWhenFull)
+{
+	SharedMemoryTransport consumer;
+	SharedMemoryTransport producer;
+	ASSERT_TRUE(consumer.init(false, TEST_SHARED_MEMORY_NAME));
+	ASSERT_TRUE(producer.init(true, TEST_SHARED_MEMORY_NAME));
+
+	char record[4000] = {};
+	int sent = 0;
+	while (producer.send(record, sizeof(record)))
+	{
+		sent++;
+		ASSERT_LT(sent, 1000);
+	}
+
+	EXPECT_GT(sent, 0);
+
+	char received[4096];
+	int receivedCount = 0;
+	while (consumer.receive(received, sizeof(received)) != 0)
+	{
+		receivedCount++;
+	}
+
+	EXPECT_EQ(sent, receivedCount);
+	EXPECT_TRUE(producer.send(record, sizeof(record)));
+}
+
+TEST(SharedMemoryTransportTest, WaitWakesUpForOtherHandle)
+{
+	SharedMemoryTransport consumer;
+	SharedMemoryTransport producer;
+	ASSERT_TRUE(consumer.init(false, TEST_SHARED_MEMORY_NAME));
+	ASSERT_TRUE(producer.init(true, TEST_SHARED_MEMORY_NAME));
+
+	Transport udp;
+	udp.init(TEST_UDP_PORT);
+
+	char datagram[64] = {};
+	ASSERT_TRUE(udp.send(TEST_UDP_PORT, datagram, sizeof(datagram)));
+
+	// Nothing on shared memory, but the socket shouldn't have to wait out the timeout
+	auto start = std::chrono::steady_clock::now();
+	EXPECT_TRUE(consumer.wait(2000, udp.getReadHandle()));
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+
+	udp.cancel();
+}
+
+TEST(SharedMemoryTransportTest, ProducerWakesRestartedConsumer)
+{
+	SharedMemoryTransport consumer;
+	SharedMemoryTransport producer;
+	ASSERT_TRUE(consumer.init(false, TEST_SHARED_MEMORY_NAME));
+	ASSERT_TRUE(producer.init(true, TEST_SHARED_MEMORY_NAME));
+
+	HandTransformPacket sent;
+	sent.side = HandSide::LeftHand;
+	producer.publishPose(&sent);
+
+	// Driver restarting while the app keeps running
+	consumer.close();
+#ifndef _WIN32
+	EXPECT_FALSE(std::filesystem::exists("/tmp/HandOfLesserTestWake"));
+#endif
+	ASSERT_TRUE(consumer.init(false, TEST_SHARED_MEMORY_NAME));
+
+	std::thread publisher([&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		producer.publishPose(&sent);
+	});
+
+	auto start = std::chrono::steady_clock::now();
+	EXPECT_TRUE(consumer.wait(2000));
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+
+	publisher.join();
+}
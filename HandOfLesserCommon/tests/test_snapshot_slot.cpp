@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "src/util/snapshot_slot.h"
+
+using namespace HOL;
+
+struct SnapshotTestValue
+{
+	uint64_t a = 0;
+	uint64_t padding[30];
+	uint64_t b = 0;
+};
+
+TEST(SnapshotSlotTest, ReadersKeepTheirOwnPlace)
+{
+	SnapshotSlot<int> slot;
+	uint64_t first = 0;
+	uint64_t second = 0;
+	int value = -1;
+
+	EXPECT_FALSE(slot.read(value, first));
+
+	slot.publish(1);
+	slot.publish(2);
+
+	EXPECT_TRUE(slot.read(value, first));
+	EXPECT_EQ(value, 2);
+	EXPECT_EQ(first, 2u);
+	EXPECT_FALSE(slot.read(value, first));
+
+	// Other reader still gets it
+	EXPECT_TRUE(slot.read(value, second));
+	EXPECT_EQ(value, 2);
+
+	slot.publish(3);
+	EXPECT_TRUE(slot.read(value, second));
+	EXPECT_EQ(value, 3);
+	EXPECT_TRUE(slot.read(value, first));
+	EXPECT_EQ(value, 3);
+}
+
+TEST(SnapshotSlotTest, ReadersNeverSeeTornValues)
+{
+	SnapshotSlot<SnapshotTestValue> slot;
+	const uint64_t count = 200000;
+
+	std::thread producer([&]() {
+		SnapshotTestValue value;
+		for (uint64_t i = 1; i <= count; i++)
+		{
+			value.a = i;
+			value.b = i;
+			slot.publish(value);
+		}
+	});
+
+	std::vector<std::thread> consumers;
+	std::atomic<bool> torn = false;
+	for (int i = 0; i < 3; i++)
+	{
+		consumers.emplace_back([&]() {
+			SnapshotTestValue value;
+			uint64_t sequence = 0;
+			uint64_t last = 0;
+			while (last < count)
+			{
+				if (slot.read(value, sequence))
+				{
+					if (value.a != value.b || value.a <= last || value.a != sequence)
+					{
+						torn = true;
+						return;
+					}
+					last = value.a;
+				}
+			}
+		});
+	}
+
+	producer.join();
+	for (auto& consumer : consumers)
+	{
+		consumer.join();
+	}
+
+	EXPECT_FALSE(torn);
+}
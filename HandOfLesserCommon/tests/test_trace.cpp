@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "src/packet/nativepacket.h"
+#include "src/util/trace.h"
+
+using namespace HOL;
+
+static std::string tracePath(const char* name)
+{
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static std::string readTrace(const std::string& path)
+{
+	std::ifstream file(path);
+	std::stringstream contents;
+	contents << file.rdbuf();
+	return contents.str();
+}
+
+static size_t countOccurrences(const std::string& text, const std::string& pattern)
+{
+	size_t count = 0;
+	for (size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + 1))
+	{
+		count++;
+	}
+	return count;
+}
+
+TEST(TraceTest, OnlyRecordsWhileEnabled)
+{
+	Tracer::collect(); // Whatever other tests left behind
+
+	Tracer::setEnabled(false);
+	{
+		TraceScope scope("disabled");
+	}
+
+	Tracer::setEnabled(true);
+	{
+		TraceScope scope("enabled");
+	}
+	Tracer::setEnabled(false);
+
+	std::vector<TraceEvent> events = Tracer::collect();
+	ASSERT_EQ(events.size(), 1u);
+	EXPECT_STREQ(events[0].name, "enabled");
+	EXPECT_GE(events[0].duration, 0);
+
+	// Collecting takes them out
+	EXPECT_TRUE(Tracer::collect().empty());
+}
+
+TEST(TraceTest, ThreadsGetTheirOwnBuffers)
+{
+	Tracer::collect();
+
+	std::thread other([] {
+		Tracer::setThreadName("Other");
+		Tracer::record("other", 200, 300);
+	});
+	other.join();
+
+	Tracer::record("main", 100, 150);
+
+	// Sorted by start, not by thread
+	std::vector<TraceEvent> events = Tracer::collect();
+	ASSERT_EQ(events.size(), 2u);
+	EXPECT_STREQ(events[0].name, "main");
+	EXPECT_EQ(events[0].duration, 50);
+	EXPECT_STREQ(events[1].name, "other");
+	EXPECT_NE(events[0].thread, events[1].thread);
+
+	bool named = false;
+	for (const TraceThread& thread : Tracer::getThreads())
+	{
+		if (thread.id == events[1].thread)
+		{
+			named = thread.name == "Other";
+		}
+	}
+	EXPECT_TRUE(named);
+}
+
+TEST(TraceTest, RingBufferKeepsNewest)
+{
+	Tracer::collect();
+
+	for (uint32_t i = 0; i < TRACE_BUFFER_EVENTS + 10; i++)
+	{
+		Tracer::record("ring", i * 10, i * 10 + 1);
+	}
+
+	std::vector<TraceEvent> events = Tracer::collect();
+	ASSERT_EQ(events.size(), TRACE_BUFFER_EVENTS);
+	EXPECT_EQ(events.front().start, 100);
+	EXPECT_EQ(events.back().start, (TRACE_BUFFER_EVENTS + 9) * 10);
+}
+
+TEST(TraceTest, ChromeTraceMergesProcesses)
+{
+	std::string driverPath = tracePath("hol_trace_driver.json");
+	std::string appPath = tracePath("hol_trace_app.json");
+
+	std::vector<TraceThread> threads = {{1, "Receive"}};
+	std::vector<TraceEvent> driverEvents = {{"receive", 1500, 250, 1}, {"submit", 2000, 1, 1}};
+	ASSERT_TRUE(writeChromeTrace(driverPath, TRACE_PROCESS_DRIVER, "Driver", driverEvents, threads));
+
+	threads = {{1, "Main \"loop\""}};
+	std::vector<TraceEvent> appEvents = {{"mainLoop", 1000, 1234567, 1}};
+	ASSERT_TRUE(writeChromeTrace(
+		appPath, TRACE_PROCESS_APP, "HandOfLesser", appEvents, threads, {driverPath}));
+
+	std::string trace = readTrace(appPath);
+	EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0u);
+	EXPECT_EQ(countOccurrences(trace, "\"ph\":\"X\""), 3u);
+	EXPECT_EQ(countOccurrences(trace, "\"process_name\""), 2u);
+	EXPECT_EQ(countOccurrences(trace, ",,"), 0u);
+	EXPECT_NE(trace.find("\"name\":\"mainLoop\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+						 "\"ts\":1.000,\"dur\":1234.567"),
+			  std::string::npos);
+	EXPECT_NE(trace.find("\"name\":\"receive\",\"ph\":\"X\",\"pid\":2,\"tid\":1,"
+						 "\"ts\":1.500,\"dur\":0.250"),
+			  std::string::npos);
+	EXPECT_NE(trace.find("Main \\\"loop\\\""), std::string::npos);
+
+	std::remove(driverPath.c_str());
+	std::remove(appPath.c_str());
+}
+
+TEST(TraceTest, TraceFileNamesStayInTheTraceDirectory)
+{
+	EXPECT_TRUE(isValidTraceFileName("trace_20260101_120000.driver.json"));
+
+	EXPECT_FALSE(isValidTraceFileName(""));
+	EXPECT_FALSE(isValidTraceFileName(".hidden"));
+	EXPECT_FALSE(isValidTraceFileName(".."));
+	EXPECT_FALSE(isValidTraceFileName("a..b"));
+	EXPECT_FALSE(isValidTraceFileName("../trace.json"));
+	EXPECT_FALSE(isValidTraceFileName("sub/trace.json"));
+	EXPECT_FALSE(isValidTraceFileName("sub\\trace.json"));
+	EXPECT_FALSE(isValidTraceFileName("C:trace.json"));
+	EXPECT_FALSE(isValidTraceFileName(std::string(TRACE_FILE_NAME_LENGTH, 'a')));
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include "src/transport/nativetransport.h"
+
+using namespace HOL;
+
+// Well away from the 9000-9006 range the real thing uses
+static const int TEST_SENDER_PORT = 19105;
+static const int TEST_RECEIVER_PORT = 19106;
+
+TEST(TransportTest, ReceiveBatchDrainsQueuedPackets)
+{
+	NativeTransport sender;
+	NativeTransport receiver;
+	sender.init(TEST_SENDER_PORT);
+	receiver.init(TEST_RECEIVER_PORT);
+
+	HandTransformPacket packet;
+	for (int i = 0; i < 5; i++)
+	{
+		packet.side = (HandSide)(i % 2);
+		sender.send(TEST_RECEIVER_PORT, (char*)&packet, sizeof(HandTransformPacket));
+	}
+
+	// Too small to be a packet, filtered out
+	char garbage[2] = {};
+	sender.send(TEST_RECEIVER_PORT, garbage, sizeof(garbage));
+
+	size_t total = 0;
+	while (total < 5)
+	{
+		auto batch = receiver.receiveBatch();
+		for (ReceivedPacket& received : batch)
+		{
+			EXPECT_EQ(received.packet->packetType, NativePacketType::HandTransform);
+			EXPECT_EQ(received.length, sizeof(HandTransformPacket));
+			EXPECT_EQ(((HandTransformPacket*)received.packet)->side, (HandSide)(total % 2));
+			total++;
+		}
+	}
+
+	EXPECT_EQ(total, 5u);
+
+	receiver.cancel();
+	sender.cancel();
+}
+
+TEST(TransportTest, CancelWakesBlockedReceive)
+{
+	NativeTransport receiver;
+	receiver.init(TEST_RECEIVER_PORT + 10);
+
+	auto start = std::chrono::steady_clock::now();
+	std::thread canceller([&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		receiver.cancel();
+	});
+
+	auto batch = receiver.receiveBatch();
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	canceller.join();
+
+	EXPECT_TRUE(batch.empty());
+	EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+
+	// Stays cancelled
+	EXPECT_TRUE(receiver.receiveBatch().empty());
+}
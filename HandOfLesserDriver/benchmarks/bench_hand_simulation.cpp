@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "src/hand_simulation.h"
+
+// Curls and splays as they come in from the app, then the whole skeleton out of them
+static void BM_ComputeSkeletonTransforms(benchmark::State& state)
+{
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> curl(0.f, 1.f);
+	std::uniform_real_distribution<float> splay(-1.f, 1.f);
+
+	std::vector<MyFingerCurls> curls(256);
+	std::vector<MyFingerSplays> splays(256);
+	for (size_t i = 0; i < curls.size(); i++)
+	{
+		curls[i] = {curl(random), curl(random), curl(random), curl(random), curl(random)};
+		splays[i] = {splay(random), splay(random), splay(random), splay(random), splay(random)};
+	}
+
+	MyHandSimulation simulation;
+	vr::VRBoneTransform_t transforms[eBone_Count];
+	vr::ETrackedControllerRole role = (vr::ETrackedControllerRole)state.range(0);
+
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		simulation.ComputeSkeletonTransforms(role, curls[i], splays[i], transforms);
+		benchmark::DoNotOptimize(transforms);
+		i = (i + 1) % curls.size();
+	}
+}
+BENCHMARK(BM_ComputeSkeletonTransforms)
+	->Arg(vr::TrackedControllerRole_LeftHand)
+	->Arg(vr::TrackedControllerRole_RightHand);
@@ -11,7 +11,7 @@ namespace HOL::ControllerCommon
 	static std::uniform_real_distribution<float> JitterDistribution
 		= std::uniform_real_distribution<float>(0, 0.0001);
 
-	vr::DriverPose_t generatePose(HOL::HandTransformPacket* packet, bool deviceConnected)
+	vr::DriverPose_t generatePose(const HOL::HandTransformPacket* packet, bool deviceConnected)
 	{
 		// Let's retrieve the Hmd pose to base our controller pose off.
 
@@ -6,7 +6,7 @@
 
 namespace HOL::ControllerCommon
 {
-	extern vr::DriverPose_t generatePose(HOL::HandTransformPacket* packet, bool deviceConnected);
+	extern vr::DriverPose_t generatePose(const HOL::HandTransformPacket* packet, bool deviceConnected);
 
 	extern vr::DriverPose_t addJitter(const vr::DriverPose_t& existingPose);
 
@@ -4,6 +4,7 @@
 #include "driverlog.h"
 #include "vrmath.h"
 #include "controller_common.h"
+#include "skeleton_conversion.h"
 
 
 
@@ -221,9 +222,6 @@ namespace HOL
 			&mInputHandles[InputHandleType::skeleton] // Bind the component to a handle.
 		);
 
-		// initialise our hand tracking simulation class
-		my_hand_simulation_ = std::make_unique<MyHandSimulation>();
-
 		// Let's create our haptic component.
 		// These are global across the device, and you can only have one per device.
 		input->CreateHapticComponent(
@@ -270,17 +268,13 @@ namespace HOL
 		return this->mLastPose;
 	}
 
-	void EmulatedControllerDriver::UpdatePose(HOL::HandTransformPacket* packet)
+	void EmulatedControllerDriver::UpdatePose(const HOL::HandTransformPacket* packet)
 	{
-		// packet data resides in receive buffer and will be replaced on next receive,
-		// so make a copy now.
-		this->mLastTransformPacket = *packet;
-
-		// Store the pose somewhere
-		this->mLastPose = ControllerCommon::generatePose(&this->mLastTransformPacket, true);
+		// Packet is only valid for the duration of this call, the generated pose is what we keep
+		this->mLastPose = ControllerCommon::generatePose(packet, true);
 	}
 
-	void EmulatedControllerDriver::UpdateInput(HOL::ControllerInputPacket* packet)
+	void EmulatedControllerDriver::UpdateInput(const HOL::ControllerInputPacket* packet)
 	{
 		this->mLastInputPacket = *packet;
 	}
@@ -293,11 +287,18 @@ namespace HOL
 	{
 	}
 
+	void EmulatedControllerDriver::UpdateBoolInput(uint16_t inputId, bool value)
+	{
+	}
+
+	void EmulatedControllerDriver::UpdateFloatInput(uint16_t inputId, float value)
+	{
+	}
+
 	void EmulatedControllerDriver::SubmitPose()
 	{
 		if (this->is_active_)
 		{
-			// UpdateSkeleton(); // TODO: this sends dummy data, needs actual implementation
 			// Inform the vrserver that our tracked device's pose has updated, giving it the pose
 			// returned by our GetPose().
 			vr::VRServerDriverHost()->TrackedDevicePoseUpdated(
@@ -458,48 +459,22 @@ namespace HOL
 		return my_controller_serial_number_;
 	}
 
-	void EmulatedControllerDriver::UpdateSkeleton()
+	void EmulatedControllerDriver::UpdateSkeleton(const HOL::HandSkeletonPacket* packet)
 	{
-		if (frame_ >= 4000)
+		if (!this->is_active_)
 		{
-			frame_ = 0;
+			return;
 		}
 
-		const int op = frame_ % 4000;
-		// DriverLog("Input thread frame: %d", op);
-		if (op < 1000) // curl 0 -> 1
-		{
-			last_curl_ = last_curl_ + 0.001f;
-		}
-		else if (op < 2000) // curl 1 -> 0
-		{
-			last_curl_ = last_curl_ - 0.001f;
-		}
-		else if (op < 2500) // splay 0 -> 1
-		{
-			last_splay_ = last_splay_ + 0.002f;
-		}
-		else if (op < 3500) // splay 1 -> -1
-		{
-			last_splay_ = last_splay_ - 0.002f;
-		}
-		else // splay -1 -> 0
+		// Keep whatever we sent last if the hand was only partially tracked
+		vr::VRBoneTransform_t transforms[eBone_Count];
+		if (!SkeletonConversion::convertSkeleton(packet, transforms))
 		{
-			last_splay_ = last_splay_ + 0.002f;
+			return;
 		}
 
-		vr::VRBoneTransform_t transforms[eBone_Count];
-		// Pass our calculated curl and splay values to our skeleton simulation model to compute the
-		// bone transforms for.
-		my_hand_simulation_->ComputeSkeletonTransforms(
-			my_controller_role_,
-			{last_curl_, last_curl_, last_curl_, last_curl_, last_curl_},
-			{last_splay_, last_splay_, last_splay_, last_splay_, last_splay_},
-			transforms);
-		// Update the skeleton components.
 		// Applications can choose between using a skeleton as if it's holding a controller, or an
-		// interpretation with having it without one. As ours is just a simulation, let's just set
-		// them to the same transforms.
+		// interpretation with having it without one. There's no controller, so both are the same.
 		vr::VRDriverInput()->UpdateSkeletonComponent(mInputHandles[InputHandleType::skeleton],
 													 vr::VRSkeletalMotionRange_WithController,
 													 transforms,
@@ -508,8 +483,6 @@ namespace HOL
 													 vr::VRSkeletalMotionRange_WithoutController,
 													 transforms,
 													 eBone_Count);
-
-		frame_++;
 	}
 
 }
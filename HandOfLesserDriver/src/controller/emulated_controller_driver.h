@@ -8,7 +8,7 @@
 #include <HandOfLesserCommon.h>
 #include <atomic>
 #include <thread>
-#include "src/hand_simulation.h"
+#include <HandSimulationDefs.h>
 #include "generic_control_interface.h"
 
 enum InputHandleType
@@ -62,10 +62,13 @@ namespace HOL
 
 		vr::DriverPose_t GetPose() override;
 
-		void UpdatePose(HOL::HandTransformPacket* packet) override;
-		void UpdateInput(HOL::ControllerInputPacket* packet) override;
+		void UpdatePose(const HOL::HandTransformPacket* packet) override;
+		void UpdateInput(const HOL::ControllerInputPacket* packet) override;
+		void UpdateSkeleton(const HOL::HandSkeletonPacket* packet) override;
 		void UpdateBoolInput(const std::string& input, bool value) override;
 		void UpdateFloatInput(const std::string& input, float value) override;
+		void UpdateBoolInput(uint16_t inputId, bool value) override;
+		void UpdateFloatInput(uint16_t inputId, float value) override;
 		void SubmitPose() override;
 
 		void Deactivate() override;
@@ -78,13 +81,6 @@ namespace HOL
 		void MyProcessEvent(const vr::VREvent_t& vrevent);
 
 	private:
-		void UpdateSkeleton();
-
-		std::unique_ptr<MyHandSimulation> my_hand_simulation_;
-		std::atomic<int> frame_ = 0;
-		std::atomic<float> last_curl_ = 0.f;
-		std::atomic<float> last_splay_ = 0.f;
-
 		std::atomic<vr::TrackedDeviceIndex_t> my_controller_index_;
 
 		vr::ETrackedControllerRole my_controller_role_;
@@ -98,7 +94,6 @@ namespace HOL
 
 		vr::DriverPose_t mLastPose;
 
-		HOL::HandTransformPacket mLastTransformPacket;
 		HOL::ControllerInputPacket mLastInputPacket;
 	};
 
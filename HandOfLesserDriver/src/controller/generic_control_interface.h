@@ -7,10 +7,13 @@ namespace HOL
 	 class GenericControllerInterface
 	{
 	public:
-		virtual void UpdatePose(HOL::HandTransformPacket* packet) = 0;
-		virtual void UpdateInput(HOL::ControllerInputPacket* packet) = 0;
+		virtual void UpdatePose(const HOL::HandTransformPacket* packet) = 0;
+		virtual void UpdateInput(const HOL::ControllerInputPacket* packet) = 0;
+		virtual void UpdateSkeleton(const HOL::HandSkeletonPacket* packet) = 0;
 		virtual void UpdateBoolInput(const std::string& input, bool value ) = 0;
 		virtual void UpdateFloatInput(const std::string& input, float value) = 0;
+		virtual void UpdateBoolInput(uint16_t inputId, bool value) = 0;
+		virtual void UpdateFloatInput(uint16_t inputId, float value) = 0;
 		virtual void SubmitPose() = 0;
 	};
 }
@@ -18,6 +18,7 @@ namespace HOL
 		this->mHookedHost = host;
 		this->mHookedDriver = driver;
 		this->propertyContainer = propertyContainer;
+		this->mInputHandlesById.fill(vr::k_ulInvalidInputComponentHandle);
 	}
 
 	void HookedController::lateInit(std::string serial,
@@ -29,22 +30,28 @@ namespace HOL
 		this->role = role;
 	}
 
-	void HookedController::UpdatePose(HOL::HandTransformPacket* packet)
+	void HookedController::UpdatePose(const HOL::HandTransformPacket* packet)
 	{
-		// packet data resides in receive buffer and will be replaced on next receive,
-		// so make a copy now.
-		this->mLastTransformPacket = *packet;
+		// Packet is only valid for the duration of this call,
+		// so we keep the pose we generate from it, not the packet.
+		this->mLastTransformValid = packet->valid;
 
 		// Do not update pose if invalid, because we want to continue submitting
 		// the last valid one. Is this necessary? is there some kind of timeout?
-		if (this->mLastTransformPacket.valid)
+		if (packet->valid)
 		{
-			this->mLastPose = ControllerCommon::generatePose(&this->mLastTransformPacket, true);
+			this->mLastPose = ControllerCommon::generatePose(packet, true);
 		}
 	}
-	void HookedController::UpdateInput(HOL::ControllerInputPacket* packet)
+	void HookedController::UpdateInput(const HOL::ControllerInputPacket* packet)
 	{
 	}
+
+	void HookedController::UpdateSkeleton(const HOL::HandSkeletonPacket*)
+	{
+		// Whatever we're hooking reports its own skeleton
+	}
+
 	void HookedController::UpdateBoolInput(const std::string& input, bool value)
 	{
 		auto inputHandle = this->inputHandlesByName.find(input);
@@ -65,6 +72,35 @@ namespace HOL
 		}
 	}
 
+	void HookedController::UpdateBoolInput(uint16_t inputId, bool value)
+	{
+		if (inputId < HOL::MAX_INPUT_IDS
+			&& this->mInputHandlesById[inputId] != vr::k_ulInvalidInputComponentHandle)
+		{
+			hooks::UpdateBooleanComponent::FunctionHook.originalFunc(
+				this->driverInput, this->mInputHandlesById[inputId], value, 0.0);
+		}
+	}
+
+	void HookedController::UpdateFloatInput(uint16_t inputId, float value)
+	{
+		if (inputId < HOL::MAX_INPUT_IDS
+			&& this->mInputHandlesById[inputId] != vr::k_ulInvalidInputComponentHandle)
+		{
+			hooks::UpdateScalarComponent::FunctionHook.originalFunc(
+				this->driverInput, this->mInputHandlesById[inputId], value, 0.0);
+		}
+	}
+
+	void HookedController::setInputHandle(uint16_t inputId, vr::VRInputComponentHandle_t handle)
+	{
+		// Ran out of ids, name lookup still works
+		if (inputId < HOL::MAX_INPUT_IDS)
+		{
+			this->mInputHandlesById[inputId] = handle;
+		}
+	}
+
 	void HookedController::SubmitPose()
 	{
 		if (HOL::HandOfLesser::Current->shouldPossess(this))
@@ -74,7 +110,7 @@ namespace HOL
 
 			// If we are submitting a stale pose to lock it in place, we must jitter it
 			// because vrchat is stupid and ignores all the status information steamvr provides.
-			const auto& pose = (this->mLastTransformPacket.valid)
+			const auto& pose = (this->mLastTransformValid)
 								   ? this->mLastPose
 								   : HOL::ControllerCommon::addJitter(this->mLastPose);
 
@@ -87,7 +123,7 @@ namespace HOL
 	bool HookedController::canPossess()
 	{
 		// Whether or not the pose is valid pretty much.
-		return this->mLastTransformPacket.valid;
+		return this->mLastTransformValid;
 	}
 
 	// Assuming other external conditions also say it should.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "generic_control_interface.h"
+#include <array>
 #include <openvr_driver.h>
 #include "src/input/InputCommons.h"
 
@@ -21,10 +22,13 @@ namespace HOL
 					  vr::ETrackedControllerRole role);
 
 
-		void UpdatePose(HOL::HandTransformPacket* packet) override;
-		void UpdateInput(HOL::ControllerInputPacket* packet) override;
+		void UpdatePose(const HOL::HandTransformPacket* packet) override;
+		void UpdateInput(const HOL::ControllerInputPacket* packet) override;
+		void UpdateSkeleton(const HOL::HandSkeletonPacket* packet) override;
 		void UpdateBoolInput(const std::string& input, bool value) override;
 		void UpdateFloatInput(const std::string& input, float value) override;
+		void UpdateBoolInput(uint16_t inputId, bool value) override;
+		void UpdateFloatInput(uint16_t inputId, float value) override;
 		void SubmitPose() override;
 
 		bool canPossess();
@@ -43,6 +47,7 @@ namespace HOL
 		vr::IVRDriverInput* driverInput;
 		std::unordered_map<vr::VRInputComponentHandle_t, ControllerInputHandle> inputHandles;
 		std::unordered_map<std::string, vr::VRInputComponentHandle_t> inputHandlesByName;
+		void setInputHandle(uint16_t inputId, vr::VRInputComponentHandle_t handle);
 
 		uint32_t getDeviceId();
 
@@ -53,11 +58,14 @@ namespace HOL
 	private:
 		vr::DriverPose_t mLastPose;
 
-		HOL::HandTransformPacket mLastTransformPacket;
+		bool mLastTransformValid = false;
 		HOL::ControllerInputPacket mLastInputPacket;
 
 		bool mValidWhileOriginalInvalid;
 
+		// Indexed by the driver-wide input ids, see HandOfLesser::internInput()
+		std::array<vr::VRInputComponentHandle_t, HOL::MAX_INPUT_IDS> mInputHandlesById;
+
 		HandSide mSide;
 		vr::IVRServerDriverHost* mHookedHost;
 		vr::ITrackedDeviceServerDriver* mHookedDriver;
@@ -0,0 +1,99 @@
+#include "skeleton_conversion.h"
+
+namespace HOL::SkeletonConversion
+{
+	// OpenXR joints have -Z pointing down the bone and +Y out of the back of the hand.
+	// SteamVR bones point down +X for the left hand and -X for the right,
+	// with the palm towards +Y and -Y respectively. These take one to the other.
+	static const Eigen::Quaternionf LeftBoneBasis(0.f, 0.70710678f, 0.f, -0.70710678f);
+	static const Eigen::Quaternionf RightBoneBasis(0.70710678f, 0.f, -0.70710678f, 0.f);
+
+	// The wrist's axes are turned relative to the fingers, that's the "magic" rotation
+	// the metacarpals get in hand_simulation.cpp. The right hand also flips around X.
+	static const Eigen::Quaternionf MetacarpalMagic(0.5f, 0.5f, -0.5f, 0.5f);
+	static const Eigen::Quaternionf RightMetacarpalFlip(0.f, -1.f, 0.f, 0.f);
+
+	static const Eigen::Quaternionf LeftWristBasis = LeftBoneBasis * MetacarpalMagic.conjugate();
+	static const Eigen::Quaternionf RightWristBasis
+		= RightBoneBasis * (RightMetacarpalFlip * MetacarpalMagic).conjugate();
+
+	// Joints 1-25 line up with eBone_Wrist through eBone_PinkyFinger4, so bone i is joint i.
+	// Root is the palm itself, which is where the pose we submit is.
+	static const int ParentJoint[HOL::HAND_SKELETON_JOINT_COUNT] = {
+		-1,				   // palm
+		0,				   // wrist
+		1,	2,	3,	4,	   // thumb
+		1,	6,	7,	8,	9, // index
+		1,	11, 12, 13, 14, // middle
+		1,	16, 17, 18, 19, // ring
+		1,	21, 22, 23, 24, // pinky
+	};
+
+	// Aux bones are the distal joints again, but relative to the root
+	static const int AuxJoint[5] = {4, 9, 14, 19, 24};
+
+	// Everything but the palm
+	static const uint32_t RequiredJoints = HOL::HAND_SKELETON_ALL_JOINTS & ~1u;
+
+	static void setBone(vr::VRBoneTransform_t& bone,
+						const Eigen::Vector3f& position,
+						const Eigen::Quaternionf& orientation)
+	{
+		bone.position.v[0] = position.x();
+		bone.position.v[1] = position.y();
+		bone.position.v[2] = position.z();
+		bone.position.v[3] = 1.f;
+
+		bone.orientation.w = orientation.w();
+		bone.orientation.x = orientation.x();
+		bone.orientation.y = orientation.y();
+		bone.orientation.z = orientation.z();
+	}
+
+	bool convertSkeleton(const HOL::HandSkeletonPacket* packet, vr::VRBoneTransform_t* out)
+	{
+		if ((packet->validJoints & RequiredJoints) != RequiredJoints)
+		{
+			return false;
+		}
+
+		bool rightHand = packet->side == HOL::HandSide::RightHand;
+		const Eigen::Quaternionf& boneBasis = rightHand ? RightBoneBasis : LeftBoneBasis;
+		const Eigen::Quaternionf& wristBasis = rightHand ? RightWristBasis : LeftWristBasis;
+
+		// Palm-relative poses with the SteamVR axes, on the stack
+		Eigen::Vector3f positions[HOL::HAND_SKELETON_JOINT_COUNT];
+		Eigen::Quaternionf orientations[HOL::HAND_SKELETON_JOINT_COUNT];
+
+		positions[0] = Eigen::Vector3f::Zero();
+		orientations[0] = Eigen::Quaternionf::Identity();
+
+		for (int i = 1; i < HOL::HAND_SKELETON_JOINT_COUNT; i++)
+		{
+			positions[i] = HOL::getSkeletonJointPosition(*packet, i);
+			orientations[i] = HOL::getSkeletonJointOrientation(*packet, i).normalized()
+							  * (i == eBone_Wrist ? wristBasis : boneBasis);
+		}
+
+		setBone(out[eBone_Root], Eigen::Vector3f::Zero(), Eigen::Quaternionf::Identity());
+
+		for (int i = 1; i < HOL::HAND_SKELETON_JOINT_COUNT; i++)
+		{
+			int parent = ParentJoint[i];
+			Eigen::Quaternionf inverseParent = orientations[parent].conjugate();
+
+			setBone(out[i],
+					inverseParent * (positions[i] - positions[parent]),
+					inverseParent * orientations[i]);
+		}
+
+		for (int i = 0; i < 5; i++)
+		{
+			int joint = AuxJoint[i];
+			setBone(out[eBone_Aux_Thumb + i], positions[joint], orientations[joint]);
+		}
+
+		return true;
+	}
+
+} // namespace HOL::SkeletonConversion
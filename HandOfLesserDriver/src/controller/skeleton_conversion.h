@@ -0,0 +1,15 @@
+#pragma once
+
+#include <HandOfLesserCommon.h>
+#include <HandSimulationDefs.h>
+#include "openvr_driver.h"
+
+namespace HOL::SkeletonConversion
+{
+	// Turns the palm-relative OpenXR joints into the parent-relative bones
+	// UpdateSkeletonComponent wants. Out must have room for eBone_Count transforms.
+	// Nothing is allocated, this runs for every skeleton we receive.
+	// Returns false and leaves out alone if any joint the bones need is missing.
+	extern bool convertSkeleton(const HOL::HandSkeletonPacket* packet,
+								vr::VRBoneTransform_t* out);
+}
@@ -1,4 +1,7 @@
 #include "hand_of_lesser.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include "HandOfLesserCommon.h"
 #include <driverlog.h>
 #include "src/utils/math_utils.h"
@@ -6,6 +9,9 @@
 namespace HOL
 {
 
+	static const int64_t POSE_ACK_INTERVAL_NS = 20000000;
+	static const int64_t FRAME_TIMING_INTERVAL_NS = 100000000;
+
 	HandOfLesser* HandOfLesser::Current = nullptr;
 	HOL::settings::HandOfLesserSettings HandOfLesser::Config;
 
@@ -14,85 +20,415 @@ namespace HOL
 		this->mActive = true;
 		HandOfLesser::Current = this;
 		this->mTransport.init(9006); // Hardcoded for now, needs to be negotaited somehow
+		if (!this->mTransport.initSharedMemoryReceive())
+		{
+			DriverLog("Failed to open shared memory, only listening on UDP");
+		}
+
+		// Anything that changes between driver restarts will do
+		uint32_t generation = (uint32_t)std::chrono::steady_clock::now().time_since_epoch().count();
+		this->mInputIds.clear(generation | 1);
+
 		my_pose_update_thread_ = std::thread(&HandOfLesser::ReceiveDataThread, this);
 	}
 
 	void HandOfLesser::ReceiveDataThread()
 	{
 		DriverLog("ReceiveDataThread() start, active: %s", this->mActive ? "true" : "false");
+		HOL_TRACE_THREAD("Driver receive");
+
 		while (this->mActive)
 		{
-			HOL::NativePacket* rawPacket = this->mTransport.receive();
-			if (rawPacket == nullptr)
+			// Process everything that queued up since the last wakeup before going back
+			// to sleep, otherwise a burst of packets gets spread out over several wakeups.
+			std::span<HOL::ReceivedPacket> packets = this->mTransport.receiveBatch();
+			HOL_TRACE_SCOPE("ReceiveDataThread");
+
+			// Close enough for everything in the batch, they were all waiting on us
+			this->mBatchReceiveTime = HOL::steadyNanoseconds();
+
+			for (HOL::ReceivedPacket& received : packets)
+			{
+				this->handlePacket(received);
+			}
+
+			this->submitLatestPoses();
+
+			// Only this thread sends, so the table goes out from here too
+			if (this->mInputIdTableDirty.exchange(false))
+			{
+				this->sendInputIdTable();
+			}
+
+			this->mReceiveHandlingTime->record(HOL::steadyNanoseconds() - this->mBatchReceiveTime);
+		}
+	}
+
+	void HandOfLesser::submitLatestPoses()
+	{
+		for (int i = 0; i < HOL::HandSide_MAX; i++)
+		{
+			const HOL::HandTransformPacket* pose = this->mLatestPoses[i].get();
+			if (pose == nullptr && this->mDecodedPoseReady[i])
+			{
+				pose = &this->mDecodedPoses[i];
+			}
+
+			if (pose == nullptr)
 			{
 				continue;
 			}
-			switch (rawPacket->packetType)
+
+			GenericControllerInterface* controller = this->GetActiveController((HOL::HandSide)i);
+			if (controller != nullptr)
 			{
-				case HOL::NativePacketType::HandTransform: {
-					HOL::HandTransformPacket* packet = (HOL::HandTransformPacket*)rawPacket;
-
-					GenericControllerInterface* controller
-						= this->GetActiveController(packet->side);
-					if (controller != nullptr)
-					{
-						controller->UpdatePose(packet);
-						controller->SubmitPose();
-					}
-
-					break;
-				}
+				controller->UpdatePose(pose);
+				controller->SubmitPose();
+			}
 
-				case HOL::NativePacketType::ControllerInput: {
-					HOL::ControllerInputPacket* packet = (HOL::ControllerInputPacket*)rawPacket;
+			this->mLatestPoses[i].release();
+			this->mDecodedPoseReady[i] = false;
+		}
 
-					if (packet->valid)
-					{
-						GenericControllerInterface* controller
-							= this->GetActiveController(packet->side);
-						if (controller != nullptr)
-						{
-							controller->UpdateInput(packet);
-						}
-					}
+		for (int i = 0; i < HOL::HandSide_MAX; i++)
+		{
+			if (!this->mLatestSkeletons[i])
+			{
+				continue;
+			}
 
-					break;
-				}
+			GenericControllerInterface* controller = this->GetActiveController((HOL::HandSide)i);
+			if (controller != nullptr)
+			{
+				controller->UpdateSkeleton(this->mLatestSkeletons[i].get());
+			}
 
-				case HOL::NativePacketType::Settings: {
-					HOL::SettingsPacket* packet = (HOL::SettingsPacket*)rawPacket;
+			this->mLatestSkeletons[i].release();
+		}
+	}
 
-					HandOfLesser::Config = packet->config;
+	uint16_t HandOfLesser::internInput(const char* inputName)
+	{
+		uint16_t tableSize = this->mInputIds.size();
+		uint16_t id = this->mInputIds.intern(inputName);
 
-					break;
-				}
+		if (id != HOL::INVALID_INPUT_ID && id >= tableSize)
+		{
+			// Receive thread sends it once it wakes up
+			this->mInputIdTableDirty = true;
+			this->mTransport.wake();
+		}
 
-				case HOL::NativePacketType::FloatInput: {
-					HOL::FloatInputPacket* packet = (HOL::FloatInputPacket*)rawPacket;
-					auto controller = this->GetActiveController(packet->side);
-					if (controller != nullptr)
-					{
-						controller->UpdateFloatInput(packet->inputName, packet->value);
-					}
+		return id;
+	}
 
-					break;
-				}
+	void HandOfLesser::sendInputIdTable()
+	{
+		HOL::InputIdTablePacket packet;
+		uint16_t firstId = 0;
 
-				case HOL::NativePacketType::BoolInput:  {
-					HOL::BoolInputPacket* packet = (HOL::BoolInputPacket*)rawPacket;
-					auto controller = this->GetActiveController(packet->side);
-					if (controller != nullptr)
-					{
-						controller->UpdateBoolInput(packet->inputName, packet->value);
-					}
+		// Always send at least one page so the app learns the generation
+		do
+		{
+			firstId += this->mInputIds.writePage(firstId, &packet);
+			this->mTransport.sendPacket(9005, &packet, sizeof(HOL::InputIdTablePacket));
+		} while (firstId < packet.totalCount);
+	}
 
-					break;
-				}
+	// The app only needs a recent frame to delta against, not every single one
+	void HandOfLesser::sendPoseAck(HOL::HandSide side, uint32_t sequence)
+	{
+		int64_t now = HOL::steadyNanoseconds();
+		if (now - this->mLastPoseAckTime[side] < POSE_ACK_INTERVAL_NS)
+		{
+			return;
+		}
 
-				default: {
-					// Invalid packet type!
-				}
+		this->mLastPoseAckTime[side] = now;
+
+		HOL::PoseAckPacket packet;
+		packet.side = side;
+		packet.acknowledged = sequence;
+		this->mTransport.sendPacket(9005, &packet, sizeof(HOL::PoseAckPacket));
+	}
+
+	void HandOfLesser::sendPacketStatistics(bool reset)
+	{
+		HOL::PacketStatisticsPacket packet;
+		packet.count
+			= this->mPacketStatistics.snapshot(packet.types, HOL::PACKET_STATISTICS_MAX_TYPES);
+		this->mTransport.sendPacket(9005, &packet, sizeof(HOL::PacketStatisticsPacket));
+
+		if (reset)
+		{
+			this->mPacketStatistics.reset();
+		}
+	}
+
+	// Sent from the vrserver thread, sendPacket() takes care of that
+	void HandOfLesser::sendFrameTiming()
+	{
+		HOL::FrameTimingPacket packet;
+		packet.locked = this->mFrameCadence.isLocked();
+		packet.frameCount = this->mFrameCadence.getFrameCount();
+		packet.framePeriod = this->mFrameCadence.getPeriod();
+		packet.frameReference = this->mFrameCadence.getReference();
+		this->mTransport.sendPacket(9005, &packet, sizeof(HOL::FrameTimingPacket));
+	}
+
+	void HandOfLesser::handlePacket(const HOL::ReceivedPacket& received)
+	{
+		// Anything that doesn't validate as the type it claims to be is dropped here
+		bool valid = HOL::NativePacketTable::dispatch(received, [this](auto packet) {
+			if constexpr (requires { this->onPacket(packet); })
+			{
+				this->mPacketStatistics.record(packet.get(), this->mBatchReceiveTime);
+				this->onPacket(std::move(packet));
+			}
+		});
+
+		if (valid)
+		{
+			this->mPacketsReceived->add();
+		}
+		else
+		{
+			this->mPacketsRejected->add();
+		}
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::FrameBundleHeader> packet)
+	{
+		HOL::FrameBundleReader reader(packet.getReceived());
+		HOL::ReceivedPacket entry;
+
+		while (reader.next(entry))
+		{
+			// Bundles don't nest
+			if (entry.packet->packetType != HOL::NativePacketType::FrameBundle)
+			{
+				this->handlePacket(entry);
+			}
+		}
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::HandTransformPacket> packet)
+	{
+		// Submitted once the batch is done, so a burst of poses only
+		// results in the newest one reaching SteamVR.
+		// Anything that arrives after a newer pose would just make the hand jitter back.
+		if (packet->side < HOL::HandSide_MAX
+			&& HOL::isNewerSequence(packet->sequence, this->mLastPoseSequence[packet->side]))
+		{
+			HOL::HandSide side = packet->side;
+			if (this->mLatestPoses[side] || this->mDecodedPoseReady[side])
+			{
+				this->mPosesSuperseded->add();
 			}
+
+			this->mLastPoseSequence[side] = packet->sequence;
+			this->mLatestPoses[side] = std::move(packet);
+			this->mDecodedPoseReady[side] = false;
+		}
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::CompactHandTransformPacket> packet)
+	{
+		HOL::HandSide side = (packet->flags & HOL::CompactPoseRightHand) ? HOL::RightHand
+																		 : HOL::LeftHand;
+
+		if (!HOL::isNewerSequence(packet->sequence, this->mLastPoseSequence[side]))
+		{
+			return;
+		}
+
+		if (!this->mPoseDecoder.decode(*packet, this->mDecodedPoses[side]))
+		{
+			// Delta against something we never got, or from before we restarted
+			this->sendPoseAck(side, 0);
+			return;
+		}
+
+		if (this->mLatestPoses[side] || this->mDecodedPoseReady[side])
+		{
+			this->mPosesSuperseded->add();
+		}
+
+		this->mLastPoseSequence[side] = packet->sequence;
+		this->mLatestPoses[side].release();
+		this->mDecodedPoseReady[side] = true;
+
+		this->sendPoseAck(side, packet->sequence);
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::PoseEncodingPacket> packet)
+	{
+		// New connection as far as poses are concerned
+		this->mPoseDecoder.reset();
+		for (int i = 0; i < HOL::HandSide_MAX; i++)
+		{
+			this->mLastPoseSequence[i] = 0;
+			this->mLastSkeletonSequence[i] = 0;
+			this->mLastPoseAckTime[i] = 0;
+		}
+
+		// We understand all of them
+		HOL::PoseEncodingPacket reply;
+		reply.encoding = packet->encoding;
+		this->mTransport.sendPacket(9005, &reply, sizeof(HOL::PoseEncodingPacket));
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::HandSkeletonPacket> packet)
+	{
+		// Only the newest one per hand is worth converting, same as poses
+		if (packet->side < HOL::HandSide_MAX
+			&& HOL::isNewerSequence(packet->sequence, this->mLastSkeletonSequence[packet->side]))
+		{
+			HOL::HandSide side = (HOL::HandSide)packet->side;
+			this->mLastSkeletonSequence[side] = packet->sequence;
+			this->mLatestSkeletons[side] = std::move(packet);
+		}
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::ControllerInputPacket> packet)
+	{
+		if (packet->valid)
+		{
+			GenericControllerInterface* controller = this->GetActiveController(packet->side);
+			if (controller != nullptr)
+			{
+				controller->UpdateInput(packet.get());
+			}
+		}
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::SettingsPacket> packet)
+	{
+		HandOfLesser::Config = packet->config;
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::FloatInputPacket> packet)
+	{
+		auto controller = this->GetActiveController(packet->side);
+		if (controller != nullptr)
+		{
+			controller->UpdateFloatInput(
+				std::string(packet->inputName, strnlen(packet->inputName, sizeof(packet->inputName))),
+				packet->value);
+		}
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::BoolInputPacket> packet)
+	{
+		auto controller = this->GetActiveController(packet->side);
+		if (controller != nullptr)
+		{
+			controller->UpdateBoolInput(
+				std::string(packet->inputName, strnlen(packet->inputName, sizeof(packet->inputName))),
+				packet->value);
+		}
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::FloatInputIdPacket> packet)
+	{
+		auto controller = this->GetActiveController((HOL::HandSide)packet->side);
+		if (controller != nullptr)
+		{
+			controller->UpdateFloatInput(packet->inputId, packet->value);
+		}
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::BoolInputIdPacket> packet)
+	{
+		auto controller = this->GetActiveController((HOL::HandSide)packet->side);
+		if (controller != nullptr)
+		{
+			controller->UpdateBoolInput(packet->inputId, packet->value);
+		}
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::InputIdTableRequestPacket>)
+	{
+		this->sendInputIdTable();
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::PacketStatisticsRequestPacket> packet)
+	{
+		this->sendPacketStatistics(packet->reset);
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::TraceControlPacket> packet)
+	{
+		if (packet->enabled)
+		{
+			HOL::Tracer::collect(); // Whatever is left from last time
+			HOL::Tracer::setEnabled(true);
+			return;
+		}
+
+		HOL::Tracer::setEnabled(false);
+		std::vector<HOL::TraceEvent> events = HOL::Tracer::collect();
+
+		std::string fileName(packet->fileName,
+							 strnlen(packet->fileName, HOL::TRACE_FILE_NAME_LENGTH));
+		if (fileName.empty())
+		{
+			return;
+		}
+
+		// Anyone on loopback can send us this, so it only ever picks a name in our own directory
+		if (!HOL::isValidTraceFileName(fileName))
+		{
+			DriverLog("Ignoring trace request with bad file name");
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::path directory = HOL::getTraceDirectory();
+		std::filesystem::create_directories(directory, error);
+
+		std::string path = (directory / fileName).string();
+		std::string partial = path + ".partial";
+
+		// Never replace whatever is already there, or follow a link someone left in its place
+		if (std::filesystem::exists(std::filesystem::symlink_status(path, error))
+			|| std::filesystem::exists(std::filesystem::symlink_status(partial, error)))
+		{
+			DriverLog("Trace %s already exists, not overwriting it", path.c_str());
+			return;
+		}
+
+		// Under another name until it's done, the app is waiting for it to show up.
+		// Holds up the receive thread for a moment, but we're only here when asked.
+		if (!HOL::writeChromeTrace(partial,
+								   HOL::TRACE_PROCESS_DRIVER,
+								   "HandOfLesserDriver",
+								   events,
+								   HOL::Tracer::getThreads()))
+		{
+			DriverLog("Failed to write trace to %s", partial.c_str());
+			return;
+		}
+
+		// Unlike rename, linking fails if something showed up at path in the meantime
+		std::filesystem::create_hard_link(partial, path, error);
+		if (error)
+		{
+			DriverLog("Failed to move trace to %s: %s", path.c_str(), error.message().c_str());
+		}
+
+		std::filesystem::remove(partial, error);
+	}
+
+	void HandOfLesser::onPacket(HOL::PacketView<HOL::MetricsRequestPacket> packet)
+	{
+		HOL::MetricsPacket reply;
+		HOL::getMetrics().snapshot(reply.snapshot);
+		this->mTransport.sendPacket(9005, &reply, sizeof(HOL::MetricsPacket));
+
+		if (packet->reset)
+		{
+			HOL::getMetrics().reset();
 		}
 	}
 
@@ -492,6 +828,17 @@ namespace HOL
 
 	void HandOfLesser::runFrame()
 	{
+		HOL_TRACE_SCOPE("HandOfLesser::runFrame");
+
+		// Called once per SteamVR frame, regardless of what we're doing with controllers
+		int64_t now = HOL::steadyNanoseconds();
+		this->mFrameCadence.addFrame(now);
+		if (now - this->mLastFrameTimingSent >= FRAME_TIMING_INTERVAL_NS)
+		{
+			this->mLastFrameTimingSent = now;
+			this->sendFrameTiming();
+		}
+
 		// As of writing only emulated controllers need to do anything here
 		if (HandOfLesser::Current->Config.handPose.mControllerMode
 			== ControllerMode::EmulateControllerMode)
@@ -547,6 +894,7 @@ namespace HOL
 		// of the while loop, if it's running, then call .join() on the thread
 		// if (is_active_.exchange(false))
 		this->mActive = false;
+		this->mTransport.cancel(); // Otherwise it sleeps until the next packet
 		{
 			my_pose_update_thread_.join();
 		}
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <thread>
 #include <HandOfLesserCommon.h>
 #include "src/controller/emulated_controller_driver.h"
@@ -41,11 +42,34 @@ namespace HOL
 
 		void requestEstimateControllerSide();
 
+		uint16_t internInput(const char* inputName);
+
 	private:
 		void ReceiveDataThread();
+		void handlePacket(const HOL::ReceivedPacket& received);
+		void onPacket(HOL::PacketView<HOL::FrameBundleHeader> packet);
+		void onPacket(HOL::PacketView<HOL::HandTransformPacket> packet);
+		void onPacket(HOL::PacketView<HOL::CompactHandTransformPacket> packet);
+		void onPacket(HOL::PacketView<HOL::PoseEncodingPacket> packet);
+		void onPacket(HOL::PacketView<HOL::HandSkeletonPacket> packet);
+		void onPacket(HOL::PacketView<HOL::ControllerInputPacket> packet);
+		void onPacket(HOL::PacketView<HOL::SettingsPacket> packet);
+		void onPacket(HOL::PacketView<HOL::FloatInputPacket> packet);
+		void onPacket(HOL::PacketView<HOL::BoolInputPacket> packet);
+		void onPacket(HOL::PacketView<HOL::FloatInputIdPacket> packet);
+		void onPacket(HOL::PacketView<HOL::BoolInputIdPacket> packet);
+		void onPacket(HOL::PacketView<HOL::InputIdTableRequestPacket> packet);
+		void onPacket(HOL::PacketView<HOL::PacketStatisticsRequestPacket> packet);
+		void onPacket(HOL::PacketView<HOL::TraceControlPacket> packet);
+		void onPacket(HOL::PacketView<HOL::MetricsRequestPacket> packet);
+		void sendInputIdTable();
+		void sendPacketStatistics(bool reset);
+		void sendFrameTiming();
+		void sendPoseAck(HOL::HandSide side, uint32_t sequence);
+		void submitLatestPoses();
 		void estimateControllerSide();
 
-		bool mActive;
+		std::atomic<bool> mActive = false;
 		int mControllerSideEstimationAttemptCount = 0;
 
 
@@ -54,6 +78,46 @@ namespace HOL
 		std::thread my_pose_update_thread_;
 		HOL::NativeTransport mTransport;
 
+		// Newest pose per hand, submitted and released once per receive batch.
+		// Same latest-value semantics the LatestValueMailbox used to give us, but the mailbox
+		// was written and drained on this one thread, so all it added was a copy. Holding the
+		// view keeps the packet in its receive slot instead.
+		HOL::PacketView<HOL::HandTransformPacket> mLatestPoses[HOL::HandSide_MAX];
+
+		// Poses replaced by a newer one for the same hand before they were submitted,
+		// what the mailbox counted as overwritten.
+		HOL::MetricCounter* mPosesSuperseded = HOL::getMetrics().getCounter("poses_superseded");
+
+		// Same for skeletons, which have their own sequence
+		HOL::PacketView<HOL::HandSkeletonPacket> mLatestSkeletons[HOL::HandSide_MAX];
+		uint32_t mLastSkeletonSequence[HOL::HandSide_MAX] = {0, 0};
+
+		// Compact poses have to be decoded somewhere, used instead if there's no view
+		HOL::PoseDecoder mPoseDecoder;
+		HOL::HandTransformPacket mDecodedPoses[HOL::HandSide_MAX];
+		bool mDecodedPoseReady[HOL::HandSide_MAX] = {false, false};
+		int64_t mLastPoseAckTime[HOL::HandSide_MAX] = {0, 0};
+
+		// Receive thread only. Poses older than the last one we took for that hand are dropped.
+		HOL::PacketStatistics mPacketStatistics;
+		int64_t mBatchReceiveTime = 0;
+		HOL::LatencyHistogram* mReceiveHandlingTime
+			= HOL::getMetrics().getHistogram("receive_handling");
+		HOL::MetricCounter* mPacketsReceived = HOL::getMetrics().getCounter("packets_received");
+		HOL::MetricCounter* mPacketsRejected = HOL::getMetrics().getCounter("packets_rejected");
+		// Full and compact poses share a sequence, see getSequenceType()
+		uint32_t mLastPoseSequence[HOL::HandSide_MAX] = {0, 0};
+
+		// SteamVR's frame cadence, learned from RunFrame() and passed on to the app
+		// so it can sample and predict for when the pose is actually used. vrserver thread only.
+		HOL::FrameCadenceEstimator mFrameCadence;
+		int64_t mLastFrameTimingSent = 0;
+
+		// Input paths interned as components are created, the app sends us these ids.
+		// Pushed to the app from the receive thread whenever it grows.
+		HOL::InputIdTable mInputIds;
+		std::atomic<bool> mInputIdTableDirty = false;
+
 		std::unique_ptr<EmulatedControllerDriver> mEmulatedControllers[2];
 		std::vector<std::unique_ptr<HookedController>> mHookedControllers;
 	};
@@ -11,6 +11,7 @@ namespace HOL::hooks
 		static vr::EVRInitError Detour(vr::ITrackedDeviceServerDriver* _this,
 									   uint32_t unWhichDevice)
 		{
+			HOL_TRACE_SCOPE("TrackedDeviceActivate::Detour");
 			DriverLog("TrackedDeviceActivate!");
 			DriverLog("Device ID: %lld", (long long)unWhichDevice);
 
@@ -90,6 +91,7 @@ namespace HOL::hooks
 		static bool
 		Detour(vr::IVRServerDriverHost* _this, vr::VREvent_t* pEvent, uint32_t uncbVREvent)
 		{
+			HOL_TRACE_SCOPE("PollNextEvent::Detour");
 			//DriverLog("PollNextEvent!");
 			auto ret = PollNextEvent::FunctionHook.originalFunc(_this, pEvent, uncbVREvent);
 
@@ -117,6 +119,7 @@ namespace HOL::hooks
 						   vr::ETrackedDeviceClass eDeviceClass,
 						   vr::ITrackedDeviceServerDriver* pDriver)
 		{
+			HOL_TRACE_SCOPE("TrackedDeviceAdded006::Detour");
 			DriverLog("TrackedDeviceAdded006!");
 
 			if (!IHook::Exists(TrackedDeviceActivate::FunctionHook.name))
@@ -158,6 +161,7 @@ namespace HOL::hooks
 						   const vr::DriverPose_t& newPose,
 						   uint32_t unPoseStructSize)
 		{
+			HOL_TRACE_SCOPE("TrackedDevicePoseUpdated::Detour");
 			auto& config = HOL::HandOfLesser::Current->Config;
 
 			HookedController* controller
@@ -218,6 +222,7 @@ namespace HOL::hooks
 										const char* pchName,
 										vr::VRInputComponentHandle_t* pHandle)
 		{
+			HOL_TRACE_SCOPE("CreateBooleanComponent::Detour");
 			// pHandle is populated by this function, so let it run first.
 			auto ret = CreateBooleanComponent::FunctionHook.originalFunc(
 				_this, ulContainer, pchName, pHandle);
@@ -242,6 +247,7 @@ namespace HOL::hooks
 				uint64_t key = *pHandle; // Something is fucked
 				controller->inputHandles[key] = input;
 				controller->inputHandlesByName[pchName] = *pHandle;
+				controller->setInputHandle(HandOfLesser::Current->internInput(pchName), *pHandle);
 			}
 
 			return ret;
@@ -260,6 +266,7 @@ namespace HOL::hooks
 										vr::EVRScalarType eType,
 										vr::EVRScalarUnits eUnits)
 		{
+			HOL_TRACE_SCOPE("CreateScalarComponent::Detour");
 			// pHandle is populated by this function, so let it run first.
 			auto ret = CreateScalarComponent::FunctionHook.originalFunc(
 				_this, ulContainer, pchName, pHandle, eType, eUnits);
@@ -284,6 +291,7 @@ namespace HOL::hooks
 				uint64_t key = *pHandle; // Something is fucked
 				controller->inputHandles[key] = input;
 				controller->inputHandlesByName[pchName] = *pHandle;
+				controller->setInputHandle(HandOfLesser::Current->internInput(pchName), *pHandle);
 			}
 
 			return ret;
@@ -300,6 +308,7 @@ namespace HOL::hooks
 										bool bNewValue,
 										double fTimeOffset)
 		{
+			HOL_TRACE_SCOPE("UpdateBooleanComponent::Detour");
 			auto& config = HOL::HandOfLesser::Current->Config;
 			HookedController* controller
 				= HandOfLesser::Current->getHookedControllerByInputHandle(ulComponent);
@@ -356,6 +365,7 @@ namespace HOL::hooks
 										float fNewValue,
 										double fTimeOffset)
 		{
+			HOL_TRACE_SCOPE("UpdateScalarComponent::Detour");
 			auto& config = HOL::HandOfLesser::Current->Config;
 			HookedController* controller
 				= HandOfLesser::Current->getHookedControllerByInputHandle(ulComponent);
@@ -407,6 +417,7 @@ namespace HOL::hooks
 							const char* pchInterfaceVersion,
 							vr::EVRInitError* peError)
 		{
+			HOL_TRACE_SCOPE("GetGenericInterface::Detour");
 			void* originalInterface = GetGenericInterface::FunctionHook.originalFunc(
 				_this, pchInterfaceVersion, peError);
 